@@ -0,0 +1,112 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma once
+
+#include "../link/atomic"
+#include "../link/thread"
+#include "../link/pool"
+#include "../link/time"
+#include "../link/file"
+#include "../link/format"
+
+/* 基准测试的公共工具 */
+
+namespace bench
+{
+    /// 同时运行的最大线程数
+    constexpr xyu::size_t K_max_threads = 256;
+
+    /// 阻止编译器优化掉 v 的计算
+    template <typename T>
+    inline void keep(const T& v) noexcept { __asm__ __volatile__("" : : "r"(&v) : "memory"); }
+
+    /// 硬件线程数 (至少为 1，不超过 K_max_threads)
+    inline xyu::size_t hardware_threads() noexcept
+    {
+        xyu::size_t n = xyu::ThreadPool::hardware_count();
+        return n == 0 ? 1 : n < K_max_threads ? n : K_max_threads;
+    }
+
+    /// 线程数序列 1, 2, 4, ... , max 中 n 的下一个值 (结束时返回 0)
+    inline xyu::size_t next_threads(xyu::size_t n, xyu::size_t max) noexcept
+    {
+        if (n >= max) return 0;
+        return n * 2 < max ? n * 2 : max;
+    }
+
+    /**
+     * @brief 运行 reps 次 fun()，返回最短的一次耗时 (纳秒)
+     * @note 取最短值以排除调度与缓存预热的干扰
+     */
+    template <typename Fun>
+    xyu::int64 best_ns(int reps, Fun&& fun)
+    {
+        xyu::int64 best = -1;
+        for (int i = 0; i < reps; ++i)
+        {
+            xyu::Clock c;
+            fun();
+            xyu::int64 t = c.stop().count;
+            if (best < 0 || t < best) best = t;
+        }
+        return best;
+    }
+
+    /**
+     * @brief 在 n 个线程上同时运行 fun(i) (i 为 [0, n) 的线程序号)
+     * @return 从所有线程同时开始到全部结束的耗时 (纳秒)
+     * @note 线程全部就绪后才开始计时，不计入线程的创建时间
+     */
+    template <typename Fun>
+    xyu::int64 run_threads(xyu::size_t n, Fun&& fun)
+    {
+        if (n > K_max_threads) n = K_max_threads;
+        xyu::Atomic<xyu::size_t> ready{0};
+        xyu::Atomic<xyu::uint32> go{0};
+        auto body = [&](xyu::size_t i) {
+            ready.fetch_add(1, xyu::N_ATOMIC_RELEASE);
+            while (go.load(xyu::N_ATOMIC_ACQUIRE) == 0) go.wait(0, xyu::N_ATOMIC_ACQUIRE);
+            fun(i);
+        };
+        xyu::Thread ts[K_max_threads];
+        for (xyu::size_t i = 0; i < n; ++i) ts[i] = xyu::Thread{body, i};
+        while (ready.load(xyu::N_ATOMIC_ACQUIRE) != n) xyu::cpu_pause();
+        xyu::Clock c;
+        go.store(1, xyu::N_ATOMIC_RELEASE);
+        go.notify_all();
+        for (xyu::size_t i = 0; i < n; ++i) ts[i].wait();
+        return c.stop().count;
+    }
+
+    /// 输出基准测试组的标题
+    inline void title(const char* name) { xyfmtt(xyu::fout, "\n[{}]\n", name); }
+
+    /**
+     * @brief 输出一行结果
+     * @param name 测试项名称
+     * @param ns 总耗时 (纳秒)
+     * @param ops 操作次数
+     */
+    template <typename Name>
+    void report(const Name& name, xyu::int64 ns, xyu::size_t ops)
+    {
+        double per = ops ? static_cast<double>(ns) / static_cast<double>(ops) : 0.;
+        double mops = ns > 0 ? static_cast<double>(ops) * 1e3 / static_cast<double>(ns) : 0.;
+        xyfmtt(xyu::fout, "  {|<40} {|>10:.2f} ns/op {|>10:.2f} Mop/s\n", name, per, mops);
+    }
+
+    /* 各组基准测试 (由 main 按名称调用) */
+
+    /// Deque 与 List、Vector 的先进先出与后进先出
+    void deque();
+    /// MpmcQueue 与 Mutex + CondVar 队列在不同生产者、消费者数量下的吞吐量与往返延迟
+    void mpmc();
+    /// Mutex_RW 与 Mutex_RW_Biased 在不同读者线程数下的读取开销
+    void rwlock();
+    /// SeqLock 与 Mutex_RW 读锁读取小型快照的开销 (无写者与有持续写者)
+    void seqlock();
+    /// 并行算法与对应的串行循环在 1 到 N 个线程下的耗时
+    void parallel();
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,71 @@
+#include "./bench.h"
+#include "../link/deque"
+#include "../link/list"
+#include "../link/vector"
+
+/* Deque 与 List、Vector 的队列 (先进先出) 与栈 (后进先出) 模式 */
+
+namespace
+{
+    // 操作次数
+    constexpr xyu::size_t K_ops = 1 << 20;
+    // 队列模式下保持的元素数量 (模拟积压的工作队列)
+    constexpr xyu::size_t K_depth = 1024;
+    // 栈模式下每轮连续压入与弹出的元素数量
+    constexpr xyu::size_t K_burst = 256;
+    // 重复次数
+    constexpr int K_reps = 5;
+
+    // 队列：预先放入 K_depth 个元素，然后每次尾部压入一个并从头部弹出一个
+    template <typename C, typename Pop>
+    xyu::int64 fifo(Pop&& pop)
+    {
+        return bench::best_ns(K_reps, [&] {
+            C c;
+            for (xyu::size_t i = 0; i < K_depth; ++i) c.append(i);
+            xyu::size_t sum = 0;
+            for (xyu::size_t i = 0; i < K_ops; ++i) {
+                c.append(i);
+                sum += pop(c);
+            }
+            bench::keep(sum);
+        });
+    }
+
+    // 栈：每轮尾部压入 K_burst 个元素，再从尾部全部弹出
+    template <typename C, typename Pop>
+    xyu::int64 lifo(Pop&& pop)
+    {
+        return bench::best_ns(K_reps, [&] {
+            C c;
+            xyu::size_t sum = 0;
+            for (xyu::size_t r = 0; r < K_ops / K_burst; ++r) {
+                for (xyu::size_t i = 0; i < K_burst; ++i) c.append(i);
+                for (xyu::size_t i = 0; i < K_burst; ++i) sum += pop(c);
+            }
+            bench::keep(sum);
+        });
+    }
+}
+
+namespace bench
+{
+    void deque()
+    {
+        title("deque: FIFO (push back, pop front)");
+        report("Deque<size_t>", fifo<xyu::Deque<xyu::size_t>>([](auto& c) {
+            xyu::size_t v = c[0]; c.erase_front(); return v; }), K_ops);
+        report("List<size_t>", fifo<xyu::List<xyu::size_t>>([](auto& c) {
+            xyu::size_t v = c[0]; c.erase(0); return v; }), K_ops);
+        report("Vector<size_t>", fifo<xyu::Vector<xyu::size_t>>([](auto& c) {
+            xyu::size_t v = c[0]; c.erase(0); return v; }), K_ops);
+
+        title("deque: LIFO (push back, pop back)");
+        report("Deque<size_t>", lifo<xyu::Deque<xyu::size_t>>([](auto& c) {
+            xyu::size_t v = c[-1]; c.erase_back(); return v; }), K_ops);
+        report("List<size_t>", lifo<xyu::List<xyu::size_t>>([](auto& c) {
+            xyu::size_t v = c[-1]; c.erase(c.count() - 1); return v; }), K_ops);
+        report("Vector<size_t>", lifo<xyu::Vector<xyu::size_t>>([](auto& c) {
+            xyu::size_t v = c[-1]; c.erase(c.count() - 1); return v; }), K_ops);
+    }
+}
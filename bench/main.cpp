@@ -0,0 +1,32 @@
+#include "./bench.h"
+#include <cstring>
+
+namespace
+{
+    // 基准测试组
+    struct Entry
+    {
+        const char* name;   // 名称 (命令行参数)
+        void (*run)();      // 入口
+    };
+
+    constexpr Entry K_entries[] = {
+        {"deque", bench::deque},
+        {"mpmc", bench::mpmc},
+        {"rwlock", bench::rwlock},
+        {"seqlock", bench::seqlock},
+        {"parallel", bench::parallel},
+    };
+}
+
+// 用法: xylu_bench [名称...] (不带参数时依次运行全部)
+int main(int argc, char** argv)
+{
+    for (const Entry& e : K_entries)
+    {
+        bool pick = argc <= 1;
+        for (int i = 1; i < argc && !pick; ++i) pick = std::strcmp(argv[i], e.name) == 0;
+        if (pick) e.run();
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "./bench.h"
+#include "../link/queue"
+#include "../link/mutex"
+#include "../link/condvar"
+
+/* MpmcQueue 与 Mutex + CondVar 队列的吞吐量与延迟 */
+
+namespace
+{
+    // 队列容量
+    constexpr xyu::size_t K_capa = 1024;
+    // 吞吐量测试中传递的元素总数
+    constexpr xyu::size_t K_items = 1 << 21;
+    // 延迟测试中往返的次数
+    constexpr xyu::size_t K_rounds = 1 << 17;
+    // 批量出队的最大数量
+    constexpr xyu::size_t K_batch = 64;
+
+    // 对照组：由 Mutex 与 CondVar 保护的有界环形队列
+    template <typename T, xyu::size_t N>
+    class LockedQueue
+    {
+        xyu::Mutex m;
+        xyu::CondVar not_empty, not_full;
+        T buf[N];
+        xyu::size_t head = 0, cnt = 0;
+
+    public:
+        void push(T v)
+        {
+            {
+                xyu::Mutex::Guard g{m};
+                not_full.wait(g, [&] { return cnt < N; });
+                buf[(head + cnt) % N] = v;
+                ++cnt;
+            }
+            not_empty.notify_one();
+        }
+        T pop()
+        {
+            T v;
+            {
+                xyu::Mutex::Guard g{m};
+                not_empty.wait(g, [&] { return cnt > 0; });
+                v = buf[head];
+                head = (head + 1) % N;
+                --cnt;
+            }
+            not_full.notify_one();
+            return v;
+        }
+    };
+
+    // np 个生产者实际传递的元素总数 (每个生产者压入相同数量，不超过 K_items)
+    xyu::size_t items(xyu::size_t np) noexcept { return K_items / np * np; }
+
+    // np 个生产者阻塞地压入共 items(np) 个元素，nc 个消费者通过 pop(q) 取出全部元素
+    template <typename Q, typename Pop>
+    xyu::int64 throughput(Q& q, xyu::size_t np, xyu::size_t nc, Pop&& pop)
+    {
+        xyu::size_t per = K_items / np, total = items(np);
+        return bench::run_threads(np + nc, [&](xyu::size_t i) {
+            if (i < np) {
+                for (xyu::size_t k = 0; k < per; ++k) q.push(k);
+                return;
+            }
+            i -= np;
+            xyu::size_t want = total / nc + (i < total % nc), sum = 0;
+            for (xyu::size_t got = 0; got < want; ) got += pop(q, want - got, sum);
+            bench::keep(sum);
+        });
+    }
+
+    // 两个线程通过两个队列往返传递元素
+    template <typename Q>
+    xyu::int64 pingpong(Q& a, Q& b)
+    {
+        return bench::run_threads(2, [&](xyu::size_t i) {
+            xyu::size_t sum = 0;
+            for (xyu::size_t k = 0; k < K_rounds; ++k) {
+                if (i == 0) { a.push(k); sum += b.pop(); }
+                else b.push(a.pop());
+            }
+            bench::keep(sum);
+        });
+    }
+
+    // 逐个阻塞出队
+    auto pop_one = [](auto& q, xyu::size_t, xyu::size_t& sum) -> xyu::size_t { sum += q.pop(); return 1; };
+    // 批量出队，队列为空时改为阻塞地出队一个
+    auto pop_batch = [](auto& q, xyu::size_t left, xyu::size_t& sum) -> xyu::size_t {
+        xyu::size_t k = q.try_pop_n([&](xyu::size_t&& v) { sum += v; }, left < K_batch ? left : K_batch);
+        if (k) return k;
+        sum += q.pop();
+        return 1;
+    };
+}
+
+namespace bench
+{
+    void mpmc()
+    {
+        xyu::size_t half = hardware_threads() / 2;
+        if (half == 0) half = 1;
+
+        title("mpmc: throughput (blocking push/pop, P producers / C consumers)");
+        for (xyu::size_t np = 1; np; np = next_threads(np, half))
+            for (xyu::size_t nc = 1; nc; nc = next_threads(nc, half))
+            {
+                // 只测试对称以及单侧为 1 的组合
+                if (np != nc && np != 1 && nc != 1) continue;
+                {
+                    xyu::MpmcQueue<xyu::size_t> q{K_capa};
+                    report(xyfmt("MpmcQueue {}P/{}C", np, nc), throughput(q, np, nc, pop_one), items(np));
+                }
+                {
+                    xyu::MpmcQueue<xyu::size_t> q{K_capa};
+                    report(xyfmt("MpmcQueue try_pop_n {}P/{}C", np, nc), throughput(q, np, nc, pop_batch), items(np));
+                }
+                {
+                    LockedQueue<xyu::size_t, K_capa> q;
+                    report(xyfmt("Mutex+CondVar {}P/{}C", np, nc), throughput(q, np, nc, pop_one), items(np));
+                }
+            }
+
+        title("mpmc: latency (ping-pong round trip between two threads)");
+        {
+            xyu::MpmcQueue<xyu::size_t> a{K_capa}, b{K_capa};
+            report("MpmcQueue", pingpong(a, b), K_rounds);
+        }
+        {
+            LockedQueue<xyu::size_t, K_capa> a, b;
+            report("Mutex+CondVar", pingpong(a, b), K_rounds);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#include "./bench.h"
+#include "../link/parallel"
+#include "../link/vector"
+
+/* 并行算法与串行循环在 1 到 N 个线程下的对比 */
+
+namespace
+{
+    // 元素数量 (32 MiB，超出常见的末级缓存)
+    constexpr xyu::size_t K_n = 1 << 22;
+    // 排序的元素数量
+    constexpr xyu::size_t K_sort_n = 1 << 21;
+    // 重复次数
+    constexpr int K_reps = 5;
+
+    using Vec = xyu::Vector<xyu::uint64>;
+
+    // 生成伪随机数据 (xorshift)
+    Vec make_data(xyu::size_t n)
+    {
+        Vec v(n);
+        xyu::uint64 x = 0x9E3779B97F4A7C15ull;
+        for (xyu::size_t i = 0; i < n; ++i) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            v.append(x);
+        }
+        return v;
+    }
+
+    xyu::Parallel_Option with_threads(xyu::size_t n)
+    {
+        xyu::Parallel_Option op;
+        op.threads = n;
+        return op;
+    }
+
+    // 每轮排序前先从 src 复制数据 (复制不计入耗时)
+    template <typename Sort>
+    xyu::int64 sort_ns(const Vec& src, Vec& work, Sort&& sort)
+    {
+        xyu::int64 best = -1;
+        for (int r = 0; r < K_reps; ++r)
+        {
+            for (xyu::size_t i = 0; i < src.count(); ++i) work[i] = src[i];
+            xyu::Clock c;
+            sort(work);
+            xyu::int64 t = c.stop().count;
+            if (best < 0 || t < best) best = t;
+        }
+        return best;
+    }
+}
+
+namespace bench
+{
+    void parallel()
+    {
+        xyu::size_t hw = hardware_threads();
+        Vec a = make_data(K_n), b = make_data(K_n);
+        xyu::uint64* pa = &a[0];
+        xyu::uint64* pb = &b[0];
+        auto f = [](xyu::uint64 x) { return x * 3 + 1; };
+        auto odd = [](xyu::uint64 x) { return (x & 1) != 0; };
+
+        title("parallel: for_each (x = x * 3 + 1)");
+        report("serial loop", best_ns(K_reps, [&] { for (xyu::size_t i = 0; i < K_n; ++i) pa[i] = f(pa[i]); }), K_n);
+        for (xyu::size_t n = 1; n; n = next_threads(n, hw))
+            report(xyfmt("par_for_each {} threads", n), best_ns(K_reps, [&] {
+                xyu::par_for_each(a, [&](xyu::uint64& x) { x = f(x); }, with_threads(n)); }), K_n);
+
+        title("parallel: transform (b = a * 3 + 1)");
+        report("serial loop", best_ns(K_reps, [&] { for (xyu::size_t i = 0; i < K_n; ++i) pb[i] = f(pa[i]); }), K_n);
+        for (xyu::size_t n = 1; n; n = next_threads(n, hw))
+            report(xyfmt("par_transform {} threads", n), best_ns(K_reps, [&] {
+                xyu::par_transform(a, b, f, with_threads(n)); }), K_n);
+
+        title("parallel: reduce (sum)");
+        report("serial loop", best_ns(K_reps, [&] {
+            xyu::uint64 s = 0;
+            for (xyu::size_t i = 0; i < K_n; ++i) s += pa[i];
+            keep(s);
+        }), K_n);
+        for (xyu::size_t n = 1; n; n = next_threads(n, hw))
+            report(xyfmt("par_reduce {} threads", n), best_ns(K_reps, [&] {
+                keep(xyu::par_reduce(a, xyu::uint64{0}, with_threads(n))); }), K_n);
+
+        title("parallel: inclusive_scan (prefix sum)");
+        report("serial loop", best_ns(K_reps, [&] {
+            xyu::uint64 s = 0;
+            for (xyu::size_t i = 0; i < K_n; ++i) pb[i] = s += pa[i];
+        }), K_n);
+        for (xyu::size_t n = 1; n; n = next_threads(n, hw))
+            report(xyfmt("par_inclusive_scan {} threads", n), best_ns(K_reps, [&] {
+                xyu::par_inclusive_scan(a, b, with_threads(n)); }), K_n);
+
+        title("parallel: count_if (odd)");
+        report("serial loop", best_ns(K_reps, [&] {
+            xyu::size_t c = 0;
+            for (xyu::size_t i = 0; i < K_n; ++i) c += odd(pa[i]);
+            keep(c);
+        }), K_n);
+        for (xyu::size_t n = 1; n; n = next_threads(n, hw))
+            report(xyfmt("par_count_if {} threads", n), best_ns(K_reps, [&] {
+                keep(xyu::par_count_if(a, odd, with_threads(n))); }), K_n);
+
+        title("parallel: sort (random uint64)");
+        Vec src = make_data(K_sort_n), work = make_data(K_sort_n);
+        // threads 为 1 时 par_sort 直接进行串行的内省排序
+        report("serial introsort", sort_ns(src, work, [](Vec& v) { xyu::par_sort(v, with_threads(1)); }), K_sort_n);
+        for (xyu::size_t n = 2; n && n <= hw; n = next_threads(n, hw))
+            report(xyfmt("par_sort {} threads", n), sort_ns(src, work, [&](Vec& v) {
+                xyu::par_sort(v, with_threads(n)); }), K_sort_n);
+    }
+}
@@ -0,0 +1,67 @@
+#include "./bench.h"
+#include "../link/mutex"
+
+/* Mutex_RW 与 Mutex_RW_Biased 的读扩展性 */
+
+namespace
+{
+    // 每个线程的读取次数
+    constexpr xyu::size_t K_reads = 1 << 21;
+    // 读多写少测试中，每个线程每读取多少次写入一次
+    constexpr xyu::size_t K_write_every = 4096;
+
+    // 受保护的数据 (模拟配置表，读者读取全部字段)
+    struct Table
+    {
+        xyu::size_t v[8] = {};
+    };
+
+    // n 个线程各读取 K_reads 次，write_every 不为 0 时每读取 write_every 次写入一次
+    template <typename M>
+    xyu::int64 readers(M& m, Table& t, xyu::size_t n, xyu::size_t write_every)
+    {
+        return bench::run_threads(n, [&](xyu::size_t) {
+            xyu::size_t sum = 0;
+            for (xyu::size_t k = 1; k <= K_reads; ++k)
+            {
+                if (write_every && k % write_every == 0) {
+                    typename M::Guard_Write g{m};
+                    for (auto& x : t.v) ++x;
+                }
+                typename M::Guard_Read g{m};
+                for (auto x : t.v) sum += x;
+            }
+            bench::keep(sum);
+        });
+    }
+
+    template <typename M>
+    void row(const char* name, xyu::size_t n, xyu::size_t write_every)
+    {
+        M m;
+        Table t;
+        bench::report(xyfmt("{} {} threads", name, n), readers(m, t, n, write_every), K_reads * n);
+    }
+}
+
+namespace bench
+{
+    void rwlock()
+    {
+        xyu::size_t hw = hardware_threads();
+
+        title("rwlock: read scaling (read lock only, ns per read over all threads)");
+        for (xyu::size_t n = 1; n; n = next_threads(n, hw))
+        {
+            row<xyu::Mutex_RW>("Mutex_RW", n, 0);
+            row<xyu::Mutex_RW_Biased>("Mutex_RW_Biased", n, 0);
+        }
+
+        title("rwlock: read-mostly (one write per 4096 reads per thread)");
+        for (xyu::size_t n = 1; n; n = next_threads(n, hw))
+        {
+            row<xyu::Mutex_RW>("Mutex_RW", n, K_write_every);
+            row<xyu::Mutex_RW_Biased>("Mutex_RW_Biased", n, K_write_every);
+        }
+    }
+}
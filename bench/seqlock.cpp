@@ -0,0 +1,82 @@
+#include "./bench.h"
+#include "../link/seqlock"
+#include "../link/mutex"
+
+/* SeqLock 与 Mutex_RW::Guard_Read 读取小型快照的开销 */
+
+namespace
+{
+    // 每个读者线程的读取次数
+    constexpr xyu::size_t K_reads = 1 << 21;
+    // 写者每次写入后的停顿 (cpu_pause 次数)
+    constexpr int K_write_gap = 256;
+
+    // 快照 (模拟限流参数与时钟偏移)
+    struct Snapshot
+    {
+        xyu::uint64 rate, burst, offset, stamp;
+    };
+
+    // 以 SeqLock 保护
+    struct BySeq
+    {
+        xyu::SeqLock<Snapshot> sl;
+        Snapshot read() const noexcept { return sl.load(); }
+        void write(const Snapshot& s) noexcept { sl.store(s); }
+    };
+
+    // 以 Mutex_RW 保护
+    struct ByRW
+    {
+        mutable xyu::Mutex_RW m;
+        Snapshot s{};
+        Snapshot read() const { xyu::Mutex_RW::Guard_Read g{m}; return s; }
+        void write(const Snapshot& v) { xyu::Mutex_RW::Guard_Write g{m}; s = v; }
+    };
+
+    // n 个读者各读取 K_reads 次；writer 为真时另有一个线程持续写入，直到读者全部结束
+    template <typename P>
+    xyu::int64 run(xyu::size_t n, bool writer)
+    {
+        P p;
+        xyu::Atomic<xyu::size_t> left{n};
+        return bench::run_threads(n + writer, [&](xyu::size_t i) {
+            if (i == n) {
+                for (xyu::uint64 k = 1; left.load(xyu::N_ATOMIC_RELAXED); ++k) {
+                    p.write(Snapshot{k, k, k, k});
+                    for (int j = 0; j < K_write_gap; ++j) xyu::cpu_pause();
+                }
+                return;
+            }
+            xyu::uint64 sum = 0;
+            for (xyu::size_t k = 0; k < K_reads; ++k) {
+                Snapshot s = p.read();
+                sum += s.rate + s.burst + s.offset + s.stamp;
+            }
+            bench::keep(sum);
+            left.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+        });
+    }
+}
+
+namespace bench
+{
+    void seqlock()
+    {
+        xyu::size_t hw = hardware_threads();
+
+        title("seqlock: read a 32-byte snapshot (ns per read over all readers)");
+        for (xyu::size_t n = 1; n; n = next_threads(n, hw))
+        {
+            report(xyfmt("SeqLock {} readers", n), run<BySeq>(n, false), K_reads * n);
+            report(xyfmt("Mutex_RW::Guard_Read {} readers", n), run<ByRW>(n, false), K_reads * n);
+        }
+
+        title("seqlock: read while one thread keeps writing");
+        for (xyu::size_t n = 1; n; n = next_threads(n, hw))
+        {
+            report(xyfmt("SeqLock {} readers", n), run<BySeq>(n, true), K_reads * n);
+            report(xyfmt("Mutex_RW::Guard_Read {} readers", n), run<ByRW>(n, true), K_reads * n);
+        }
+    }
+}
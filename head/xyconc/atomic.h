@@ -5,10 +5,60 @@
 #pragma once
 
 #include "../../link/format"
+#include "../../link/time"
+
+// 是否支持 16 字节的无锁 CAS (x86-64 下为 cmpxchg16b 指令，需要 -mcx16 编译选项)
+#if !XY_UNTHREAD && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define XY_ATOMIC_DWCAS 1
+#else
+#define XY_ATOMIC_DWCAS 0
+#endif
 
 /// 原子变量
 namespace xylu::xyconc
 {
+#if !XY_UNTHREAD
+    namespace __
+    {
+#if XY_ATOMIC_DWCAS
+        // 双字 (16 字节) 原子操作的存储类型
+        __extension__ typedef unsigned __int128 atomic_dw_t;
+#endif
+
+        // 唤醒所有等待线程
+        constexpr int K_wake_all = 0x7fffffff;
+
+        /**
+         * 地址等待 (实现于源文件)
+         * - Linux (XY_FUTEX) 下直接在地址上 futex 等待/唤醒，其他平台使用按地址散列的 Mutex + CondVar
+         * - 每个散列桶记录等待线程数量，没有等待线程时唤醒不进入内核
+         * - 唤醒者需要先写入新值再调用 wake_addr；等待可能虚假唤醒，调用者需要重新检查
+         * - addr 指向 4 字节对齐的 32 位字
+         */
+
+        // *addr 等于 val 时挂起，直到被唤醒
+        void wait_addr(const void* addr, xyu::uint32 val) noexcept;
+        // *addr 等于 val 时挂起，直到被唤醒 或 超时 (从1970年1月1日开始的 s 秒 + ns 纳秒)，返回是否未超时
+        bool wait_addr_to(const void* addr, xyu::uint32 val, xyu::size_t s, xyu::size_t ns) noexcept;
+        // 唤醒最多 n 个在 addr 上等待的线程
+        void wake_addr(const void* addr, int n) noexcept;
+
+        /**
+         * 散列桶等待 (用于非 32 位的值，无法直接 futex 等待)
+         * - still(addr, arg) 为真时挂起，等待于 addr 所在散列桶的通知序号上
+         * - 唤醒时唤醒同一散列桶中的所有等待线程
+         */
+
+        // still(addr, arg) 为真时挂起，直到被唤醒
+        void park_wait(const void* addr, bool (*still)(const void*, const void*) noexcept, const void* arg) noexcept;
+        // still(addr, arg) 为真时挂起，直到被唤醒 或 超时 (从1970年1月1日开始的 s 秒 + ns 纳秒)，返回是否未超时
+        bool park_wait_to(const void* addr, bool (*still)(const void*, const void*) noexcept, const void* arg,
+                          xyu::size_t s, xyu::size_t ns) noexcept;
+        // 唤醒在 addr 所在散列桶上等待的所有线程
+        void park_wake(const void* addr) noexcept;
+    }
+#endif
+
     /**
      * @brief 原子变量类
      * @note 支持 整型及指针类型
@@ -29,6 +79,10 @@ namespace xylu::xyconc
      *           且对于算术和位运算，通常要求是整型或指针类型。
      * @note 在单线程编译环境 (XY_UNTHREAD 宏定义) 下，`Atomic` 的行为会退化为
      *       对普通变量的非原子操作，以消除不必要的性能开销。
+     * @note `wait`/`notify_*` 提供阻塞等待值变化的能力：32 位类型直接 futex 等待于变量本身，
+     *       其他大小的类型等待于按地址散列的桶上；没有等待线程时通知不进入内核。
+     * @note 16 字节的类型 (如 指针 + 版本号) 在支持双字 CAS 的平台上 (XY_ATOMIC_DWCAS) 保证无锁，
+     *       读取、写入、交换均通过 CAS 完成 (因此读取也需要可写内存)；否则由编译器运行库实现 (可能使用锁)。
      */
     template <typename T>
     class Atomic
@@ -37,9 +91,12 @@ namespace xylu::xyconc
         static_assert(xyu::t_can_trivial_copy<T>, "Atomic<T> must be a trivially copyable type");
 
     private:
+        // 是否使用双字 CAS (16 字节类型)
+        constexpr static bool dw = XY_ATOMIC_DWCAS && sizeof(T) == 16;
         // 对齐要求: 当 sizeof(T)<=K_DEFAULT_ALIGN 且 sizeof(T)是2的幂时，取 alignof(T)与sizof(T)的较大值
         // 如当 K_DEFAULT_ALIGN为16, sizeof(T)=16, alignof(T)=8 时，会将 align 设置为 16
-        constexpr static xyu::size_t align =
+        // 使用双字 CAS 时，必须 16 字节对齐
+        constexpr static xyu::size_t align = dw ? 16 :
                 xyu::max(alignof(T), (sizeof(T) > xyu::K_DEFAULT_ALIGN || (sizeof(T) & (sizeof(T)-1))) ? 0 : sizeof(T));
         // 存储
         alignas(align) T v;
@@ -87,18 +144,18 @@ namespace xylu::xyconc
          * @brief 是否为无锁操作
          * @note 编译期判断，根据平台、编译选项、类型大小等因素来决定是否为无锁操作
          */
-        static constexpr bool is_always_lock_free = __atomic_always_lock_free(sizeof(T), nullptr);
+        static constexpr bool is_always_lock_free = dw || __atomic_always_lock_free(sizeof(T), nullptr);
 
         /**
          * @brief 是否为无锁操作
          * @note 运行期判断，根据平台、类型大小、指针是否内存对齐等因素来决定是否为无锁操作
          */
-        bool is_lock_free() const noexcept { return __atomic_is_lock_free(sizeof(T), &v); }
+        bool is_lock_free() const noexcept { return dw || __atomic_is_lock_free(sizeof(T), &v); }
         /**
          * @brief 是否为无锁操作
          * @note 运行期判断，根据平台、类型大小、指针是否内存对齐等因素来决定是否为无锁操作
          */
-        bool is_lock_free() const volatile noexcept { return __atomic_is_lock_free(sizeof(T), &v); }
+        bool is_lock_free() const volatile noexcept { return dw || __atomic_is_lock_free(sizeof(T), &v); }
 #endif
 
         /* 原子操作 */
@@ -120,10 +177,10 @@ namespace xylu::xyconc
 
         /// 比较，如果当前值等于预期值，则写入新值并返回true，否则返回false
         bool compare_exchange_weak(T expected, T value, xyu::N_ATOMIC_ORDER = xyu::K_ATOMIC_ORDER) noexcept
-        { if (v != expected) return false; v = value; return true; }
+        { if (!same(v, expected)) return false; v = value; return true; }
         /// 比较，如果当前值等于预期值，则写入新值并返回true，否则返回false
         bool compare_exchange_weak(T expected, T value, xyu::N_ATOMIC_ORDER = xyu::K_ATOMIC_ORDER) volatile noexcept
-        { if (v != expected) return false; v = value; return true; }
+        { if (!same(const_cast<const T&>(v), expected)) return false; v = value; return true; }
         /// 比较，如果当前值等于预期值，则写入新值并返回true，否则返回false
         bool compare_exchange_strong(T expected, T value, xyu::N_ATOMIC_ORDER = xyu::K_ATOMIC_ORDER) noexcept
         { return compare_exchange_weak(expected, value); }
@@ -212,26 +269,38 @@ namespace xylu::xyconc
         /// 读取
         T load(xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) const noexcept
         {
-            alignas(align) xyu::uint8 buf[sizeof(T)];
-            auto p = reinterpret_cast<T*>(buf);
-            __atomic_load(&v, p, order);
-            return *p;
+            if constexpr (dw) return dw_value(dw_load(&v));
+            else {
+                alignas(align) xyu::uint8 buf[sizeof(T)];
+                auto p = reinterpret_cast<T*>(buf);
+                __atomic_load(&v, p, order);
+                return *p;
+            }
         }
         /// 读取
         T load(xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) const volatile noexcept
         {
-            alignas(align) xyu::uint8 buf[sizeof(T)];
-            auto p = reinterpret_cast<T*>(buf);
-            __atomic_load(&v, p, order);
-            return *p;
+            if constexpr (dw) return dw_value(dw_load(&v));
+            else {
+                alignas(align) xyu::uint8 buf[sizeof(T)];
+                auto p = reinterpret_cast<T*>(buf);
+                __atomic_load(&v, p, order);
+                return *p;
+            }
         }
 
         /// 写入
         void store(T value, xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) noexcept
-        { __atomic_store(&v, &value, order); }
+        {
+            if constexpr (dw) dw_exchange(&v, dw_bits(value));
+            else __atomic_store(&v, &value, order);
+        }
         /// 写入
         void store(T value, xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) volatile noexcept
-        { __atomic_store(&v, &value, order); }
+        {
+            if constexpr (dw) dw_exchange(&v, dw_bits(value));
+            else __atomic_store(&v, &value, order);
+        }
 
         /**
          * @brief 交换，读取旧值返回并写入新值
@@ -240,10 +309,13 @@ namespace xylu::xyconc
          */
         T exchange(T value, xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) noexcept
         {
-            alignas(align) xyu::uint8 buf[sizeof(T)];
-            auto p = reinterpret_cast<T*>(buf);
-            __atomic_exchange(&v, &value, p, order);
-            return *p;
+            if constexpr (dw) return dw_value(dw_exchange(&v, dw_bits(value)));
+            else {
+                alignas(align) xyu::uint8 buf[sizeof(T)];
+                auto p = reinterpret_cast<T*>(buf);
+                __atomic_exchange(&v, &value, p, order);
+                return *p;
+            }
         }
         /**
          * @brief 交换，读取旧值返回并写入新值
@@ -252,10 +324,13 @@ namespace xylu::xyconc
          */
         T exchange(T value, xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) volatile noexcept
         {
-            alignas(align) xyu::uint8 buf[sizeof(T)];
-            auto p = reinterpret_cast<T*>(buf);
-            __atomic_exchange(&v, &value, p, order);
-            return *p;
+            if constexpr (dw) return dw_value(dw_exchange(&v, dw_bits(value)));
+            else {
+                alignas(align) xyu::uint8 buf[sizeof(T)];
+                auto p = reinterpret_cast<T*>(buf);
+                __atomic_exchange(&v, &value, p, order);
+                return *p;
+            }
         }
 
         /**
@@ -266,7 +341,10 @@ namespace xylu::xyconc
          * @note 弱比较，可能出现虚假失败
          */
         bool compare_exchange_weak(T expected, T value, xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) noexcept
-        { return __atomic_compare_exchange_n(&v, &expected, value, true, order, get_failed_order(order)); }
+        {
+            if constexpr (dw) return dw_cas(&v, dw_bits(expected), dw_bits(value));
+            else return __atomic_compare_exchange(&v, &expected, &value, true, order, get_failed_order(order));
+        }
         /**
          * @brief 比较，如果当前值等于预期值，则写入新值并返回true，否则返回false
          * @param expected 预期值
@@ -275,7 +353,10 @@ namespace xylu::xyconc
          * @note 弱比较，可能出现虚假失败
          */
         bool compare_exchange_weak(T expected, T value, xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) volatile noexcept
-        { return __atomic_compare_exchange_n(&v, &expected, value, true, order, get_failed_order(order)); }
+        {
+            if constexpr (dw) return dw_cas(&v, dw_bits(expected), dw_bits(value));
+            else return __atomic_compare_exchange(&v, &expected, &value, true, order, get_failed_order(order));
+        }
 
         /**
         * @brief 比较，如果当前值等于预期值，则写入新值并返回true，否则返回false
@@ -285,7 +366,10 @@ namespace xylu::xyconc
         * @note 强比较，仅值不匹配时返回 false
         */
         bool compare_exchange_strong(T expected, T value, xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) noexcept
-        { return __atomic_compare_exchange_n(&v, &expected, value, false, order, get_failed_order(order)); }
+        {
+            if constexpr (dw) return dw_cas(&v, dw_bits(expected), dw_bits(value));
+            else return __atomic_compare_exchange(&v, &expected, &value, false, order, get_failed_order(order));
+        }
         /**
          * @brief 比较，如果当前值等于预期值，则写入新值并返回true，否则返回false
          * @param expected 预期值
@@ -294,7 +378,10 @@ namespace xylu::xyconc
          * @note 强比较，仅值不匹配时返回 false
          */
         bool compare_exchange_strong(T expected, T value, xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) volatile noexcept
-        { return __atomic_compare_exchange_n(&v, &expected, value, false, order, get_failed_order(order)); }
+        {
+            if constexpr (dw) return dw_cas(&v, dw_bits(expected), dw_bits(value));
+            else return __atomic_compare_exchange(&v, &expected, &value, false, order, get_failed_order(order));
+        }
 
         /**
          * @brief 读取旧值返回并写入增加后的新值
@@ -501,6 +588,69 @@ namespace xylu::xyconc
         { return __atomic_nand_fetch(&v, value, order); }
 #endif
 
+        /* 等待通知 */
+
+        /**
+         * @brief 阻塞等待，直到值不等于 old (按二进制表示比较)
+         * @param order 读取的内存序 (默认为 K_ATOMIC_ORDER)
+         * @note 需要修改值的线程在修改后调用 notify_one/notify_all
+         * @note 值变化后又变回 old 时，可能继续等待
+         * @note XY_UNTHREAD 下为空操作
+         */
+        void wait(T old [[maybe_unused]], xyu::N_ATOMIC_ORDER order [[maybe_unused]] = xyu::K_ATOMIC_ORDER) const noexcept
+        {
+#if !XY_UNTHREAD
+            while (same(load(order), old)) wait_help(old, nullptr);
+#endif
+        }
+
+        /**
+         * @brief 阻塞等待，直到值不等于 old (按二进制表示比较) 或 超时(从当前时间开始的时间段)
+         * @param order 读取的内存序 (默认为 K_ATOMIC_ORDER)
+         * @return 值是否已不等于 old
+         * @note XY_UNTHREAD 下不等待，直接返回比较结果
+         */
+        template <typename Tm, Tm Scale>
+        bool wait_for(T old, const xyu::Duration<Tm, Scale>& timeout [[maybe_unused]],
+                      xyu::N_ATOMIC_ORDER order = xyu::K_ATOMIC_ORDER) const noexcept
+        {
+#if !XY_UNTHREAD
+            if (!same(load(order), old)) return true;
+            if (XY_UNLIKELY(timeout.count <= 0)) return false;
+            xyu::Duration_ns utc = xyu::Duration_utc() + xyu::Duration_ns{timeout};
+            while (same(load(order), old))
+                if (!wait_help(old, &utc)) return !same(load(order), old);
+            return true;
+#else
+            return !same(load(order), old);
+#endif
+        }
+
+        /**
+         * @brief 唤醒一个在 wait 中等待的线程
+         * @note 非 32 位类型会唤醒同一散列桶中的所有等待线程
+         * @note XY_UNTHREAD 下为空操作
+         */
+        void notify_one() noexcept
+        {
+#if !XY_UNTHREAD
+            if constexpr (sizeof(T) == sizeof(xyu::uint32)) __::wake_addr(&v, 1);
+            else __::park_wake(&v);
+#endif
+        }
+
+        /**
+         * @brief 唤醒所有在 wait 中等待的线程
+         * @note XY_UNTHREAD 下为空操作
+         */
+        void notify_all() noexcept
+        {
+#if !XY_UNTHREAD
+            if constexpr (sizeof(T) == sizeof(xyu::uint32)) __::wake_addr(&v, __::K_wake_all);
+            else __::park_wake(&v);
+#endif
+        }
+
         /* 运算符重载 */
 
         template <typename Test = T, typename = xyu::t_enable<xyu::t_is_mathint<Test> || xyu::t_is_pointer<Test>>>
@@ -594,6 +744,9 @@ namespace xylu::xyconc
         friend Atomic operator^(const U& value, const volatile Atomic& atom) noexcept { return {atom.load() ^ value}; }
 
     private:
+        // 二进制表示是否相同
+        static bool same(const T& a, const T& b) noexcept { return __builtin_memcmp(&a, &b, sizeof(T)) == 0; }
+
 #if !XY_UNTHREAD
         // 操作失败时的内存序 (抛弃 释放操作，即不保证其他线程读取到的值为修改后的)
         constexpr static xyu::N_ATOMIC_ORDER get_failed_order(xyu::N_ATOMIC_ORDER order) noexcept
@@ -602,8 +755,107 @@ namespace xylu::xyconc
             if (order == xyu::N_ATOMIC_RELEASE) return xyu::N_ATOMIC_RELAXED;
             return order;
         }
+
+        // 值仍然等于 *old (散列桶等待的条件)
+        static bool still(const void* addr, const void* old) noexcept
+        {
+            alignas(align) xyu::uint8 buf[sizeof(T)];
+            if constexpr (dw) {
+                auto b = dw_load(static_cast<const T*>(addr));
+                __builtin_memcpy(buf, &b, sizeof(T));
+            }
+            else __atomic_load(static_cast<const T*>(addr), reinterpret_cast<T*>(buf), xyu::N_ATOMIC_ACQUIRE);
+            return __builtin_memcmp(buf, old, sizeof(T)) == 0;
+        }
+
+#if XY_ATOMIC_DWCAS
+        /**
+         * 双字 CAS 实现 (__sync 系列在双字下内联为 cmpxchg16b 等指令，均为完整屏障，因此忽略内存序)
+         * 仅在 dw 为真时调用 (其他情况下的调用位于被丢弃的 if constexpr 分支中)
+         */
+
+        // 转换为存储类型
+        static __::atomic_dw_t dw_bits(const T& x) noexcept
+        {
+            __::atomic_dw_t r;
+            __builtin_memcpy(&r, &x, sizeof(T));
+            return r;
+        }
+        // 从存储类型转换
+        static T dw_value(__::atomic_dw_t x) noexcept
+        {
+            alignas(align) xyu::uint8 buf[sizeof(T)];
+            __builtin_memcpy(buf, &x, sizeof(T));
+            return *reinterpret_cast<T*>(buf);
+        }
+        // 读取 (以相同的值 CAS，不改变内存中的值)
+        static __::atomic_dw_t dw_load(const volatile T* p) noexcept
+        {
+            auto q = const_cast<volatile __::atomic_dw_t*>(reinterpret_cast<const volatile __::atomic_dw_t*>(p));
+            return __sync_val_compare_and_swap(q, __::atomic_dw_t{0}, __::atomic_dw_t{0});
+        }
+        // 交换
+        static __::atomic_dw_t dw_exchange(volatile T* p, __::atomic_dw_t value) noexcept
+        {
+            auto q = reinterpret_cast<volatile __::atomic_dw_t*>(p);
+            __::atomic_dw_t old = dw_load(p);
+            for (;;) {
+                __::atomic_dw_t cur = __sync_val_compare_and_swap(q, old, value);
+                if (cur == old) return old;
+                old = cur;
+            }
+        }
+        // 比较交换
+        static bool dw_cas(volatile T* p, __::atomic_dw_t expected, __::atomic_dw_t value) noexcept
+        { return __sync_bool_compare_and_swap(reinterpret_cast<volatile __::atomic_dw_t*>(p), expected, value); }
+#endif
+
+        // 挂起等待值变化 (utc 为空时不超时)，返回是否未超时
+        bool wait_help(const T& old, const xyu::Duration_ns* utc) const noexcept
+        {
+            xyu::size_t s = 0, ns = 0;
+            if (utc) {
+                if (XY_UNLIKELY(utc->count <= 0)) return false;
+                s = static_cast<xyu::size_t>(utc->count / 1000000000);
+                ns = static_cast<xyu::size_t>(utc->count % 1000000000);
+            }
+            if constexpr (sizeof(T) == sizeof(xyu::uint32)) {
+                xyu::uint32 w;
+                __builtin_memcpy(&w, &old, sizeof(w));
+                if (!utc) { __::wait_addr(&v, w); return true; }
+                return __::wait_addr_to(&v, w, s, ns);
+            } else {
+                if (!utc) { __::park_wait(&v, still, &old); return true; }
+                return __::park_wait_to(&v, still, &old, s, ns);
+            }
+        }
 #endif
     };
+
+    /**
+     * @brief 内存屏障，约束屏障前后内存操作的重排
+     * @param order 内存序 (默认为 K_ATOMIC_ORDER)
+     * @note XY_UNTHREAD 下为空操作
+     */
+    inline void atomic_fence(xyu::N_ATOMIC_ORDER order [[maybe_unused]] = xyu::K_ATOMIC_ORDER) noexcept
+    {
+#if !XY_UNTHREAD
+        __atomic_thread_fence(order);
+#endif
+    }
+
+    /**
+     * @brief 自旋等待提示，用于忙等待循环中 (x86 下为 pause 指令)
+     * @note 减少自旋时的功耗，并避免退出循环时的流水线冲刷
+     */
+    inline void cpu_pause() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
 }
 
 /// 格式化
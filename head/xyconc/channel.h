@@ -0,0 +1,270 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/initlist"
+#include "../../link/atomic"
+
+/// 通道
+namespace xylu::xyconc
+{
+    class Channel_Base;
+
+    /// select 的一个分支 (由 Channel::send_case / recv_case 生成)
+    struct Channel_Case
+    {
+        Channel_Base* ch;   ///< 通道
+        void* elem;         ///< 发送: 待发送的元素 (成功时被移动); 接收: 接收元素的对象
+        bool send;          ///< 是否为发送
+    };
+
+    /// select 的结果
+    struct Select_Result
+    {
+        /// 没有分支就绪 (仅 try_select)
+        static constexpr xyu::size_t K_none = static_cast<xyu::size_t>(-1);
+
+        xyu::size_t index;  ///< 完成的分支下标
+        bool ok;            ///< 是否成功传递元素 (false 表示通道已关闭)
+    };
+
+    namespace __
+    {
+        // 等待者的停靠点 (一次阻塞操作或 select 的所有分支共享)
+        struct ChanParker
+        {
+            xyu::Atomic<xyu::uint32> st{0}; // 状态 (0: 等待中, 1: 已被某个分支认领, 2: 已完成)
+            xyu::size_t fired = 0;          // 完成的分支下标
+            bool ok = false;                // 是否成功传递元素 (false 表示通道已关闭)
+        };
+
+        // 通道上的等待者 (位于等待线程的栈上)
+        struct ChanWaiter
+        {
+            ChanParker* pk;                 // 停靠点
+            void* elem;                     // 发送: 待发送的元素; 接收: 接收元素的对象
+            xyu::size_t idx;                // 分支下标
+            ChanWaiter* prev;               // 前一个等待者
+            ChanWaiter* next;               // 后一个等待者
+            bool linked;                    // 是否仍在等待队列中
+        };
+
+        // 等待队列 (先进先出)
+        struct ChanQueue
+        {
+            ChanWaiter* head = nullptr;     // 队首
+            ChanWaiter* tail = nullptr;     // 队尾
+        };
+
+        // 元素操作 (类型擦除，使通道的协议与 select 不依赖元素类型)
+        struct ChanOps
+        {
+            void (*put)(void* buf, xyu::size_t i, void* src) noexcept;  // 将 src 移动构造到缓冲区第 i 个位置
+            void (*take)(void* buf, xyu::size_t i, void* dst) noexcept; // 将缓冲区第 i 个元素移动赋值到 dst 并析构
+            void (*give)(void* dst, void* src) noexcept;                // 将 src 移动赋值到 dst
+        };
+
+        template <typename T>
+        struct ChanOps_T
+        {
+            static void put(void* buf, xyu::size_t i, void* src) noexcept
+            { ::new (static_cast<T*>(buf) + i) T(xyu::move(*static_cast<T*>(src))); }
+
+            static void take(void* buf, xyu::size_t i, void* dst) noexcept
+            {
+                T* p = static_cast<T*>(buf) + i;
+                *static_cast<T*>(dst) = xyu::move(*p);
+                p->~T();
+            }
+
+            static void give(void* dst, void* src) noexcept
+            { *static_cast<T*>(dst) = xyu::move(*static_cast<T*>(src)); }
+
+            static constexpr ChanOps ops{put, take, give};
+        };
+
+        // select 的实现
+        Select_Result select_help(const Channel_Case* cases, xyu::size_t n, bool block);
+    }
+
+    /**
+     * @brief 通道的类型无关部分 (协议、等待队列与内部锁)
+     * @note 通过 `Channel<T>` 使用
+     */
+    class Channel_Base : xyu::class_no_copy_move_t
+    {
+        friend Select_Result __::select_help(const Channel_Case* cases, xyu::size_t n, bool block);
+    public:
+        /// 非阻塞操作的结果
+        enum State : xyu::uint8
+        {
+            OK,             ///< 成功
+            WOULD_BLOCK,    ///< 需要等待 (缓冲区满或空，且没有对端在等待)
+            CLOSED,         ///< 通道已关闭 (接收时为已关闭且缓冲区已空)
+        };
+
+    protected:
+        mutable xyu::Atomic<xyu::uint32> lk{0}; // 内部锁 (0: 未上锁, 1: 已上锁, 2: 已上锁且可能有等待线程)
+        const __::ChanOps* ops;             // 元素操作
+        void* buf;                          // 环形缓冲区
+        xyu::size_t cap;                    // 缓冲区容量 (0 表示无缓冲)
+        xyu::size_t head = 0;               // 缓冲区首个元素的位置
+        xyu::size_t cnt = 0;                // 缓冲区中的元素数量
+        bool cl = false;                    // 是否已关闭
+        __::ChanQueue sq;                   // 等待发送的队列
+        __::ChanQueue rq;                   // 等待接收的队列
+
+    protected:
+        // 构造 (缓冲区由派生类分配)
+        Channel_Base(const __::ChanOps* ops, void* buf, xyu::size_t cap) noexcept : ops{ops}, buf{buf}, cap{cap} {}
+        ~Channel_Base() noexcept = default;
+
+    public:
+        /// 获取缓冲区容量
+        xyu::size_t capacity() const noexcept { return cap; }
+
+        /// 获取缓冲区中的元素数量 (并发时仅为近似值)
+        xyu::size_t size() const noexcept;
+
+        /// 是否已关闭
+        bool closed() const noexcept;
+
+        /**
+         * @brief 关闭通道，唤醒所有等待的发送者与接收者 (它们返回失败)
+         * @return 是否由本次调用关闭 (已关闭时返回 false)
+         * @note 关闭后缓冲区中的元素仍可被接收，之后的发送均失败
+         */
+        bool close() noexcept;
+
+    protected:
+        // 发送或接收 (block 为 false 时不等待)
+        State op(bool send, void* elem, bool block) noexcept;
+
+    private:
+        // 尝试立即完成操作 (需持有锁)
+        State attempt(bool send, void* elem) noexcept;
+        // 加入等待队列 (需持有锁)
+        void enqueue(__::ChanWaiter& w, bool send) noexcept;
+        // 移出等待队列 (需持有锁)
+        void unlink(__::ChanWaiter& w, bool send) noexcept;
+        // 从队列中取出第一个可认领的等待者 (需持有锁)
+        __::ChanWaiter* claim(bool send) noexcept;
+        // 上锁
+        void lock() const noexcept;
+        // 解锁
+        void unlock() const noexcept;
+    };
+
+    /**
+     * @brief 类型化的多生产者多消费者通道 (Go 风格的 channel)，用于在线程之间传递元素。
+     *
+     * @details
+     *   - 有缓冲 (capacity > 0): 缓冲区未满时发送立即返回，缓冲区为空时接收等待。
+     *   - 无缓冲 (capacity = 0): 发送者与接收者直接交接元素，先到的一方等待另一方。
+     *
+     *   ### 实现:
+     *   - 内部锁与等待均基于地址等待 (__::wait_addr)，不需要 Mutex 与 CondVar。
+     *   - 等待者位于等待线程的栈上，对端直接将元素移动到等待者的对象中并唤醒它。
+     *   - 缓冲区在构造时一次分配，发送与接收不进行动态分配。
+     *
+     *   ### 关闭:
+     *   - `close()` 后发送均返回失败，等待中的发送者被唤醒并返回失败 (元素未被移动)。
+     *   - 接收在缓冲区中的元素被取完后返回失败。
+     *
+     *   ### select:
+     *   `xyu::select({a.recv_case(x), b.send_case(y)})` 等待多个通道中的任意一个操作完成，
+     *   只完成其中一个分支；没有就绪的分支时只挂起一次，不轮询。
+     *   `try_select` 在没有就绪的分支时立即返回 `Select_Result::K_none`。
+     *
+     * @tparam T 元素类型 (移动构造与移动赋值不能抛出异常)
+     * @note 析构时不能有等待中的线程。
+     *
+     * @example
+     *   xyu::Channel<int> jobs{64};
+     *   xyu::Channel<xyu::String> logs;
+     *   int j; xyu::String s;
+     *   auto r = xyu::select({jobs.recv_case(j), logs.recv_case(s)});
+     *   if (!r.ok) ...           // 对应的通道已关闭
+     *   else if (r.index == 0) ... // 收到任务 j
+     */
+    template <typename T>
+    class Channel : public Channel_Base
+    {
+        static_assert(xyu::t_can_nothrow_mvconstr<T> && xyu::t_can_nothrow_mvassign<T>,
+                      "element of Channel must be nothrow move constructible and assignable");
+    public:
+        /**
+         * @brief 创建通道
+         * @param capacity 缓冲区容量 (0 表示无缓冲)
+         * @exception E_Memory_Alloc
+         */
+        explicit Channel(xyu::size_t capacity = 0)
+            : Channel_Base{&__::ChanOps_T<T>::ops, capacity ? xyu::alloc<T>(xyu::native_v, capacity) : nullptr, capacity} {}
+
+        /// 析构 (析构缓冲区中剩余的元素)
+        ~Channel() noexcept
+        {
+            for (xyu::size_t i = 0; i < cnt; ++i) (static_cast<T*>(buf) + (head + i) % cap)->~T();
+            if (buf) xyu::dealloc<T>(xyu::native_v, static_cast<T*>(buf), cap);
+        }
+
+        /* 阻塞操作 */
+
+        /**
+         * @brief 发送元素 (缓冲区满或无缓冲时等待接收者)
+         * @return 是否发送成功 (通道已关闭时返回 false，v 未被移动)
+         */
+        bool send(T&& v) noexcept { return op(true, &v, true) == OK; }
+
+        /// 发送元素的副本
+        bool send(const T& v) { T t{v}; return send(xyu::move(t)); }
+
+        /**
+         * @brief 接收元素 (没有元素时等待发送者)
+         * @return 是否接收成功 (通道已关闭且缓冲区已空时返回 false，out 不变)
+         */
+        bool recv(T& out) noexcept { return op(false, &out, true) == OK; }
+
+        /* 非阻塞操作 */
+
+        /// 尝试发送元素 (仅在返回 OK 时 v 被移动)
+        State try_send(T&& v) noexcept { return op(true, &v, false); }
+
+        /// 尝试发送元素的副本
+        State try_send(const T& v) { T t{v}; return try_send(xyu::move(t)); }
+
+        /// 尝试接收元素 (仅在返回 OK 时 out 被赋值)
+        State try_recv(T& out) noexcept { return op(false, &out, false); }
+
+        /* select 分支 */
+
+        /// 生成发送分支 (v 在 select 期间需保持有效，该分支完成时被移动)
+        Channel_Case send_case(T& v) noexcept { return {this, &v, true}; }
+
+        /// 生成接收分支 (out 在 select 期间需保持有效，该分支完成时被赋值)
+        Channel_Case recv_case(T& out) noexcept { return {this, &out, false}; }
+    };
+
+    /**
+     * @brief 等待多个分支中的任意一个完成 (多个分支就绪时从轮换的起点开始选择)
+     * @return 完成的分支与结果
+     * @exception E_Logic_Invalid_Argument 没有分支
+     * @exception E_Memory_Alloc 分支多于 8 个时分配临时内存失败
+     */
+    inline Select_Result select(const Channel_Case* cases, xyu::size_t n) { return __::select_help(cases, n, true); }
+
+    /// 等待多个分支中的任意一个完成
+    inline Select_Result select(std::initializer_list<Channel_Case> cases) { return __::select_help(cases.begin(), cases.size(), true); }
+
+    /**
+     * @brief 完成一个已就绪的分支，没有就绪的分支时返回 index 为 Select_Result::K_none 的结果
+     * @exception E_Memory_Alloc 分支多于 8 个时分配临时内存失败
+     */
+    inline Select_Result try_select(const Channel_Case* cases, xyu::size_t n) { return __::select_help(cases, n, false); }
+
+    /// 完成一个已就绪的分支
+    inline Select_Result try_select(std::initializer_list<Channel_Case> cases) { return __::select_help(cases.begin(), cases.size(), false); }
+}
+
+#pragma clang diagnostic pop
@@ -20,6 +20,14 @@ namespace xylu::xyconc
 #else
         // 超时等待辅助函数 (timepoint)
         bool wait_timeout_help(void* cvh, void* mh, xyu::size_t s, xyu::size_t ns);
+#endif
+#if XY_MUTEX_FUTEX
+        // futex 条件变量状态
+        struct CondVar_Futex
+        {
+            xyu::Atomic<xyu::uint32> seq{0};    // 通知序号 (futex 等待于此)
+            xyu::Atomic<xyu::uint32> wn{0};     // 等待线程数量 (为 0 时通知不进入内核)
+        };
 #endif
     }
 
@@ -33,13 +41,27 @@ namespace xylu::xyconc
      *   等待操作会自动释放锁，并在被唤醒后重新获取锁。
      *
      * @note 跨平台兼容性：在非 Windows 平台上，`CondVar` 无法与 `Mutex_RW` 一起使用。
+     * @note Linux 下 (XY_FUTEX) 基于 futex 实现，不进行动态分配，没有等待线程时通知不进入内核。
      */
     class CondVar : xyu::class_no_copy_t
     {
     private:
+#if XY_MUTEX_FUTEX
+        __::CondVar_Futex h;    // 条件变量状态
+#else
         void* h;    // 条件变量句柄
+#endif
 
     public:
+#if XY_MUTEX_FUTEX
+        /// 创建条件变量
+        CondVar() noexcept = default;
+        /// 销毁条件变量
+        ~CondVar() noexcept = default;
+
+        /// 移动构造
+        CondVar(CondVar&& other) noexcept : h{other.h} {}
+#else
         /// 创建条件变量
         CondVar();
         /// 销毁条件变量
@@ -47,6 +69,7 @@ namespace xylu::xyconc
 
         /// 移动构造
         CondVar(CondVar&& other) noexcept : h{other.h} { other.h = nullptr; }
+#endif
         /// 移动赋值
         CondVar& operator=(CondVar&& other) noexcept { xyu::swap(h, other.h); return *this; }
 
@@ -66,7 +89,7 @@ namespace xylu::xyconc
 #if (defined(_WIN32) || defined(__CYGWIN__))
             __::wait_help(&h, &guard.m.h, xyu::t_is_same_nocvref<Guard, Mutex_RW::Guard_Read>);
 #else
-            __::wait_help(h, guard.m.h);
+            __::wait_help(cvh(), mh(guard.m));
 #endif
         }
 
@@ -97,7 +120,7 @@ namespace xylu::xyconc
 #else
             auto total = timeout + xyu::Duration_utc();
             xyu::Duration<T, 1000000000> s(total);
-            return __::wait_timeout_help(h, guard.m.h, s.count, (total - s).ns());
+            return __::wait_timeout_help(cvh(), mh(guard.m), s.count, (total - s).ns());
 #endif
         }
 
@@ -117,7 +140,7 @@ namespace xylu::xyconc
 #else
             auto total = timeout + tmp;
             xyu::Duration<T, 1000000000> s(total);
-            bool ret = __::wait_timeout_help(h, guard.m.h, s.count, (total - s).ns());
+            bool ret = __::wait_timeout_help(cvh(), mh(guard.m), s.count, (total - s).ns());
 #endif
             // 超时返回
             if (!ret) return false;
@@ -183,7 +206,7 @@ namespace xylu::xyconc
             auto s = (timepoint - xyu::Calendar{} - xyu::Duration_utcdiff()).s();
             if (XY_UNLIKELY(s < 0)) return false;
             auto ns = timepoint.ms() * 1000000;
-            return __::wait_timeout_help(h, guard.m.h, s, ns);
+            return __::wait_timeout_help(cvh(), mh(guard.m), s, ns);
 #endif
         }
 
@@ -207,7 +230,7 @@ namespace xylu::xyconc
             for (;;)
             {
                 // 等待条件变量
-                bool ret = __::wait_timeout_help(h, guard.m.h, s, ns);
+                bool ret = __::wait_timeout_help(cvh(), mh(guard.m), s, ns);
                 // 超时直接返回
                 if (!ret) return false;
                 // 非虚假唤醒，返回
@@ -235,7 +258,7 @@ namespace xylu::xyconc
 #else
             if (XY_UNLIKELY(utc_timeout.count <= 0)) return false;
             xyu::Duration<T, 1000000000> ds(utc_timeout);
-            return __::wait_timeout_help(h, guard.m.h, ds.count, (utc_timeout - ds).ns());
+            return __::wait_timeout_help(cvh(), mh(guard.m), ds.count, (utc_timeout - ds).ns());
 #endif
         }
 
@@ -259,7 +282,7 @@ namespace xylu::xyconc
             for (;;)
             {
                 // 等待条件变量
-                bool ret = __::wait_timeout_help(h, guard.m.h, s, ns);
+                bool ret = __::wait_timeout_help(cvh(), mh(guard.m), s, ns);
                 // 超时直接返回
                 if (!ret) return false;
                 // 非虚假唤醒，返回
@@ -272,6 +295,16 @@ namespace xylu::xyconc
         template <typename Guard, typename Value, typename T, T Scale, xyu::t_enable<!xyu::t_can_call<Value>, bool> = false>
         bool wait_to(Guard& guard, Value& v, const xyu::Duration<T, Scale>& utc_timeout)
         { return wait_to(guard, [&v]{ return static_cast<bool>(v); }, utc_timeout); }
+
+    private:
+        // 获取等待辅助函数使用的句柄 (非 Windows)
+#if XY_MUTEX_FUTEX
+        void* cvh() noexcept { return &h; }
+        static void* mh(Mutex& m) noexcept { return &m.h; }
+#else
+        void* cvh() noexcept { return h; }
+        static void* mh(Mutex& m) noexcept { return m.h; }
+#endif
     };
 }
 
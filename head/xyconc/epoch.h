@@ -0,0 +1,114 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/atomic"
+#include "../../link/new"
+
+/// 基于纪元的内存回收
+namespace xylu::xyconc
+{
+    namespace __
+    {
+        // 线程纪元记录 (实现于源文件)
+        struct EpochRecord;
+    }
+
+    /**
+     * @brief 基于纪元的内存回收 (Epoch-Based Reclamation)，用于无锁数据结构中被摘除节点的延迟释放。
+     *
+     * @details
+     *   无锁数据结构中，一个线程摘除节点后，其他线程可能仍持有该节点的指针，不能立即释放。
+     *   纪元回收维护一个全局纪元，访问共享数据前通过 `pin()` 进入临界区 (记录当前纪元)，
+     *   摘除的节点通过 `retire` 延迟释放：节点在纪元 e 退休后，待全局纪元推进到 e + 2 时，
+     *   所有可能持有其指针的临界区都已结束，此时才调用释放函数。
+     *
+     *   ### 使用方式:
+     *   - `auto g = Epoch::pin();`: 在读取共享指针前进入临界区，g 析构时退出 (可嵌套)。
+     *   - `Epoch::retire(p, deleter)`: 摘除节点后退休，稍后由本线程调用 deleter(p)。
+     *   - `Epoch::retire(p)` / `Epoch::retire(xyu::native_v, p)`: 析构并通过 `xyu::dealloc` 释放，
+     *     分别对应 `xyu::alloc<T>(1)` (线程内存池) 与 `xyu::alloc<T>(xyu::native_v, 1)` (原生) 分配的节点。
+     *   - `Epoch::collect()`: 立即尝试推进纪元并释放本线程可以释放的节点。
+     *
+     *   ### 实现:
+     *   - 每个线程拥有一个纪元记录 (局部纪元 + 是否在临界区内)，记录链接在全局链表中，线程结束后由新线程复用。
+     *   - 退休的节点按批次积累在本线程的记录中，每积累一批尝试推进全局纪元并释放已安全的节点，
+     *     进入与退出临界区只需读写本线程的记录。
+     *   - 所有处于临界区的线程都已观察到当前纪元时，全局纪元才能推进。
+     *
+     * @note 临界区应当尽量短：长时间停留在临界区会阻止纪元推进，导致退休节点积累。
+     * @note 线程结束时会等待其他线程的临界区结束，直到本线程退休的节点全部释放，因此线程不应在其他线程持有临界区时等待其结束。
+     * @note 释放函数在调用 retire 或 collect 的线程中执行；线程内存池分配的节点因此归还到该线程的内存池。
+     */
+    class Epoch
+    {
+    public:
+        /// 临界区守卫 (构造时进入，析构时退出)
+        class Guard : xyu::class_no_copy_move_t
+        {
+        private:
+            __::EpochRecord* r;     // 本线程的纪元记录
+
+        public:
+            /**
+             * @brief 进入临界区
+             * @exception E_Memory_Alloc 线程首次使用时分配纪元记录失败
+             */
+            Guard();
+            /// 退出临界区
+            ~Guard() noexcept;
+        };
+
+        /**
+         * @brief 进入临界区
+         * @exception E_Memory_Alloc 线程首次使用时分配纪元记录失败
+         */
+        static Guard pin() { return Guard{}; }
+
+        /**
+         * @brief 退休节点，待所有可能持有其指针的临界区结束后，调用 deleter(p)
+         * @exception E_Memory_Alloc 扩充退休列表失败 (此时节点未退休)
+         * @note 必须在节点从共享数据中摘除之后调用
+         */
+        static void retire(void* p, void (*deleter)(void*) noexcept);
+
+        /**
+         * @brief 退休节点，之后析构并释放到线程内存池 (对应 xyu::alloc<T>(1) 分配的节点)
+         * @exception E_Memory_Alloc 扩充退休列表失败 (此时节点未退休)
+         */
+        template <typename T>
+        static void retire(T* p)
+        {
+            static_assert(xyu::t_can_nothrow_destruct<T>);
+            retire(static_cast<void*>(p), [](void* q) noexcept {
+                auto t = static_cast<T*>(q);
+                t->~T();
+                xyu::dealloc<T>(t, 1);
+            });
+        }
+
+        /**
+         * @brief 退休节点，之后析构并释放到底层分配器 (对应 xyu::alloc<T>(xyu::native_v, 1) 分配的节点)
+         * @exception E_Memory_Alloc 扩充退休列表失败 (此时节点未退休)
+         */
+        template <typename T>
+        static void retire(xyu::native_t, T* p)
+        {
+            static_assert(xyu::t_can_nothrow_destruct<T>);
+            retire(static_cast<void*>(p), [](void* q) noexcept {
+                auto t = static_cast<T*>(q);
+                t->~T();
+                xyu::dealloc<T>(xyu::native_v, t);
+            });
+        }
+
+        /// 尝试推进全局纪元，并释放本线程中已安全的退休节点
+        static void collect() noexcept;
+
+        /// 获取当前全局纪元
+        static xyu::size_t epoch() noexcept;
+    };
+}
+
+#pragma clang diagnostic pop
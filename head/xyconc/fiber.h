@@ -0,0 +1,303 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/tuple"
+#include "../../link/atomic"
+#include "../../link/time"
+
+// 是否支持纤程 (x86-64 System V 下使用手写的上下文切换，其他 POSIX 平台使用 ucontext)
+#if !XY_UNTHREAD && !defined(_WIN32) && !defined(__CYGWIN__)
+#define XY_FIBER 1
+#else
+#define XY_FIBER 0
+#endif
+
+#if XY_FIBER
+
+/// 纤程
+namespace xylu::xyconc
+{
+    namespace __
+    {
+        // 纤程控制块 (实现于源文件)
+        struct FiberBlock;
+        // 等待节点 (位于等待者的栈上，实现于源文件)
+        struct FiberWaiter;
+
+        // 等待队列 (纤程与线程均可等待)
+        struct FiberQueue
+        {
+            xyu::Atomic<bool> lk{false};    // 队列自旋锁 (仅保护入队与出队)
+            FiberWaiter* head = nullptr;    // 队首
+            FiberWaiter* tail = nullptr;    // 队尾
+        };
+
+        // 创建纤程 (fun 在纤程中执行，执行完毕后负责释放 arg)
+        FiberBlock* fiber_spawn(void (*fun)(void*), void* arg, xyu::size_t stack_size);
+    }
+
+    /**
+     * @brief 有栈纤程 (用户态协程)，由当前线程的纤程调度器执行。
+     *
+     * @details
+     *   纤程拥有独立的栈，在用户态切换上下文，挂起时不阻塞所在的操作系统线程。
+     *   适用于大量 I/O 密集的并发会话：每个会话一个纤程，而不是一个线程。
+     *
+     *   ### 调度:
+     *   - 每个线程拥有一个调度器，纤程创建后加入当前线程的调度器，之后始终在该线程上执行。
+     *   - `Fiber::run()` 在当前线程上执行调度循环，直到该线程的所有纤程结束。
+     *   - 纤程通过 `yield`、`sleep_for`、`FiberMutex`、`FiberCondVar`、`join` 让出执行权；
+     *     其他线程唤醒纤程时，通过调度器的远程队列交还给纤程所在的线程。
+     *
+     *   ### 实现:
+     *   - x86-64 下使用手写汇编切换上下文 (仅保存被调用者保存的寄存器)，其他平台使用 ucontext。
+     *   - 栈通过 mmap 分配，最低处设置保护页 (栈溢出时触发段错误而不是破坏相邻内存)；
+     *     默认大小的栈结束后缓存在线程内，供之后创建的纤程复用。
+     *
+     *   ### 句柄:
+     *   - `Fiber` 对象是纤程的句柄，析构时等待纤程结束 (同 Thread_Native)。
+     *   - 纤程中抛出的异常被捕获，在 `join()` 中重新抛出。
+     *
+     * @note 纤程中调用会阻塞线程的操作 (如 Mutex、Clock::sleep) 会阻塞同一线程上的所有纤程，应使用纤程版本。
+     * @note 纤程的栈较小 (默认 K_stack_size)，避免在纤程中使用大的栈上数组或深度递归。
+     *
+     * @example
+     *   xyu::Fiber a([]{ for (int i = 0; i < 3; ++i) xyu::Fiber::yield(); });
+     *   xyu::Fiber b([](int x) { xyu::Fiber::sleep_for(xyu::Duration_ms{10}); }, 42);
+     *   xyu::Fiber::run();  // 执行直到 a、b 都结束
+     */
+    class Fiber : xyu::class_no_copy_t
+    {
+    public:
+        /// 默认栈大小
+        static constexpr xyu::size_t K_stack_size = 64 * 1024;
+
+        /// 纤程属性
+        struct Option
+        {
+            xyu::size_t stack_size;     ///< 栈大小 (向上取整到页大小；仅默认大小的栈会被缓存复用)
+
+            constexpr Option() noexcept : stack_size{K_stack_size} {}
+        };
+
+    private:
+        __::FiberBlock* b = nullptr;    // 纤程控制块
+
+    public:
+        /* 构造析构 */
+
+        /// 默认构造
+        Fiber() noexcept = default;
+
+        /**
+         * @brief 创建纤程，加入当前线程的调度器 (不立即执行)
+         * @exception E_Memory_Alloc 分配控制块或栈失败
+         */
+        template <typename Fun, typename... Args, typename = xyu::t_enable<!xyu::t_is_same<xyu::t_remove_cvref<Fun>, Option>>>
+        explicit Fiber(Fun&& fun, Args&&... args)
+        { create(Option{}, xyu::forward<Fun>(fun), xyu::forward<Args>(args)...); }
+
+        /**
+         * @brief 以指定属性创建纤程，加入当前线程的调度器 (不立即执行)
+         * @exception E_Memory_Alloc 分配控制块或栈失败
+         */
+        template <typename Fun, typename... Args>
+        Fiber(const Option& op, Fun&& fun, Args&&... args)
+        { create(op, xyu::forward<Fun>(fun), xyu::forward<Args>(args)...); }
+
+        /// 析构 (等待纤程结束，忽略其异常)
+        ~Fiber() noexcept { release(); }
+
+        /* 移动 */
+        /// 移动构造
+        Fiber(Fiber&& other) noexcept : b{other.b} { other.b = nullptr; }
+        /// 移动赋值
+        Fiber& operator=(Fiber&& other) noexcept { xyu::swap(b, other.b); return *this; }
+
+        /* 纤程管理 */
+
+        /// 是否持有纤程
+        bool valid() const noexcept { return b != nullptr; }
+
+        /// 纤程是否已结束 (未持有纤程时返回 true)
+        bool done() const noexcept;
+
+        /**
+         * @brief 等待纤程结束，并释放句柄
+         * @details
+         *   在纤程中调用时挂起当前纤程；在纤程所在线程的纤程外调用时执行调度循环直到其结束；
+         *   在其他线程中调用时阻塞该线程。
+         * @exception ... 纤程抛出的异常
+         */
+        void join();
+
+        /**
+         * @brief 分离纤程 (纤程继续执行，结束后自动释放)
+         */
+        void detach() noexcept;
+
+    public:
+        /* 调度 */
+
+        /**
+         * @brief 在当前线程执行调度循环，直到当前线程的所有纤程结束
+         * @exception E_Logic_Invalid_Argument 在纤程中调用
+         * @note 没有可执行的纤程时，线程挂起等待其他线程的唤醒或睡眠到期
+         */
+        static void run();
+
+        /// 当前是否在纤程中执行
+        static bool in_fiber() noexcept;
+
+        /// 让出执行权 (纤程外调用时为线程让步)
+        static void yield() noexcept;
+
+        /**
+         * @brief 睡眠指定时间
+         * @note 纤程中挂起当前纤程 (不阻塞线程)，纤程外调用时为线程睡眠
+         */
+        template <typename T, T Scale>
+        static void sleep_for(const xyu::Duration<T, Scale>& dt)
+        {
+            if (XY_UNLIKELY(dt.count <= 0)) return;
+            sleep_help(xyu::Duration_ns{dt});
+        }
+
+    private:
+        // 创建纤程
+        template <typename Fun, typename... Args>
+        void create(const Option& op, Fun&& fun, Args&&... args)
+        {
+            static_assert(xyu::t_can_call<Fun, Args...>);
+            using Tp = xyu::Tuple<xyu::t_decay<Fun>, xyu::Tuple<xyu::t_decay<Args>...>>;
+            auto* p = xyu::alloc<Tp>(xyu::native_v, 1);
+            try { ::new (p) Tp{xyu::forward<Fun>(fun), {xyu::forward<Args>(args)...}}; }
+            catch (...) { xyu::dealloc<Tp>(xyu::native_v, p); throw; }
+            try { b = __::fiber_spawn(call_fun<Tp>, p, op.stack_size); }
+            catch (...) { p->~Tp(); xyu::dealloc<Tp>(xyu::native_v, p); throw; }
+        }
+
+        // 纤程入口 (执行完毕或抛出异常时释放参数)
+        template <typename Tp>
+        static void call_fun(void* arg)
+        {
+            auto& tp = *reinterpret_cast<Tp*>(arg);
+            struct Drop { Tp& tp; ~Drop() { tp.~Tp(); xyu::dealloc<Tp>(xyu::native_v, &tp); } } drop{tp};
+            tp.template get<1>().apply(tp.template get<0>());
+        }
+
+        // 释放句柄 (等待纤程结束)
+        void release() noexcept;
+        // 睡眠
+        static void sleep_help(xyu::Duration_ns dt);
+    };
+
+    /**
+     * @brief 纤程互斥锁 (纤程中等待时挂起纤程而不是阻塞线程)
+     *
+     * @details
+     *   未竞争时上锁与解锁均为一次 CAS；竞争时等待者进入 FIFO 队列，解锁时直接将锁移交给队首，
+     *   避免被唤醒的纤程重新竞争。纤程外的线程同样可以上锁 (挂起线程等待)。
+     *   使用方式同 Mutex：通过 `guard()` 获取锁卫。
+     */
+    class FiberMutex : xyu::class_no_copy_move_t
+    {
+        friend class FiberCondVar;
+    private:
+        xyu::Atomic<xyu::uint32> s{0};  // 锁状态 (0: 未上锁, 1: 已上锁, 2: 已上锁且有等待者)
+        __::FiberQueue q;               // 等待队列
+
+    public:
+        /// 互斥锁锁卫 (重复上锁或解锁时忽略)
+        struct Guard : xyu::class_no_copy_t
+        {
+            friend class FiberCondVar;
+        private:
+            FiberMutex& m;  // 互斥锁引用
+            bool own;       // 是否已上锁
+
+        public:
+            /// 构造函数 (默认上锁)
+            Guard(FiberMutex& m, bool need_lock = true) : m{m}, own{false} { if (need_lock) lock(); }
+            /// 析构函数 (自动解锁)
+            ~Guard() noexcept { if (own) unlock(); }
+
+            /// 移动构造
+            Guard(Guard&& other) noexcept : m{other.m}, own{other.own} { other.own = false; }
+
+            /// 判断是否已上锁
+            bool is_locked() const noexcept { return own; }
+
+            /// 上锁
+            void lock()
+            {
+                if (XY_UNLIKELY(own)) return;
+                if (XY_UNLIKELY(!m.s.compare_exchange_strong(0, 1, xyu::N_ATOMIC_ACQUIRE))) m.lock_help();
+                own = true;
+            }
+
+            /// 解锁
+            void unlock() noexcept
+            {
+                if (XY_UNLIKELY(!own)) return;
+                own = false;
+                if (XY_UNLIKELY(!m.s.compare_exchange_strong(1, 0, xyu::N_ATOMIC_RELEASE))) m.unlock_help();
+            }
+
+            /// 尝试上锁
+            bool trylock() noexcept
+            {
+                if (XY_UNLIKELY(own)) return true;
+                return own = m.s.compare_exchange_strong(0, 1, xyu::N_ATOMIC_ACQUIRE);
+            }
+        };
+
+        /// 默认构造
+        FiberMutex() noexcept = default;
+
+        /// 获取锁卫
+        [[nodiscard]] Guard guard(bool need_lock = true) { return {*this, need_lock}; }
+
+    private:
+        // 竞争时上锁 (进入等待队列)
+        void lock_help();
+        // 有等待者时解锁 (移交给队首)
+        void unlock_help() noexcept;
+    };
+
+    /**
+     * @brief 纤程条件变量 (纤程中等待时挂起纤程而不是阻塞线程)
+     * @note 与 FiberMutex 配合使用；等待者按 FIFO 顺序唤醒，不会虚假唤醒
+     */
+    class FiberCondVar : xyu::class_no_copy_move_t
+    {
+    private:
+        __::FiberQueue q;   // 等待队列
+
+    public:
+        /// 默认构造
+        FiberCondVar() noexcept = default;
+
+        /// 唤醒一个等待者
+        void notify_one() noexcept;
+        /// 唤醒所有等待者
+        void notify_all() noexcept;
+
+        /**
+         * @brief 等待通知 (等待期间释放锁，返回前重新上锁)
+         * @exception E_Logic_Invalid_Argument guard 未上锁
+         */
+        void wait(FiberMutex::Guard& guard);
+
+        /// 等待，直到条件满足
+        template <typename Condition>
+        void wait(FiberMutex::Guard& guard, Condition&& condition)
+        { while (!condition()) wait(guard); }
+    };
+}
+
+#endif
+
+#pragma clang diagnostic pop
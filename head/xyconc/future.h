@@ -0,0 +1,729 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/pool"
+#include "../../link/vector"
+
+/// 异步结果
+namespace xylu::xyconc
+{
+    template <typename T>
+    class Future;
+    template <typename T>
+    class Promise;
+
+    /// when_any 的结果
+    template <typename T>
+    struct Any_Result
+    {
+        xyu::size_t index;  ///< 最先完成的输入下标
+        T value;            ///< 该输入的结果
+    };
+
+    /**
+     * @brief 续体的执行位置
+     * @details
+     *   - 默认构造: 直接执行 (在完成结果的线程中执行；登记时结果已完成则在登记的线程中执行)。
+     *   - 由线程池构造: 提交到该线程池执行 (提交失败时退化为直接执行)。
+     */
+    class Executor
+    {
+    private:
+        ThreadPool* p = nullptr;    // 线程池 (nullptr 表示直接执行)
+
+    public:
+        /// 直接执行
+        constexpr Executor() noexcept = default;
+        /// 提交到线程池执行 (线程池需在续体执行前保持有效)
+        Executor(ThreadPool& pool) noexcept : p{&pool} {}
+
+        /// 获取线程池 (直接执行时为 nullptr)
+        ThreadPool* pool() const noexcept { return p; }
+    };
+
+    namespace __
+    {
+        // 续体 (结果完成时执行一次，执行函数负责释放自身)
+        struct FutureCont
+        {
+            void (*run)(FutureCont* self) noexcept; // 执行函数
+            ThreadPool* ex;                         // 执行位置 (nullptr 表示直接执行)
+        };
+
+        // 共享状态的类型无关部分
+        struct FutureCore
+        {
+            static constexpr xyu::uint32 Pending = 0;   // 未完成
+            static constexpr xyu::uint32 Attached = 1;  // 未完成且已登记续体
+            static constexpr xyu::uint32 Waited = 2;    // 未完成且有线程在等待
+            static constexpr xyu::uint32 Done = 3;      // 已完成
+
+            xyu::Atomic<xyu::uint32> st{Pending};   // 状态
+            xyu::Atomic<xyu::uint32> refs{1};       // 引用计数 (生产者与消费者各持有一个)
+            void (*dtor)(FutureCore*) noexcept;     // 析构结果并释放状态
+            FutureCont* cont = nullptr;             // 续体
+            bool failed = false;                    // 是否以异常完成
+            xyu::ErrorPtr ep;                       // 异常
+
+            explicit FutureCore(void (*dtor)(FutureCore*) noexcept) noexcept : dtor{dtor} {}
+
+            // 以异常完成
+            void fail(xyu::ErrorPtr&& e) noexcept { ep = xyu::move(e); failed = true; complete(); }
+            // 以当前捕获的异常完成
+            void fail_current() noexcept { fail(xyu::ErrorPtr::current()); }
+            // 设置为已完成，执行续体或唤醒等待者
+            void complete() noexcept;
+            // 登记续体 (已完成时立即执行)
+            void attach(FutureCont* k) noexcept;
+            // 挂起等待完成
+            void wait() noexcept;
+            // 是否已完成
+            bool done() const noexcept { return st.load(xyu::N_ATOMIC_ACQUIRE) == Done; }
+            // 增加引用
+            void retain() noexcept { refs.fetch_add(1, xyu::N_ATOMIC_RELAXED); }
+            // 释放引用 (最后一个引用释放状态)
+            void release() noexcept { if (refs.fetch_sub(1, xyu::N_ATOMIC_ACQ_REL) == 1) dtor(this); }
+        };
+
+        // 共享状态
+        template <typename T>
+        struct FutureState : FutureCore
+        {
+            alignas(T) xyu::uint8 data[sizeof(T)];  // 结果
+
+            FutureState() noexcept : FutureCore{destroy} {}
+
+            // 获取结果
+            T& value() noexcept { return *reinterpret_cast<T*>(data); }
+
+            // 构造结果并完成 (构造失败时状态不变)
+            template <typename... Args>
+            void set(Args&&... args)
+            {
+                ::new (data) T(xyu::forward<Args>(args)...);
+                complete();
+            }
+
+            // 分配状态
+            static FutureState* make()
+            { return ::new (xyu::alloc<FutureState>(xyu::native_v, 1)) FutureState{}; }
+
+            // 析构结果并释放状态
+            static void destroy(FutureCore* c) noexcept
+            {
+                auto s = static_cast<FutureState*>(c);
+                if (s->st.load(xyu::N_ATOMIC_RELAXED) == Done && !s->failed) s->value().~T();
+                s->~FutureState();
+                xyu::dealloc<FutureState>(xyu::native_v, s);
+            }
+        };
+
+        template <>
+        struct FutureState<void> : FutureCore
+        {
+            FutureState() noexcept : FutureCore{destroy} {}
+
+            void set() noexcept { complete(); }
+
+            static FutureState* make()
+            { return ::new (xyu::alloc<FutureState>(xyu::native_v, 1)) FutureState{}; }
+
+            static void destroy(FutureCore* c) noexcept
+            {
+                auto s = static_cast<FutureState*>(c);
+                s->~FutureState();
+                xyu::dealloc<FutureState>(xyu::native_v, s);
+            }
+        };
+
+        // 访问 Future 的共享状态
+        struct FutureAccess
+        {
+            // 取出共享状态 (句柄变为空)
+            template <typename T>
+            static FutureState<T>* take(Future<T>& f) noexcept { auto s = f.sp; f.sp = nullptr; return s; }
+            // 由共享状态构造句柄
+            template <typename T>
+            static Future<T> make(FutureState<T>* s) noexcept { return Future<T>{s}; }
+        };
+
+        // 续体返回 Future<U> 时展开为 U
+        template <typename R>
+        struct future_unwrap { using type = R; };
+        template <typename U>
+        struct future_unwrap<Future<U>> { using type = U; };
+        template <typename R>
+        using future_unwrap_t = typename future_unwrap<R>::type;
+
+        // 执行续体 (提交到线程池或直接执行)
+        void future_dispatch(FutureCont* k) noexcept;
+        // 将续体提交到线程池
+        void future_enqueue(ThreadPool& pool, FutureCont* k);
+        // 以 "未设置结果" 的异常完成 (Promise 未设置结果即析构)
+        void future_break(FutureCore* c) noexcept;
+        // 句柄为空时抛出异常
+        [[noreturn]] void future_no_state();
+        // when_any 没有输入时抛出异常
+        [[noreturn]] void future_no_input();
+
+        // 将上游的结果移动到下游，并释放两者的引用
+        template <typename T>
+        void future_pass(FutureState<T>* up, FutureState<T>* down) noexcept
+        {
+            if (up->failed) down->fail(xyu::move(up->ep));
+            else if constexpr (xyu::t_is_void<T>) down->set();
+            else {
+                try { down->set(xyu::move(up->value())); }
+                catch (...) { down->fail_current(); }
+            }
+            up->release();
+            down->release();
+        }
+
+        // 续体返回 Future 时，等待其完成后转交结果
+        template <typename T>
+        struct FutureFwd : FutureCont
+        {
+            FutureState<T>* up;     // 续体返回的结果
+            FutureState<T>* down;   // 下游
+
+            static void exec(FutureCont* self) noexcept
+            {
+                auto k = static_cast<FutureFwd*>(self);
+                FutureState<T>* up = k->up;
+                FutureState<T>* down = k->down;
+                xyu::dealloc<FutureFwd>(xyu::native_v, k);
+                future_pass(up, down);
+            }
+        };
+
+        // 调用 g() 并以其返回值完成下游 (异常同样传递到下游)，不释放下游的引用
+        template <typename U, typename G>
+        void future_call(FutureState<U>* down, G&& g) noexcept
+        {
+            using R = xyu::t_remove_cvref<decltype(g())>;
+            try {
+                if constexpr (xyu::t_is_void<R>) { g(); down->set(); }
+                else if constexpr (xyu::t_is_same<R, Future<U>>) {
+                    R inner = g();
+                    auto k = xyu::alloc<FutureFwd<U>>(xyu::native_v, 1);
+                    FutureState<U>* up = FutureAccess::take(inner);
+                    if (XY_UNLIKELY(!up)) { xyu::dealloc<FutureFwd<U>>(xyu::native_v, k); future_no_state(); }
+                    down->retain();
+                    ::new (k) FutureFwd<U>{{FutureFwd<U>::exec, nullptr}, up, down};
+                    up->attach(k);
+                }
+                else down->set(g());
+            }
+            catch (...) { down->fail_current(); }
+        }
+
+        // then 的续体
+        template <typename T, typename F>
+        struct FutureThen : FutureCont
+        {
+            using R = decltype(xyu::t_val<F&>()(xyu::t_val<T&&>()));
+            using U = future_unwrap_t<xyu::t_remove_cvref<R>>;
+
+            FutureState<T>* up;     // 上游
+            FutureState<U>* down;   // 下游
+            F f;                    // 续体函数
+
+            static void exec(FutureCont* self) noexcept
+            {
+                auto k = static_cast<FutureThen*>(self);
+                if (k->up->failed) k->down->fail(xyu::move(k->up->ep));
+                else future_call(k->down, [k]() -> decltype(auto) { return k->f(xyu::move(k->up->value())); });
+                k->up->release();
+                k->down->release();
+                k->~FutureThen();
+                xyu::dealloc<FutureThen>(xyu::native_v, k);
+            }
+        };
+
+        template <typename F>
+        struct FutureThen<void, F> : FutureCont
+        {
+            using R = decltype(xyu::t_val<F&>()());
+            using U = future_unwrap_t<xyu::t_remove_cvref<R>>;
+
+            FutureState<void>* up;
+            FutureState<U>* down;
+            F f;
+
+            static void exec(FutureCont* self) noexcept
+            {
+                auto k = static_cast<FutureThen*>(self);
+                if (k->up->failed) k->down->fail(xyu::move(k->up->ep));
+                else future_call(k->down, [k]() -> decltype(auto) { return k->f(); });
+                k->up->release();
+                k->down->release();
+                k->~FutureThen();
+                xyu::dealloc<FutureThen>(xyu::native_v, k);
+            }
+        };
+
+        // async 的任务
+        template <typename F, typename... Args>
+        struct FutureTask : FutureCont
+        {
+            using R = decltype(xyu::t_val<F&>()(xyu::t_val<Args&>()...));
+            using U = future_unwrap_t<xyu::t_remove_cvref<R>>;
+
+            FutureState<U>* down;       // 结果
+            F f;                        // 任务函数
+            xyu::Tuple<Args...> args;   // 任务参数
+
+            static void exec(FutureCont* self) noexcept
+            {
+                auto k = static_cast<FutureTask*>(self);
+                future_call(k->down, [k]() -> decltype(auto) { return k->args.apply(k->f); });
+                k->down->release();
+                k->~FutureTask();
+                xyu::dealloc<FutureTask>(xyu::native_v, k);
+            }
+        };
+
+        // when_all 的汇合点
+        template <typename T>
+        struct FutureAll
+        {
+            using R = xyu::t_cond<xyu::t_is_void<T>, void, xyu::Vector<T>>;
+
+            // 每个输入的续体
+            struct Slot : FutureCont
+            {
+                FutureAll* all;         // 汇合点
+                FutureState<T>* up;     // 输入
+            };
+
+            xyu::Atomic<xyu::size_t> left;  // 未完成的输入数量
+            xyu::Atomic<bool> err{false};   // 是否已有输入失败
+            xyu::ErrorPtr ep;               // 最先失败的输入的异常
+            FutureState<R>* down;           // 结果
+            Slot* slots;                    // 续体数组
+            xyu::size_t n;                  // 输入数量
+
+            static void exec(FutureCont* self) noexcept
+            {
+                auto s = static_cast<Slot*>(self);
+                FutureAll* a = s->all;
+                if (s->up->failed && !a->err.exchange(true, xyu::N_ATOMIC_RELAXED)) a->ep = xyu::move(s->up->ep);
+                if (a->left.fetch_sub(1, xyu::N_ATOMIC_ACQ_REL) == 1) a->finish();
+            }
+
+            // 所有输入完成后汇总结果，并释放汇合点
+            void finish() noexcept
+            {
+                if (err.load(xyu::N_ATOMIC_RELAXED)) down->fail(xyu::move(ep));
+                else if constexpr (xyu::t_is_void<T>) down->set();
+                else {
+                    try {
+                        R v(n);
+                        for (xyu::size_t i = 0; i < n; ++i) v.append(xyu::move(slots[i].up->value()));
+                        down->set(xyu::move(v));
+                    }
+                    catch (...) { down->fail_current(); }
+                }
+                down->release();
+                for (xyu::size_t i = 0; i < n; ++i) slots[i].up->release();
+                xyu::dealloc<Slot>(xyu::native_v, slots, n);
+                this->~FutureAll();
+                xyu::dealloc<FutureAll>(xyu::native_v, this);
+            }
+        };
+
+        // when_any 的汇合点
+        template <typename T>
+        struct FutureAny
+        {
+            using R = xyu::t_cond<xyu::t_is_void<T>, xyu::size_t, Any_Result<T>>;
+
+            struct Slot : FutureCont
+            {
+                FutureAny* any;         // 汇合点
+                FutureState<T>* up;     // 输入
+                xyu::size_t idx;        // 输入下标
+            };
+
+            xyu::Atomic<xyu::size_t> left;  // 未完成的输入数量
+            xyu::Atomic<bool> fired{false}; // 结果是否已设置
+            FutureState<R>* down;           // 结果
+            Slot* slots;                    // 续体数组
+            xyu::size_t n;                  // 输入数量
+
+            static void exec(FutureCont* self) noexcept
+            {
+                auto s = static_cast<Slot*>(self);
+                FutureAny* a = s->any;
+                // 最先完成的输入设置结果
+                if (!a->fired.exchange(true, xyu::N_ATOMIC_RELAXED)) {
+                    if (s->up->failed) a->down->fail(xyu::move(s->up->ep));
+                    else if constexpr (xyu::t_is_void<T>) a->down->set(s->idx);
+                    else {
+                        try { a->down->set(R{s->idx, xyu::move(s->up->value())}); }
+                        catch (...) { a->down->fail_current(); }
+                    }
+                    a->down->release();
+                }
+                s->up->release();
+                // 最后完成的输入释放汇合点
+                if (a->left.fetch_sub(1, xyu::N_ATOMIC_ACQ_REL) == 1) {
+                    xyu::dealloc<Slot>(xyu::native_v, a->slots, a->n);
+                    a->~FutureAny();
+                    xyu::dealloc<FutureAny>(xyu::native_v, a);
+                }
+            }
+        };
+    }
+
+    /**
+     * @brief 异步结果的句柄，可以在结果完成时执行续体，而不需要阻塞等待。
+     *
+     * @details
+     *   `Future` 由 `Promise::get_future`、`async`、`then`、`when_all`、`when_any` 等生成，
+     *   与生产者共享一个引用计数的状态块，结果 (返回值或异常) 由生产者写入一次。
+     *
+     *   ### 续体:
+     *   - `then(fun, ex)`: 结果完成时在执行位置 ex 上调用 fun(value) (void 时为 fun())，返回其结果的 Future。
+     *     fun 返回 `Future<U>` 时展开为 `Future<U>`，可以串联异步操作。
+     *   - 结果为异常时不调用 fun，异常 (ErrorPtr) 直接传递到返回的 Future；fun 抛出的异常同样传递。
+     *   - 登记与完成通过一次原子操作决出先后，不使用锁，不阻塞任何线程。
+     *
+     *   ### 汇合:
+     *   - `when_all`: 所有输入完成后完成，结果为按输入顺序排列的 Vector (void 时无结果)；
+     *     任何输入失败时，以最先失败的输入的异常完成 (仍等待所有输入完成)。
+     *   - `when_any`: 最先完成的输入完成时完成，结果为其下标与值 (void 时仅为下标)；
+     *     最先完成的输入失败时，以其异常完成。其余输入在完成时释放。
+     *
+     * @tparam T 结果类型 (可以为 void，不能为引用)
+     * @note 句柄只能移动。then/get/when_all/when_any 会消耗句柄，之后句柄为空。
+     * @note 直接执行的续体在完成结果的线程中执行，长链的续体会在该线程中依次执行，耗时的续体应提交到线程池。
+     *
+     * @example
+     *   xyu::ThreadPool pool;
+     *   auto a = xyu::async(pool, load, "a.txt");
+     *   auto b = xyu::async(pool, load, "b.txt");
+     *   auto n = xyu::when_all(a, b).then([](xyu::Vector<xyu::String> v) { return merge(v); }, pool);
+     *   auto r = n.get();   // 仅在最终需要结果的位置阻塞
+     */
+    template <typename T>
+    class Future : xyu::class_no_copy_t
+    {
+        static_assert(!xyu::t_is_refer<T>, "result of Future cannot be a reference");
+        friend struct __::FutureAccess;
+
+    private:
+        __::FutureState<T>* sp = nullptr;   // 共享状态
+
+        // 由共享状态构造
+        explicit Future(__::FutureState<T>* s) noexcept : sp{s} {}
+
+    public:
+        /* 构造析构 */
+        /// 空句柄
+        Future() noexcept = default;
+        /// 释放共享状态 (不等待结果)
+        ~Future() noexcept { if (sp) sp->release(); }
+
+        /* 移动 */
+        /// 移动构造
+        Future(Future&& other) noexcept : sp{other.sp} { other.sp = nullptr; }
+        /// 移动赋值
+        Future& operator=(Future&& other) noexcept { xyu::swap(sp, other.sp); return *this; }
+
+        /* 状态 */
+        /// 是否持有共享状态
+        bool valid() const noexcept { return sp != nullptr; }
+        /// 结果是否已完成
+        bool ready() const noexcept { return sp && sp->done(); }
+
+        /* 获取结果 */
+
+        /**
+         * @brief 阻塞等待结果完成
+         * @note 等待者挂起，直到结果完成时被唤醒，不进行轮询。
+         */
+        void wait() noexcept { if (sp && !sp->done()) sp->wait(); }
+
+        /**
+         * @brief 阻塞等待结果完成，并移动出结果 (之后句柄为空)
+         * @exception E_Thread_Invalid_State 句柄为空
+         * @exception ... 结果为异常时重新抛出该异常
+         */
+        T get()
+        {
+            if (XY_UNLIKELY(!sp)) __::future_no_state();
+            wait();
+            struct Release { __::FutureState<T>* s; ~Release() { s->release(); } } r{sp};
+            sp = nullptr;
+            if (r.s->failed) { xyu::ErrorPtr e = xyu::move(r.s->ep); e.rethrow(); }
+            if constexpr (xyu::t_is_void<T>) return;
+            else return xyu::move(r.s->value());
+        }
+
+        /* 续体 */
+
+        /**
+         * @brief 结果完成时在执行位置 ex 上调用 fun(value)，消耗句柄
+         * @param fun 续体函数，参数为结果的右值 (void 时无参数)
+         * @param ex 执行位置 (默认直接执行，可传入线程池)
+         * @return 续体结果的 Future (fun 返回 Future<U> 时为 Future<U>)
+         * @exception E_Thread_Invalid_State 句柄为空
+         * @exception E_Memory_Alloc (此时句柄不变)
+         */
+        template <typename Fun>
+        auto then(Fun&& fun, Executor ex = {})
+        {
+            using K = __::FutureThen<T, xyu::t_decay<Fun>>;
+            using U = typename K::U;
+            if (XY_UNLIKELY(!sp)) __::future_no_state();
+            auto down = __::FutureState<U>::make();
+            K* k;
+            try {
+                k = xyu::alloc<K>(xyu::native_v, 1);
+                try { ::new (k) K{{K::exec, ex.pool()}, sp, down, xyu::forward<Fun>(fun)}; }
+                catch (...) { xyu::dealloc<K>(xyu::native_v, k); throw; }
+            }
+            catch (...) { down->dtor(down); throw; }
+            down->retain();
+            sp->attach(k);
+            sp = nullptr;
+            return __::FutureAccess::make(down);
+        }
+    };
+
+    /**
+     * @brief 异步结果的生产者，向对应的 Future 写入一次结果。
+     * @note 未设置结果即析构时，Future 以 E_Thread_Invalid_State 异常完成。
+     *
+     * @example
+     *   xyu::Promise<int> p;
+     *   auto f = p.get_future().then([](int v) { return v * 2; });
+     *   p.set_value(21);    // 在此线程中执行续体
+     */
+    template <typename T>
+    class Promise : xyu::class_no_copy_t
+    {
+        static_assert(!xyu::t_is_refer<T>, "result of Promise cannot be a reference");
+
+    private:
+        __::FutureState<T>* sp;     // 共享状态 (设置结果后为 nullptr)
+        bool taken = false;         // 是否已获取 Future
+
+    public:
+        /* 构造析构 */
+        /**
+         * @brief 创建 (分配共享状态)
+         * @exception E_Memory_Alloc
+         */
+        Promise() : sp{__::FutureState<T>::make()} {}
+        /// 析构 (未设置结果时以异常完成)
+        ~Promise() noexcept { if (sp) __::future_break(sp); }
+
+        /* 移动 */
+        /// 移动构造
+        Promise(Promise&& other) noexcept : sp{other.sp}, taken{other.taken} { other.sp = nullptr; }
+        /// 移动赋值
+        Promise& operator=(Promise&& other) noexcept { xyu::swap(sp, other.sp); xyu::swap(taken, other.taken); return *this; }
+
+        /* 操作 */
+
+        /**
+         * @brief 获取对应的 Future (只能获取一次)
+         * @exception E_Thread_Invalid_State 已获取或已设置结果
+         */
+        Future<T> get_future()
+        {
+            if (XY_UNLIKELY(!sp || taken)) __::future_no_state();
+            taken = true;
+            sp->retain();
+            return __::FutureAccess::make(sp);
+        }
+
+        /**
+         * @brief 设置结果 (由 args 构造)，执行直接执行的续体或唤醒等待者
+         * @exception E_Thread_Invalid_State 已设置结果
+         * @exception ... 构造结果时的异常 (此时结果仍未设置)
+         */
+        template <typename... Args>
+        void set_value(Args&&... args)
+        {
+            if (XY_UNLIKELY(!sp)) __::future_no_state();
+            sp->set(xyu::forward<Args>(args)...);
+            sp->release();
+            sp = nullptr;
+        }
+
+        /**
+         * @brief 以异常设置结果
+         * @exception E_Thread_Invalid_State 已设置结果
+         */
+        void set_error(xyu::ErrorPtr e)
+        {
+            if (XY_UNLIKELY(!sp)) __::future_no_state();
+            sp->fail(xyu::move(e));
+            sp->release();
+            sp = nullptr;
+        }
+    };
+
+    /// 生成已完成的 Future
+    template <typename T>
+    Future<xyu::t_decay<T>> make_ready_future(T&& value)
+    {
+        Promise<xyu::t_decay<T>> p;
+        auto f = p.get_future();
+        p.set_value(xyu::forward<T>(value));
+        return f;
+    }
+
+    /// 生成已完成的 Future<void>
+    inline Future<void> make_ready_future()
+    {
+        Promise<void> p;
+        auto f = p.get_future();
+        p.set_value();
+        return f;
+    }
+
+    /// 生成以异常完成的 Future
+    template <typename T>
+    Future<T> make_error_future(xyu::ErrorPtr e)
+    {
+        Promise<T> p;
+        auto f = p.get_future();
+        p.set_error(xyu::move(e));
+        return f;
+    }
+
+    /**
+     * @brief 在线程池中执行 fun(args...)，返回其结果的 Future
+     * @note 与 `ThreadPool::submit` 不同，结果可以通过 then 串联，不需要阻塞等待。
+     * @note fun 返回 Future<U> 时展开为 Future<U>。
+     * @exception E_Memory_Alloc, E_Mutex_* 提交队列已满，挂起等待时出错
+     */
+    template <typename Fun, typename... Args>
+    auto async(ThreadPool& pool, Fun&& fun, Args&&... args)
+    {
+        using K = __::FutureTask<xyu::t_decay<Fun>, xyu::t_decay<Args>...>;
+        using U = typename K::U;
+        auto down = __::FutureState<U>::make();
+        K* k;
+        try {
+            k = xyu::alloc<K>(xyu::native_v, 1);
+            try { ::new (k) K{{K::exec, &pool}, down, xyu::forward<Fun>(fun), {xyu::forward<Args>(args)...}}; }
+            catch (...) { xyu::dealloc<K>(xyu::native_v, k); throw; }
+        }
+        catch (...) { down->dtor(down); throw; }
+        // 任务可能在提交后立即完成并释放其引用
+        down->retain();
+        try { __::future_enqueue(pool, k); }
+        catch (...) { k->~K(); xyu::dealloc<K>(xyu::native_v, k); down->dtor(down); throw; }
+        return __::FutureAccess::make(down);
+    }
+
+    /**
+     * @brief 所有输入完成后完成，消耗所有输入
+     * @param fs 输入数组
+     * @param n 输入数量 (为 0 时返回已完成的结果)
+     * @return 按输入顺序排列的结果 (T 为 void 时为 Future<void>)
+     * @exception E_Thread_Invalid_State 存在空句柄 (此时输入均不变)
+     * @exception E_Memory_Alloc (此时输入均不变)
+     */
+    template <typename T>
+    auto when_all(Future<T>* fs, xyu::size_t n)
+    {
+        using A = __::FutureAll<T>;
+        using R = typename A::R;
+        for (xyu::size_t i = 0; i < n; ++i)
+            if (XY_UNLIKELY(!fs[i].valid())) __::future_no_state();
+        auto down = __::FutureState<R>::make();
+        down->retain();
+        if (n == 0) {
+            if constexpr (xyu::t_is_void<T>) down->set();
+            else down->set(R{});
+            down->release();
+            return __::FutureAccess::make(down);
+        }
+        A* a;
+        try {
+            a = xyu::alloc<A>(xyu::native_v, 1);
+            try { ::new (a) A{{n}, {false}, {}, down, xyu::alloc<typename A::Slot>(xyu::native_v, n), n}; }
+            catch (...) { xyu::dealloc<A>(xyu::native_v, a); throw; }
+        }
+        catch (...) { down->dtor(down); throw; }
+        // 全部登记前不能完成汇合 (最后完成的输入会释放汇合点)
+        for (xyu::size_t i = 0; i < n; ++i)
+            ::new (a->slots + i) typename A::Slot{{A::exec, nullptr}, a, __::FutureAccess::take(fs[i])};
+        for (xyu::size_t i = 0; i < n; ++i) a->slots[i].up->attach(a->slots + i);
+        return __::FutureAccess::make(down);
+    }
+
+    /// 所有输入完成后完成 (xyu::when_all(a, b, c))
+    template <typename T, typename... Ts>
+    auto when_all(Future<T>& first, Future<Ts>&... rest)
+    {
+        static_assert((... && xyu::t_is_same<T, Ts>), "inputs of when_all must have the same result type");
+        Future<T> fs[] = {xyu::move(first), xyu::move(rest)...};
+        try { return when_all(fs, 1 + sizeof...(Ts)); }
+        catch (...) {
+            // 失败时归还输入
+            first = xyu::move(fs[0]);
+            xyu::size_t i = 1;
+            (..., (rest = xyu::move(fs[i++])));
+            throw;
+        }
+    }
+
+    /**
+     * @brief 最先完成的输入完成时完成，消耗所有输入
+     * @param fs 输入数组
+     * @param n 输入数量
+     * @return 最先完成的输入下标与结果 (T 为 void 时为 Future<size_t>，仅有下标)
+     * @exception E_Logic_Invalid_Argument 没有输入
+     * @exception E_Thread_Invalid_State 存在空句柄 (此时输入均不变)
+     * @exception E_Memory_Alloc (此时输入均不变)
+     */
+    template <typename T>
+    auto when_any(Future<T>* fs, xyu::size_t n)
+    {
+        using A = __::FutureAny<T>;
+        using R = typename A::R;
+        if (XY_UNLIKELY(n == 0)) __::future_no_input();
+        for (xyu::size_t i = 0; i < n; ++i)
+            if (XY_UNLIKELY(!fs[i].valid())) __::future_no_state();
+        auto down = __::FutureState<R>::make();
+        A* a;
+        try {
+            a = xyu::alloc<A>(xyu::native_v, 1);
+            try { ::new (a) A{{n}, {false}, down, xyu::alloc<typename A::Slot>(xyu::native_v, n), n}; }
+            catch (...) { xyu::dealloc<A>(xyu::native_v, a); throw; }
+        }
+        catch (...) { down->dtor(down); throw; }
+        down->retain();
+        for (xyu::size_t i = 0; i < n; ++i)
+            ::new (a->slots + i) typename A::Slot{{A::exec, nullptr}, a, __::FutureAccess::take(fs[i]), i};
+        for (xyu::size_t i = 0; i < n; ++i) a->slots[i].up->attach(a->slots + i);
+        return __::FutureAccess::make(down);
+    }
+
+    /// 最先完成的输入完成时完成 (xyu::when_any(a, b, c))
+    template <typename T, typename... Ts>
+    auto when_any(Future<T>& first, Future<Ts>&... rest)
+    {
+        static_assert((... && xyu::t_is_same<T, Ts>), "inputs of when_any must have the same result type");
+        Future<T> fs[] = {xyu::move(first), xyu::move(rest)...};
+        try { return when_any(fs, 1 + sizeof...(Ts)); }
+        catch (...) {
+            first = xyu::move(fs[0]);
+            xyu::size_t i = 1;
+            (..., (rest = xyu::move(fs[i++])));
+            throw;
+        }
+    }
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,122 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/atomic"
+#include "../../link/string"
+#include "../../link/file"
+
+/// 锁竞争分析
+namespace xylu::xyconc
+{
+    namespace __
+    {
+        // 是否正在记录
+        inline xyu::Atomic<bool> lock_profile_on{false};
+
+        // 记录一次竞争上锁 (lock: 锁地址, rw: 是否为读写锁, read: 是否为读锁, wait_ns: 等待时间, site: 调用位置)
+        void lock_profile_wait(const void* lock, bool rw, bool read, xyu::int64 wait_ns, const void* site) noexcept;
+        // 记录竞争上锁后的持有时间
+        void lock_profile_hold(const void* lock, xyu::int64 hold_ns) noexcept;
+    }
+
+    /**
+     * @brief 锁竞争分析器，统计 Mutex 与 Mutex_RW 的竞争情况，找出热点锁。
+     *
+     * @details
+     *   需要在编译期开启 XY_LOCK_PROFILE，并在运行时调用 `enable()` 开始记录。
+     *   上锁时先尝试无等待地获取锁，成功时不做任何记录；失败 (发生竞争) 且正在记录时，
+     *   记录等待时间、调用位置 (上锁函数的返回地址)，并在解锁时记录本次的持有时间。
+     *
+     *   每个锁按地址对应一个统计项，包含竞争次数、等待与持有时间的总和与最大值、
+     *   以 2 的幂划分的时间分布 (第 i 个桶为 [2^(i-1), 2^i) 纳秒)，以及竞争最多的调用位置。
+     *
+     *   ### 代价:
+     *   - 未开启 XY_LOCK_PROFILE: 锁的实现与未加入分析器时完全相同。
+     *   - 已开启但未竞争: 与原来相同的一次尝试上锁，不读取开关，不计时。
+     *   - 竞争时: 两次读取时钟，以及对统计项的若干次原子加。
+     *
+     * @note 最多统计 K_capacity 个锁，超出的锁只计入 `dropped()`。
+     * @note 锁销毁后地址被复用时，新锁的统计并入旧的统计项。
+     * @note 通过 CondVar 等待时锁会被临时释放，此时的持有时间包含等待条件的时间。
+     * @note 调用位置为地址，可用 `addr2line -f -e <程序> <地址>` 转换 (需减去加载基址)。
+     *
+     * @example
+     *   xyu::LockProfiler::enable();
+     *   run_workload();
+     *   xyu::LockProfiler::dump(xyu::File{"locks.txt", xyu::File::TRUNC}, 5);
+     */
+    class LockProfiler : xyu::class_no_construct_t
+    {
+    public:
+        /// 是否已编译分析器 (XY_LOCK_PROFILE)
+        static constexpr bool K_available = XY_LOCK_PROFILE;
+        /// 最多统计的锁数量
+        static constexpr xyu::size_t K_capacity = 256;
+        /// 时间分布的桶数量 (最后一个桶包含所有更长的时间)
+        static constexpr xyu::size_t K_buckets = 32;
+        /// 每个锁记录的调用位置数量
+        static constexpr xyu::size_t K_sites = 4;
+
+        /// 一个锁的统计快照
+        struct Stat
+        {
+            const void* lock;                   ///< 锁地址
+            bool rw;                            ///< 是否为读写锁
+            xyu::uint64 contended;              ///< 竞争上锁次数
+            xyu::uint64 reads;                  ///< 其中读锁的次数
+            xyu::uint64 wait_sum;               ///< 等待时间总和 (纳秒)
+            xyu::uint64 wait_max;               ///< 最长等待时间 (纳秒)
+            xyu::uint64 hold_sum;               ///< 持有时间总和 (纳秒)
+            xyu::uint64 hold_max;               ///< 最长持有时间 (纳秒)
+            xyu::uint64 wait[K_buckets];        ///< 等待时间分布
+            xyu::uint64 hold[K_buckets];        ///< 持有时间分布
+            const void* sites[K_sites];         ///< 调用位置 (按竞争次数降序，空位为 nullptr)
+            xyu::uint64 site_counts[K_sites];   ///< 调用位置的竞争次数
+
+            /// 获取分布中第 q (0~1) 分位所在桶的上界 (纳秒)
+            static xyu::uint64 quantile(const xyu::uint64 (&h)[K_buckets], double q) noexcept;
+        };
+
+        /**
+         * @brief 开始记录 (首次调用时分配统计表)
+         * @return 是否已编译分析器 (未编译时忽略)
+         * @exception E_Memory_Alloc 分配统计表失败
+         */
+        static bool enable();
+
+        /// 停止记录 (已有的统计保留)
+        static void disable() noexcept { __::lock_profile_on.store(false, xyu::N_ATOMIC_RELAXED); }
+
+        /// 是否正在记录
+        static bool enabled() noexcept { return __::lock_profile_on.load(xyu::N_ATOMIC_RELAXED); }
+
+        /// 清空统计 (已统计的锁仍占用统计项)
+        static void reset() noexcept;
+
+        /// 统计表已满而未记录的竞争次数
+        static xyu::uint64 dropped() noexcept;
+
+        /**
+         * @brief 获取等待时间总和最多的 n 个锁
+         * @param out 输出数组 (至少 n 个元素)
+         * @return 实际输出的数量 (按等待时间总和降序)
+         */
+        static xyu::size_t top(Stat* out, xyu::size_t n) noexcept;
+
+        /**
+         * @brief 生成等待时间总和最多的 n 个锁的文本报告
+         * @exception E_Memory_Alloc
+         */
+        static xyu::String report(xyu::size_t n = 10);
+
+        /**
+         * @brief 将报告写入文件
+         * @exception E_Memory_Alloc, E_File_*
+         */
+        static void dump(const xyu::File& file, xyu::size_t n = 10) { file.write(report(n)); }
+    };
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,309 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/initlist"
+#include "../../link/atomic"
+#include "../../link/mutex"
+#include "../../link/string"
+#include "../../link/file"
+
+/// 指标
+namespace xylu::xyconc
+{
+    namespace __
+    {
+        // 独占缓存行的计数单元
+        struct alignas(xyu::K_CACHE_LINE_SIZE) MetricCell
+        {
+            xyu::Atomic<xyu::uint64> v{0};
+        };
+
+        // 未分配分片下标
+        constexpr xyu::size_t K_metric_unset = static_cast<xyu::size_t>(-1);
+        // 当前线程的分片下标
+        inline thread_local xyu::size_t tl_metric_shard = K_metric_unset;
+
+        // 为当前线程分配分片下标 (按线程创建顺序轮流分配)
+        xyu::size_t metric_shard_assign() noexcept;
+
+        // 当前线程的分片下标
+        inline xyu::size_t metric_shard() noexcept
+        {
+            xyu::size_t s = tl_metric_shard;
+            if (XY_UNLIKELY(s == K_metric_unset)) s = metric_shard_assign();
+            return s;
+        }
+    }
+
+    /**
+     * @brief 分片计数器，用于在多个线程的热路径上统计事件数量。
+     *
+     * @details
+     *   计数器由多个独占缓存行的单元组成，每个线程固定使用其中一个 (按线程轮流分配)，
+     *   因此写入仅为一次对本线程单元的原子加，不会在线程间来回传递缓存行。
+     *   读取时累加所有单元。
+     *
+     * @note 读取与写入并发时，结果为某个中间时刻的近似值 (单调计数时不会小于之前的读取)。
+     */
+    class Counter : xyu::class_no_copy_move_t
+    {
+    private:
+        __::MetricCell* c;  // 单元数组
+        xyu::size_t mask;   // 单元数量 - 1
+
+    public:
+        /// 创建计数器
+        Counter();
+        /// 析构
+        ~Counter() noexcept;
+
+        /// 增加 v
+        void add(xyu::uint64 v = 1) noexcept { c[__::metric_shard() & mask].v.fetch_add(v, xyu::N_ATOMIC_RELAXED); }
+        /// 增加 1
+        Counter& operator++() noexcept { add(1); return *this; }
+        /// 增加 v
+        Counter& operator+=(xyu::uint64 v) noexcept { add(v); return *this; }
+
+        /// 获取总数
+        xyu::uint64 value() const noexcept;
+        /// 清零
+        void reset() noexcept;
+    };
+
+    /**
+     * @brief 计量器，记录可增可减的当前值 (如队列长度、连接数)。
+     */
+    class Gauge : xyu::class_no_copy_move_t
+    {
+    private:
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::int64> v{0};  // 当前值
+
+    public:
+        /// 默认构造
+        Gauge() noexcept = default;
+
+        /// 设置值
+        void set(xyu::int64 x) noexcept { v.store(x, xyu::N_ATOMIC_RELAXED); }
+        /// 增加 x
+        void add(xyu::int64 x = 1) noexcept { v.fetch_add(x, xyu::N_ATOMIC_RELAXED); }
+        /// 减少 x
+        void sub(xyu::int64 x = 1) noexcept { v.fetch_sub(x, xyu::N_ATOMIC_RELAXED); }
+        /// 获取当前值
+        xyu::int64 value() const noexcept { return v.load(xyu::N_ATOMIC_RELAXED); }
+    };
+
+    /**
+     * @brief 固定桶直方图，统计数值的分布 (如延迟)。
+     *
+     * @details
+     *   桶由构造时给定的严格递增的上界决定：值 x 落入第一个满足 `x <= bound(i)` 的桶，
+     *   大于所有上界的值落入最后一个桶 (+Inf)。
+     *   与 Counter 相同，每个线程写入自己的分片 (桶计数与总和位于同一分片的连续缓存行中)。
+     */
+    class Histogram : xyu::class_no_copy_move_t
+    {
+    private:
+        xyu::int64* bs;                 // 桶上界
+        xyu::size_t nb;                 // 上界数量 (桶数量为 nb + 1)
+        xyu::Atomic<xyu::uint64>* c;    // 分片数组 (每个分片 nb + 1 个桶计数与 1 个总和)
+        xyu::size_t stride;             // 分片的长度 (对齐到缓存行)
+        xyu::size_t mask;               // 分片数量 - 1
+
+    public:
+        /**
+         * @brief 创建直方图
+         * @param bounds 桶上界 (严格递增，可以为空)
+         * @exception E_Logic_Invalid_Argument 上界不是严格递增
+         */
+        Histogram(const xyu::int64* bounds, xyu::size_t count);
+        /// 创建直方图
+        Histogram(std::initializer_list<xyu::int64> bounds) : Histogram{bounds.begin(), bounds.size()} {}
+        /// 析构
+        ~Histogram() noexcept;
+
+        /// 记录一个值
+        void observe(xyu::int64 x) noexcept
+        {
+            xyu::size_t lo = 0, hi = nb;
+            while (lo < hi) {
+                xyu::size_t mid = (lo + hi) / 2;
+                if (bs[mid] < x) lo = mid + 1;
+                else hi = mid;
+            }
+            xyu::Atomic<xyu::uint64>* s = c + (__::metric_shard() & mask) * stride;
+            s[lo].fetch_add(1, xyu::N_ATOMIC_RELAXED);
+            s[nb + 1].fetch_add(static_cast<xyu::uint64>(x), xyu::N_ATOMIC_RELAXED);
+        }
+
+        /// 获取桶数量 (包括最后的 +Inf 桶)
+        xyu::size_t buckets() const noexcept { return nb + 1; }
+        /// 获取第 i 个桶的上界 (i < buckets() - 1)
+        xyu::int64 bound(xyu::size_t i) const noexcept { return bs[i]; }
+        /// 获取第 i 个桶的计数 (不累计之前的桶)
+        xyu::uint64 bucket(xyu::size_t i) const noexcept;
+        /// 获取记录的数量
+        xyu::uint64 count() const noexcept;
+        /// 获取记录的值的总和
+        xyu::int64 sum() const noexcept;
+        /// 清零
+        void reset() noexcept;
+    };
+
+    /**
+     * @brief 指标注册表，按名称管理指标，并导出快照。
+     *
+     * @details
+     *   通过 `counter`/`gauge`/`histogram` 按名称获取指标 (不存在时创建)，指标的地址在注册表析构前不变。
+     *   注册使用互斥锁且按名称线性查找，热路径上应缓存返回的引用。
+     *
+     *   ### 导出:
+     *   注册表可以直接格式化 (`xyfmt("{}", reg)`) 或写入文件 (`reg.write_to(file)` / `file << reg`)，
+     *   输出为 Prometheus 文本格式，每行一个值：
+     *   - 计数器与计量器: `name value`
+     *   - 直方图: `name_bucket{le="bound"} 累计计数`、`name_sum 总和`、`name_count 数量`
+     *
+     * @example
+     *   auto& reqs = xyu::MetricRegistry::global().counter("http_requests_total");
+     *   auto& lat = xyu::MetricRegistry::global().histogram("http_latency_us", {100, 1000, 10000});
+     *   ++reqs; lat.observe(350);
+     *   xyu::File{"metrics.txt", xyu::File::TRUNC} << xyu::MetricRegistry::global();
+     */
+    class MetricRegistry : xyu::class_no_copy_move_t
+    {
+    public:
+        /// 注册项 (counter/gauge/histogram 中恰有一个非空)
+        struct Entry
+        {
+            xyu::String name;                   ///< 名称
+            Counter* counter = nullptr;         ///< 计数器
+            Gauge* gauge = nullptr;             ///< 计量器
+            Histogram* histogram = nullptr;     ///< 直方图
+            Entry* next = nullptr;              ///< 下一个注册项 (按注册顺序)
+        };
+
+    private:
+        mutable xyu::Mutex m;               // 保护注册项链表
+        Entry* head = nullptr;              // 首个注册项
+        Entry** tail = &head;               // 末尾的 next 指针
+        xyu::Atomic<xyu::size_t> est{0};    // 导出长度的估计值
+
+    public:
+        /// 默认构造
+        MetricRegistry() noexcept = default;
+        /// 析构 (释放所有指标)
+        ~MetricRegistry() noexcept;
+
+        /// 获取全局注册表
+        static MetricRegistry& global() noexcept;
+
+        /**
+         * @brief 获取计数器 (不存在时创建)
+         * @exception E_Logic_Invalid_Argument 名称已注册为其他类型的指标
+         */
+        Counter& counter(const xyu::StringView& name);
+
+        /**
+         * @brief 获取计量器 (不存在时创建)
+         * @exception E_Logic_Invalid_Argument 名称已注册为其他类型的指标
+         */
+        Gauge& gauge(const xyu::StringView& name);
+
+        /**
+         * @brief 获取直方图 (不存在时以 bounds 创建；已存在时忽略 bounds)
+         * @exception E_Logic_Invalid_Argument 名称已注册为其他类型的指标，或上界不是严格递增
+         */
+        Histogram& histogram(const xyu::StringView& name, const xyu::int64* bounds, xyu::size_t count);
+
+        /// 获取直方图 (不存在时以 bounds 创建；已存在时忽略 bounds)
+        Histogram& histogram(const xyu::StringView& name, std::initializer_list<xyu::int64> bounds)
+        { return histogram(name, bounds.begin(), bounds.size()); }
+
+        /// 按注册顺序访问所有注册项 fun(const Entry&) (访问期间持有锁，fun 中不能注册指标)
+        template <typename Fun>
+        void each(Fun&& fun) const
+        {
+            auto g = m.guard();
+            for (const Entry* e = head; e; e = e->next) fun(*e);
+        }
+
+        /// 导出长度的估计值 (用于预分配)
+        xyu::size_t size_hint() const noexcept { return est.load(xyu::N_ATOMIC_RELAXED); }
+
+        /**
+         * @brief 将快照写入文件
+         * @exception E_File_*
+         */
+        void write_to(const xyu::File& file) const { file.write(*this); }
+
+    private:
+        // 按名称查找注册项 (需持有锁)
+        Entry* lookup(const xyu::StringView& name) const noexcept;
+        // 追加注册项 (需持有锁)
+        Entry& append(const xyu::StringView& name, xyu::size_t hint);
+    };
+}
+
+/// 格式化
+namespace xylu::xystring
+{
+    /// 以 Prometheus 文本格式输出注册表的快照
+    template <>
+    struct Formatter<xylu::xyconc::MetricRegistry>
+    {
+        using T = xylu::xyconc::MetricRegistry;
+
+        // 运行时解析
+        static constexpr bool runtime = true;
+
+        /// 预解析
+        constexpr static xyu::size_t prepare() noexcept { return 0; }
+
+        /// 解析
+        static xyu::size_t parse(const T& reg) noexcept { return reg.size_hint(); }
+
+        /// 运行期预解析
+        static xyu::size_t preparse(const T& reg) noexcept { return reg.size_hint(); }
+
+        /// 格式化
+        template <typename Stream>
+        static void format(Stream& out, const T& reg)
+        {
+            using Fu = Formatter<xyu::uint64>;
+            using Fi = Formatter<xyu::int64>;
+            reg.each([&](const T::Entry& e) {
+                if (e.counter) {
+                    out << e.name << ' ';
+                    Fu::format(out, e.counter->value(), Format_Layout{});
+                    out << '\n';
+                }
+                else if (e.gauge) {
+                    out << e.name << ' ';
+                    Fi::format(out, e.gauge->value(), Format_Layout{});
+                    out << '\n';
+                }
+                else {
+                    const auto& h = *e.histogram;
+                    xyu::uint64 cum = 0;
+                    for (xyu::size_t i = 0; i < h.buckets(); ++i) {
+                        cum += h.bucket(i);
+                        out << e.name << "_bucket{le=\"";
+                        if (i + 1 < h.buckets()) Fi::format(out, h.bound(i), Format_Layout{});
+                        else out << "+Inf";
+                        out << "\"} ";
+                        Fu::format(out, cum, Format_Layout{});
+                        out << '\n';
+                    }
+                    out << e.name << "_sum ";
+                    Fi::format(out, h.sum(), Format_Layout{});
+                    out << '\n' << e.name << "_count ";
+                    Fu::format(out, cum, Format_Layout{});
+                    out << '\n';
+                }
+            });
+        }
+    };
+}
+
+#pragma clang diagnostic pop
@@ -6,10 +6,37 @@
 #pragma once
 
 #include "../../link/time"
+#include "../../link/atomic"
+
+// 是否使用 futex 实现 Mutex 和 CondVar
+#if XY_FUTEX && defined(__linux__) && !defined(__CYGWIN__)
+#define XY_MUTEX_FUTEX 1
+#else
+#define XY_MUTEX_FUTEX 0
+#endif
 
 /// 锁
 namespace xylu::xyconc
 {
+#if XY_MUTEX_FUTEX
+    namespace __
+    {
+        // futex 等待 (*addr 等于 val 时挂起，直到被唤醒，可能虚假唤醒)
+        void futex_wait(void* addr, xyu::uint32 val) noexcept;
+        // futex 等待，直到被唤醒 或 超时 (从1970年1月1日开始的 s 秒 + ns 纳秒)，返回是否未超时
+        bool futex_wait_to(void* addr, xyu::uint32 val, xyu::size_t s, xyu::size_t ns) noexcept;
+        // futex 唤醒最多 n 个等待线程
+        void futex_wake(void* addr, int n) noexcept;
+
+        // futex 互斥锁上锁 (状态 0: 未上锁, 1: 已上锁, 2: 已上锁且可能有等待线程)
+        void futex_lock(xyu::Atomic<xyu::uint32>& h) noexcept;
+        // futex 互斥锁解锁 (仅在可能有等待线程时唤醒)
+        void futex_unlock(xyu::Atomic<xyu::uint32>& h) noexcept;
+        // futex 互斥锁尝试上锁
+        bool futex_trylock(xyu::Atomic<xyu::uint32>& h) noexcept;
+    }
+#endif
+
     /**
      * @brief 一个基础的、移动专属的互斥锁。
      * @details
@@ -25,14 +52,31 @@ namespace xylu::xyconc
      *       // ... 访问受保护的资源 ...
      *   } // guard 在此销毁，自动解锁
      *   @endcode
+     *
+     * @note Linux 下 (XY_FUTEX) 为内联的 32 位 futex 状态，不进行动态分配；
+     *       上锁时先有限自旋，再挂起，解锁时仅在可能有等待线程时进入内核唤醒。
+     * @note 开启 XY_LOCK_PROFILE 后，`Guard` 的竞争情况可由 `LockProfiler` 统计。
      */
     class Mutex : xyu::class_no_copy_t
     {
         friend class CondVar;
     private:
+#if XY_MUTEX_FUTEX
+        xyu::Atomic<xyu::uint32> h{0};  // 锁状态
+#else
         void *h;    // 锁句柄
+#endif
 
     public:
+#if XY_MUTEX_FUTEX
+        /// 创建互斥锁
+        Mutex() noexcept = default;
+        /// 销毁互斥锁
+        ~Mutex() noexcept = default;
+
+        /// 移动构造
+        Mutex(Mutex&& other) noexcept : h{other.h} { other.h.store(0, xyu::N_ATOMIC_RELAXED); }
+#else
         /**
          * @brief 创建互斥锁
          * @exception E_Mutex_*
@@ -46,6 +90,7 @@ namespace xylu::xyconc
 
         /// 移动构造
         Mutex(Mutex&& other) noexcept : h{other.h} { other.h = nullptr; }
+#endif
         /// 移动赋值
         Mutex& operator=(Mutex&& other) noexcept { xyu::swap(h, other.h); return *this; }
 
@@ -60,6 +105,9 @@ namespace xylu::xyconc
         private:
             Mutex& m;   // 互斥锁引用
             bool own;   // 是否已上锁
+#if XY_LOCK_PROFILE
+            xyu::int64 ht = 0;  // 竞争上锁后获得锁的时间 (0 表示不记录持有时间)
+#endif
 
         public:
             /// 构造函数 (默认上锁)
@@ -93,9 +141,22 @@ namespace xylu::xyconc
 
         public:
             /// 移动构造
-            Guard(Guard&& other) noexcept : m{other.m}, own{other.own} { other.own = false; }
+            Guard(Guard&& other) noexcept : m{other.m}, own{other.own}
+            {
+                other.own = false;
+#if XY_LOCK_PROFILE
+                xyu::swap(ht, other.ht);
+#endif
+            }
             /// 移动赋值
-            Guard& operator=(Guard&& other) noexcept { xyu::swap(m, other.m); xyu::swap(own, other.own); return *this; }
+            Guard& operator=(Guard&& other) noexcept
+            {
+                xyu::swap(m, other.m); xyu::swap(own, other.own);
+#if XY_LOCK_PROFILE
+                xyu::swap(ht, other.ht);
+#endif
+                return *this;
+            }
         };
 
         /**
@@ -170,6 +231,7 @@ namespace xylu::xyconc
      *   `Mutex_RW` 提高了并发性能，因为它允许多个线程同时进行读操作。
      *   只有在需要进行写操作时，才会对所有其他读者和写者进行独占锁定。
      * @note 必须使用 `rguard()` 获取读锁卫，`guard()` 获取写锁卫。
+     * @note 开启 XY_LOCK_PROFILE 后，读写锁卫的竞争情况可由 `LockProfiler` 统计。
      */
     class Mutex_RW : xyu::class_no_copy_t
     {
@@ -209,6 +271,9 @@ namespace xylu::xyconc
         private:
             Mutex_RW& m;    // 互斥锁引用
             bool own;       // 是否已上锁
+#if XY_LOCK_PROFILE
+            xyu::int64 ht = 0;  // 竞争上锁后获得锁的时间 (0 表示不记录持有时间)
+#endif
 
         public:
             /// 构造函数 (默认上锁)
@@ -242,9 +307,22 @@ namespace xylu::xyconc
 
         public:
             /// 移动构造
-            Guard_Write(Guard_Write&& other) noexcept : m{other.m}, own{other.own} { other.own = false; }
+            Guard_Write(Guard_Write&& other) noexcept : m{other.m}, own{other.own}
+            {
+                other.own = false;
+#if XY_LOCK_PROFILE
+                xyu::swap(ht, other.ht);
+#endif
+            }
             /// 移动赋值
-            Guard_Write& operator=(Guard_Write&& other) noexcept { xyu::swap(m, other.m); xyu::swap(own, other.own); return *this; }
+            Guard_Write& operator=(Guard_Write&& other) noexcept
+            {
+                xyu::swap(m, other.m); xyu::swap(own, other.own);
+#if XY_LOCK_PROFILE
+                xyu::swap(ht, other.ht);
+#endif
+                return *this;
+            }
         };
         /**
          * @brief 生成写锁锁卫
@@ -265,6 +343,9 @@ namespace xylu::xyconc
         private:
             Mutex_RW& m;    // 互斥锁引用
             bool have;      // 是否已上锁
+#if XY_LOCK_PROFILE
+            xyu::int64 ht = 0;  // 竞争上锁后获得锁的时间 (0 表示不记录持有时间)
+#endif
 
         public:
             /// 构造函数 (默认上锁)
@@ -298,9 +379,158 @@ namespace xylu::xyconc
 
         public:
             /// 移动构造
-            Guard_Read(Guard_Read&& other) noexcept : m{other.m}, have{other.have} { other.have = false; }
+            Guard_Read(Guard_Read&& other) noexcept : m{other.m}, have{other.have}
+            {
+                other.have = false;
+#if XY_LOCK_PROFILE
+                xyu::swap(ht, other.ht);
+#endif
+            }
             /// 移动赋值
-            Guard_Read& operator=(Guard_Read&& other) noexcept { xyu::swap(m, other.m); xyu::swap(have, other.have); return *this; }
+            Guard_Read& operator=(Guard_Read&& other) noexcept
+            {
+                xyu::swap(m, other.m); xyu::swap(have, other.have);
+#if XY_LOCK_PROFILE
+                xyu::swap(ht, other.ht);
+#endif
+                return *this;
+            }
+        };
+        /**
+         * @brief 生成读锁锁卫
+         * @param need_lock 是否需要上锁
+         * @note 一个线程内只能同时存在一个有效的 guard，否则状态异常
+         */
+        [[nodiscard]] Guard_Read rguard(bool need_lock = true) { return {*this, need_lock}; }
+    };
+
+    /**
+     * @brief 偏向读者的读写锁，适用于读取极其频繁、写入很少的场景。
+     * @details
+     *   读者计数分散在多个独占缓存行的槽位中，每个线程固定使用其中一个槽位。
+     *   读者上锁和解锁只修改自身槽位，不会与其他线程的读者争用同一缓存行。
+     *
+     *   写者通过内部的 `Mutex` 串行化，设置写标记后扫描所有槽位，等待已有的读者退出。
+     *   读者发现写标记时撤回计数，并通过内部的 `Mutex` 挂起等待写者结束 (写者优先，不会饿死写者)。
+     *
+     * @note 接口与 `Mutex_RW` 相同：`rguard()` 获取读锁卫，`guard()` 获取写锁卫。
+     * @note 写入代价高于 `Mutex_RW` (需要扫描所有槽位，并自旋等待读者退出)，且不能与 `CondVar` 一起使用。
+     * @note 占用 K_slot_count + 2 个缓存行，不可移动。
+     */
+    class alignas(xyu::K_CACHE_LINE_SIZE) Mutex_RW_Biased : xyu::class_no_copy_move_t
+    {
+    public:
+        /// 读者槽位数量
+        constexpr static xyu::size_t K_slot_count = 32;
+
+    private:
+        // 读者槽位 (独占缓存行)
+        struct alignas(xyu::K_CACHE_LINE_SIZE) Slot
+        {
+            xyu::Atomic<xyu::uint32> n{0};  // 持有读锁的线程数量
+        };
+
+        Slot rs[K_slot_count];                                                  // 读者槽位
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::uint32> wf{0};         // 写标记
+        alignas(xyu::K_CACHE_LINE_SIZE) Mutex wm;                               // 写者锁
+
+    public:
+        /// 创建读写锁
+        Mutex_RW_Biased() = default;
+
+    public:
+        /**
+         * @brief 写锁锁卫
+         * @note 检测重复上锁和解锁，及自动解锁
+         */
+        struct Guard_Write : xyu::class_no_copy_t
+        {
+        private:
+            Mutex_RW_Biased& m; // 读写锁引用
+            Mutex::Guard g;     // 写者锁锁卫
+
+        public:
+            /// 构造函数 (默认上锁)
+            Guard_Write(Mutex_RW_Biased& m, bool need_lock = true) : m{m}, g{m.wm, false} { if (need_lock) lock(); }
+            /// 析构函数 (自动解锁)
+            ~Guard_Write() noexcept { try { if (g.is_locked()) unlock(); } catch(...) {} }
+
+            /// 判断是否已上锁
+            bool is_locked() const noexcept { return g.is_locked(); }
+
+            /**
+             * @brief 上锁 (等待所有读者退出)
+             * @exception E_Mutex_Already_Locked 互斥锁已上锁 (DEBUG下抛出，否则忽略)
+             * @exception E_Mutex_*
+             */
+            void lock();
+
+            /**
+             * @brief 解锁
+             * @exception E_Mutex_Not_Locked 互斥锁未上锁 (DEBUG下抛出，否则忽略)
+             * @exception E_Mutex_*
+             */
+            void unlock();
+
+            /**
+             * @brief 尝试上锁 (有其他写者或读者时失败)
+             * @exception E_Mutex_Already_Locked 互斥锁已上锁 (DEBUG下抛出，否则忽略)
+             * @exception E_Mutex_*
+             */
+            bool trylock();
+
+        public:
+            /// 移动构造
+            Guard_Write(Guard_Write&& other) noexcept : m{other.m}, g{xyu::move(other.g)} {}
+        };
+        /**
+         * @brief 生成写锁锁卫
+         * @param need_lock 是否需要上锁
+         * @note 一个线程内只能同时存在一个有效的 guard，否则状态异常
+         */
+        [[nodiscard]] Guard_Write guard(bool need_lock = true) { return {*this, need_lock}; }
+
+        /**
+         * @brief 读锁锁卫
+         * @note 检测重复上锁和解锁，及自动解锁
+         */
+        struct Guard_Read : xyu::class_no_copy_t
+        {
+        private:
+            Mutex_RW_Biased& m;             // 读写锁引用
+            xyu::Atomic<xyu::uint32>* sl;   // 上锁使用的槽位 (未上锁时为 nullptr)
+
+        public:
+            /// 构造函数 (默认上锁)
+            Guard_Read(Mutex_RW_Biased& m, bool need_lock = true) : m{m}, sl{nullptr} { if (need_lock) lock(); }
+            /// 析构函数 (自动解锁)
+            ~Guard_Read() noexcept { try { if (sl) unlock(); } catch(...) {} }
+
+            /// 判断是否已上锁
+            bool is_locked() const noexcept { return sl; }
+
+            /**
+             * @brief 上锁 (无写者时只修改当前线程的槽位)
+             * @exception E_Mutex_Already_Locked 互斥锁已上锁 (DEBUG下抛出，否则忽略)
+             * @exception E_Mutex_*
+             */
+            void lock();
+
+            /**
+             * @brief 解锁
+             * @exception E_Mutex_Not_Locked 互斥锁未上锁 (DEBUG下抛出，否则忽略)
+             */
+            void unlock();
+
+            /**
+             * @brief 尝试上锁 (有写者时失败)
+             * @exception E_Mutex_Already_Locked 互斥锁已上锁 (DEBUG下抛出，否则忽略)
+             */
+            bool trylock();
+
+        public:
+            /// 移动构造
+            Guard_Read(Guard_Read&& other) noexcept : m{other.m}, sl{other.sl} { other.sl = nullptr; }
         };
         /**
          * @brief 生成读锁锁卫
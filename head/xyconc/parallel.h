@@ -0,0 +1,483 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/range"
+#include "../../link/log"
+
+#if !XY_UNTHREAD
+#include "../../link/pool"
+#endif
+
+/// 并行算法
+namespace xylu::xyconc
+{
+    /**
+     * @brief 并行算法的执行选项
+     *
+     * @details
+     *   算法把范围划分为连续的块，调用线程与线程池中的若干工作线程从共享的计数器领取块执行。
+     *   调用线程同样执行块，并在所有块完成后返回，因此在线程池的任务中调用 (嵌套并行) 也不会死锁。
+     *
+     *   ### 分块:
+     *   - 每块至少覆盖 16 KiB 的数据，且为缓存行的整数倍 (指定 grain 时除外)，
+     *     使块内的访问连续、调度开销可忽略，相邻块之间最多共享一个缓存行。
+     *   - 块数约为参与线程数的 4 倍，以平衡各块执行时间的差异。
+     *   - 数据量不足两块或只有一个参与线程时，直接在调用线程中串行执行，不访问线程池。
+     *
+     *   XY_UNTHREAD 下所有算法均串行执行，选项被忽略。
+     */
+    struct Parallel_Option
+    {
+#if !XY_UNTHREAD
+        ThreadPool* pool = nullptr;     ///< 线程池 (nullptr 时使用共享线程池 parallel_pool())
+#endif
+        xyu::size_t threads = 0;        ///< 最多参与的线程数 (含调用线程，0 表示线程池的线程数 + 1)
+        xyu::size_t grain = 0;          ///< 每块的最少元素数 (0 表示按缓存大小自动计算)
+    };
+
+#if !XY_UNTHREAD
+    /**
+     * @brief 获取并行算法共享的线程池 (首次调用时创建，工作线程数为 硬件线程数 - 1，调用线程补足其余一个)
+     * @exception E_Thread_* 创建线程失败
+     */
+    ThreadPool& parallel_pool();
+#endif
+
+    namespace __
+    {
+        // 分块方案
+        struct ParPlan
+        {
+            xyu::size_t chunk;      // 每块的元素数
+            xyu::size_t chunks;     // 块数
+        };
+
+#if !XY_UNTHREAD
+        // 计算 n 个大小为 elem 字节的元素的分块方案
+        ParPlan par_plan(xyu::size_t n, xyu::size_t elem, const Parallel_Option& op);
+        // 并行执行 body(ctx, 0) ~ body(ctx, chunks - 1)，重新抛出最先失败的块的异常 (之后未开始的块被跳过)
+        void par_run(xyu::size_t chunks, void (*body)(void*, xyu::size_t), void* ctx, const Parallel_Option& op);
+#else
+        inline ParPlan par_plan(xyu::size_t n, xyu::size_t, const Parallel_Option&) noexcept
+        { return {n ? n : 1, n ? 1u : 0u}; }
+        inline void par_run(xyu::size_t chunks, void (*body)(void*, xyu::size_t), void* ctx, const Parallel_Option&)
+        { for (xyu::size_t c = 0; c < chunks; ++c) body(ctx, c); }
+#endif
+
+        // 按分块方案对 [0, n) 的每一块调用 f(lo, hi, c)
+        template <typename F>
+        void par_chunks(xyu::size_t n, const ParPlan& pl, F& f, const Parallel_Option& op)
+        {
+            struct Ctx { F* f; xyu::size_t n, chunk; } ctx{&f, n, pl.chunk};
+            par_run(pl.chunks, [](void* p, xyu::size_t c) {
+                auto& x = *static_cast<Ctx*>(p);
+                xyu::size_t lo = c * x.chunk, hi = x.n - lo > x.chunk ? lo + x.chunk : x.n;
+                (*x.f)(lo, hi, c);
+            }, &ctx, op);
+        }
+
+        // 将容器等转为范围
+        template <typename Rg>
+        constexpr auto par_range(Rg& rg)
+        {
+            if constexpr (xyu::t_is_range<Rg>) return rg;
+            else return xyu::make_range(rg);
+        }
+
+        // 范围的元素类型
+        template <typename Rg>
+        using par_value_t = xyu::t_remove_cvref<decltype(*par_range(xyu::t_val<Rg&>()).begin())>;
+
+        // 检查输出范围的大小
+        inline void par_check_out(xyu::size_t need, xyu::size_t have)
+        {
+            if (XY_UNLIKELY(have < need)) {
+                xyloge(false, "E_Logic_Invalid_Argument: output range has {} elements but {} are required", have, need);
+                throw xyu::E_Logic_Invalid_Argument{};
+            }
+        }
+
+        // 每块的部分结果 (由各块构造，析构时析构已构造的部分)
+        template <typename T>
+        struct ParParts : xyu::class_no_copy_move_t
+        {
+            struct Slot
+            {
+                alignas(T) xyu::uint8 data[sizeof(T)];
+                bool has;
+            };
+
+            Slot* s;
+            xyu::size_t n;
+
+            explicit ParParts(xyu::size_t n) : s{xyu::alloc<Slot>(xyu::native_v, n ? n : 1)}, n{n}
+            { for (xyu::size_t i = 0; i < n; ++i) s[i].has = false; }
+
+            ~ParParts() noexcept
+            {
+                for (xyu::size_t i = 0; i < n; ++i) if (s[i].has) get(i).~T();
+                xyu::dealloc<Slot>(xyu::native_v, s, n ? n : 1);
+            }
+
+            T& get(xyu::size_t i) noexcept { return *reinterpret_cast<T*>(s[i].data); }
+
+            template <typename... Args>
+            void set(xyu::size_t i, Args&&... args)
+            {
+                ::new (s[i].data) T(xyu::forward<Args>(args)...);
+                s[i].has = true;
+            }
+        };
+
+        /* 串行排序 (内省排序) */
+
+        // 插入排序
+        template <typename It, typename Cmp>
+        void sort_insertion(It b, xyu::size_t n, Cmp& cmp)
+        {
+            for (xyu::size_t i = 1; i < n; ++i)
+            {
+                auto v = xyu::move(*(b + i));
+                xyu::size_t j = i;
+                for (; j > 0 && cmp(v, *(b + (j - 1))); --j) *(b + j) = xyu::move(*(b + (j - 1)));
+                *(b + j) = xyu::move(v);
+            }
+        }
+
+        // 堆下沉
+        template <typename It, typename Cmp>
+        void sort_sift(It b, xyu::size_t i, xyu::size_t n, Cmp& cmp)
+        {
+            auto v = xyu::move(*(b + i));
+            for (xyu::size_t c; (c = 2 * i + 1) < n; i = c)
+            {
+                if (c + 1 < n && cmp(*(b + c), *(b + (c + 1)))) ++c;
+                if (!cmp(v, *(b + c))) break;
+                *(b + i) = xyu::move(*(b + c));
+            }
+            *(b + i) = xyu::move(v);
+        }
+
+        // 堆排序 (内省排序递归过深时使用，保证 O(n log n))
+        template <typename It, typename Cmp>
+        void sort_heap(It b, xyu::size_t n, Cmp& cmp)
+        {
+            for (xyu::size_t i = n / 2; i-- > 0; ) sort_sift(b, i, n, cmp);
+            for (xyu::size_t e = n; e-- > 1; ) {
+                xyu::swap(*b, *(b + e));
+                sort_sift(b, 0, e, cmp);
+            }
+        }
+
+        // 内省排序
+        template <typename It, typename Cmp>
+        void sort_intro(It b, xyu::size_t n, xyu::size_t depth, Cmp& cmp)
+        {
+            while (n > 16)
+            {
+                if (depth-- == 0) { sort_heap(b, n, cmp); return; }
+                // 三数取中放到首位，b[1] 与 b[n-1] 作为两侧扫描的哨兵
+                xyu::size_t m = n / 2;
+                if (cmp(*(b + m), *(b + 1))) xyu::swap(*(b + m), *(b + 1));
+                if (cmp(*(b + (n - 1)), *(b + m))) {
+                    xyu::swap(*(b + (n - 1)), *(b + m));
+                    if (cmp(*(b + m), *(b + 1))) xyu::swap(*(b + m), *(b + 1));
+                }
+                xyu::swap(*b, *(b + m));
+                // 划分 (与基准相等的元素分布在两侧，大量重复元素时仍然均衡)
+                xyu::size_t i = 0, j = n;
+                for (;;)
+                {
+                    do ++i; while (cmp(*(b + i), *b));
+                    do --j; while (cmp(*b, *(b + j)));
+                    if (i >= j) break;
+                    xyu::swap(*(b + i), *(b + j));
+                }
+                xyu::swap(*b, *(b + j));
+                // 递归较短的一侧，循环处理较长的一侧
+                if (j < n - j - 1) { sort_intro(b, j, depth, cmp); b = b + (j + 1); n = n - j - 1; }
+                else { sort_intro(b + (j + 1), n - j - 1, depth, cmp); n = j; }
+            }
+            sort_insertion(b, n, cmp);
+        }
+
+        // 串行排序
+        template <typename It, typename Cmp>
+        void sort_serial(It b, xyu::size_t n, Cmp& cmp)
+        {
+            xyu::size_t depth = 0;
+            for (xyu::size_t k = n; k > 1; k >>= 1) depth += 2;
+            sort_intro(b, n, depth, cmp);
+        }
+
+        // 在 a[0, la) 与 b[0, lb) 的归并结果中，前 k 个元素里来自 a 的数量 (相等时 a 在前)
+        template <typename It, typename Cmp>
+        xyu::size_t merge_split(It a, xyu::size_t la, It b, xyu::size_t lb, xyu::size_t k, Cmp& cmp)
+        {
+            xyu::size_t lo = k > lb ? k - lb : 0, hi = k < la ? k : la;
+            while (lo < hi)
+            {
+                xyu::size_t i = lo + (hi - lo) / 2;
+                if (cmp(*(b + (k - i - 1)), *(a + i))) hi = i;
+                else lo = i + 1;
+            }
+            return lo;
+        }
+    }
+
+    /**
+     * @brief 并行地对范围中的每个元素调用 fun(elem)
+     * @param range 随机访问范围 (或可以转为范围的容器，如 Vector、Array、C 数组)
+     * @note 各元素的调用顺序不确定，fun 需要可以被多个线程同时调用。
+     * @exception ... 最先失败的块中 fun 抛出的异常 (其余未开始的块被跳过)
+     */
+    template <typename Rg, typename Fun>
+    void par_for_each(Rg&& range, Fun&& fun, const Parallel_Option& op = {})
+    {
+        auto rg = __::par_range(range);
+        static_assert(xyu::t_is_iter_random<decltype(rg.begin())>, "parallel algorithms require a random access range");
+        xyu::size_t n = rg.count();
+        auto b = rg.begin();
+        auto f = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t) {
+            auto it = b + lo;
+            for (xyu::size_t i = lo; i < hi; ++i, ++it) fun(*it);
+        };
+        __::par_chunks(n, __::par_plan(n, sizeof(__::par_value_t<Rg>), op), f, op);
+    }
+
+    /**
+     * @brief 并行地计算 out[i] = fun(in[i])
+     * @param out 输出范围 (元素数不少于 in，可以与 in 相同)
+     * @exception E_Logic_Invalid_Argument 输出范围过小
+     * @exception ... fun 或赋值抛出的异常
+     */
+    template <typename RgIn, typename RgOut, typename Fun>
+    void par_transform(RgIn&& in, RgOut&& out, Fun&& fun, const Parallel_Option& op = {})
+    {
+        auto ri = __::par_range(in);
+        auto ro = __::par_range(out);
+        static_assert(xyu::t_is_iter_random<decltype(ri.begin()), decltype(ro.begin())>, "parallel algorithms require a random access range");
+        xyu::size_t n = ri.count();
+        __::par_check_out(n, ro.count());
+        auto bi = ri.begin();
+        auto bo = ro.begin();
+        auto f = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t) {
+            auto s = bi + lo;
+            auto d = bo + lo;
+            for (xyu::size_t i = lo; i < hi; ++i, ++s, ++d) *d = fun(*s);
+        };
+        constexpr xyu::size_t elem = xyu::max(sizeof(__::par_value_t<RgIn>), sizeof(__::par_value_t<RgOut>));
+        __::par_chunks(n, __::par_plan(n, elem, op), f, op);
+    }
+
+    /**
+     * @brief 并行归约 init op e0 op e1 op ... (各块分别归约后，按块的顺序合并)
+     * @param op 满足结合律的二元操作 (不要求交换律)
+     * @return 归约结果 (空范围时为 init)
+     */
+    template <typename Rg, typename T, typename Op, typename = xyu::t_enable<!xyu::t_is_same<xyu::t_remove_cvref<Op>, Parallel_Option>>>
+    T par_reduce(Rg&& range, T init, Op&& op, const Parallel_Option& opt = {})
+    {
+        auto rg = __::par_range(range);
+        static_assert(xyu::t_is_iter_random<decltype(rg.begin())>, "parallel algorithms require a random access range");
+        xyu::size_t n = rg.count();
+        auto pl = __::par_plan(n, sizeof(__::par_value_t<Rg>), opt);
+        __::ParParts<T> parts{pl.chunks};
+        auto b = rg.begin();
+        auto f = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t c) {
+            auto it = b + lo;
+            T acc(*it);
+            for (xyu::size_t i = lo + 1; i < hi; ++i) acc = op(xyu::move(acc), *++it);
+            parts.set(c, xyu::move(acc));
+        };
+        __::par_chunks(n, pl, f, opt);
+        for (xyu::size_t c = 0; c < pl.chunks; ++c) init = op(xyu::move(init), xyu::move(parts.get(c)));
+        return init;
+    }
+
+    /// 并行求和
+    template <typename Rg, typename T>
+    T par_reduce(Rg&& range, T init, const Parallel_Option& opt = {})
+    { return par_reduce(range, xyu::move(init), [](auto&& a, auto&& b) { return a + b; }, opt); }
+
+    /**
+     * @brief 并行包含扫描 out[i] = in[0] op in[1] op ... op in[i]
+     * @param out 输出范围 (元素数不少于 in，可以与 in 相同)
+     * @param op 满足结合律的二元操作 (不要求交换律)
+     * @details 先并行归约除最后一块外的每一块，串行计算各块的前缀，再并行扫描各块。
+     * @exception E_Logic_Invalid_Argument 输出范围过小
+     */
+    template <typename RgIn, typename RgOut, typename Op, typename = xyu::t_enable<!xyu::t_is_same<xyu::t_remove_cvref<Op>, Parallel_Option>>>
+    void par_inclusive_scan(RgIn&& in, RgOut&& out, Op&& op, const Parallel_Option& opt = {})
+    {
+        using V = __::par_value_t<RgIn>;
+        auto ri = __::par_range(in);
+        auto ro = __::par_range(out);
+        static_assert(xyu::t_is_iter_random<decltype(ri.begin()), decltype(ro.begin())>, "parallel algorithms require a random access range");
+        xyu::size_t n = ri.count();
+        __::par_check_out(n, ro.count());
+        constexpr xyu::size_t elem = xyu::max(sizeof(V), sizeof(__::par_value_t<RgOut>));
+        auto pl = __::par_plan(n, elem, opt);
+        auto bi = ri.begin();
+        auto bo = ro.begin();
+        __::ParParts<V> parts{pl.chunks};
+        // 各块的归约 (最后一块不需要)
+        if (pl.chunks > 1) {
+            __::ParPlan head{pl.chunk, pl.chunks - 1};
+            auto f = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t c) {
+                auto it = bi + lo;
+                V acc(*it);
+                for (xyu::size_t i = lo + 1; i < hi; ++i) acc = op(xyu::move(acc), *++it);
+                parts.set(c, xyu::move(acc));
+            };
+            __::par_chunks(pl.chunk * head.chunks, head, f, opt);
+            // 转为前缀 (parts[c] 为前 c + 1 块的归约)
+            for (xyu::size_t c = 1; c < head.chunks; ++c) parts.get(c) = op(parts.get(c - 1), parts.get(c));
+        }
+        auto g = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t c) {
+            auto s = bi + lo;
+            auto d = bo + lo;
+            V acc = c ? V(op(parts.get(c - 1), *s)) : V(*s);
+            *d = acc;
+            for (xyu::size_t i = lo + 1; i < hi; ++i) { acc = op(xyu::move(acc), *++s); *++d = acc; }
+        };
+        __::par_chunks(n, pl, g, opt);
+    }
+
+    /// 并行前缀和
+    template <typename RgIn, typename RgOut>
+    void par_inclusive_scan(RgIn&& in, RgOut&& out, const Parallel_Option& opt = {})
+    { par_inclusive_scan(in, out, [](auto&& a, auto&& b) { return a + b; }, opt); }
+
+    /**
+     * @brief 并行统计满足 pred(elem) 的元素数量
+     */
+    template <typename Rg, typename Pred>
+    xyu::size_t par_count_if(Rg&& range, Pred&& pred, const Parallel_Option& opt = {})
+    {
+        auto rg = __::par_range(range);
+        static_assert(xyu::t_is_iter_random<decltype(rg.begin())>, "parallel algorithms require a random access range");
+        xyu::size_t n = rg.count();
+        auto pl = __::par_plan(n, sizeof(__::par_value_t<Rg>), opt);
+        __::ParParts<xyu::size_t> parts{pl.chunks};
+        auto b = rg.begin();
+        auto f = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t c) {
+            auto it = b + lo;
+            xyu::size_t k = 0;
+            for (xyu::size_t i = lo; i < hi; ++i, ++it) k += static_cast<bool>(pred(*it));
+            parts.set(c, k);
+        };
+        __::par_chunks(n, pl, f, opt);
+        xyu::size_t sum = 0;
+        for (xyu::size_t c = 0; c < pl.chunks; ++c) sum += parts.get(c);
+        return sum;
+    }
+
+    /**
+     * @brief 并行排序 (不稳定)
+     * @param cmp 严格弱序的比较 cmp(a, b) 表示 a 在 b 之前
+     *
+     * @details
+     *   各块并行地进行内省排序，然后逐轮两两归并相邻的有序段。每一轮按输出位置划分为与块大小相同的段，
+     *   每段在两个输入中的起止位置先由二分查找全部求出，再各自独立归并，因此每一轮都能使用所有参与线程。
+     *   归并在范围与临时缓冲区之间交替进行，需要 n 个元素的临时内存。
+     *
+     * @note 元素的移动构造与移动赋值不能抛出异常。cmp 抛出异常时，范围的内容未指定。
+     * @exception E_Memory_Alloc 分配临时缓冲区失败 (此时范围中的各块已有序)
+     */
+    template <typename Rg, typename Cmp, typename = xyu::t_enable<!xyu::t_is_same<xyu::t_remove_cvref<Cmp>, Parallel_Option>>>
+    void par_sort(Rg&& range, Cmp&& cmp, const Parallel_Option& opt = {})
+    {
+        using V = __::par_value_t<Rg>;
+        static_assert(xyu::t_can_nothrow_mvconstr<V> && xyu::t_can_nothrow_mvassign<V>,
+                      "element of par_sort must be nothrow move constructible and assignable");
+        auto rg = __::par_range(range);
+        static_assert(xyu::t_is_iter_random<decltype(rg.begin())>, "parallel algorithms require a random access range");
+        xyu::size_t n = rg.count();
+        auto b = rg.begin();
+        auto pl = __::par_plan(n, sizeof(V), opt);
+        if (pl.chunks <= 1) { __::sort_serial(b, n, cmp); return; }
+
+        // 各块排序
+        auto fs = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t) { __::sort_serial(b + lo, hi - lo, cmp); };
+        __::par_chunks(n, pl, fs, opt);
+
+        // 临时缓冲区 (元素全部构造后才进行归并，之后两侧均为有效对象)
+        struct Buffer
+        {
+            V* p; xyu::size_t n;
+            xyu::size_t* sp = nullptr; xyu::size_t m = 0;
+            ~Buffer() noexcept
+            {
+                if constexpr (!xyu::t_can_trivial_destruct<V>) for (xyu::size_t i = 0; i < n; ++i) p[i].~V();
+                xyu::dealloc<V>(xyu::native_v, p, n);
+                if (sp) xyu::dealloc<xyu::size_t>(xyu::native_v, sp, m);
+            }
+        } buf{xyu::alloc<V>(xyu::native_v, n), 0};
+        // 每块在所属有序段对中的归并起止位置 (需在任何元素被移走前全部求出)
+        buf.sp = xyu::alloc<xyu::size_t>(xyu::native_v, 2 * pl.chunks);
+        buf.m = 2 * pl.chunks;
+        auto fm = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t) {
+            auto it = b + lo;
+            for (xyu::size_t i = lo; i < hi; ++i, ++it) ::new (buf.p + i) V(xyu::move(*it));
+        };
+        __::par_chunks(n, pl, fm, opt);
+        buf.n = n;
+
+        // 将 src 中长度为 w 的有序段两两归并到 dst
+        auto pass = [&](auto src, auto dst, xyu::size_t w) {
+            auto seg = [&](xyu::size_t lo, xyu::size_t& ps, xyu::size_t& la, xyu::size_t& lb) {
+                ps = lo / (2 * w) * (2 * w);
+                la = n - ps > w ? w : n - ps;
+                lb = n - ps - la > w ? w : n - ps - la;
+            };
+            auto fsp = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t k) {
+                xyu::size_t ps, la, lb;
+                seg(lo, ps, la, lb);
+                buf.sp[2 * k] = __::merge_split(src + ps, la, src + (ps + la), lb, lo - ps, cmp);
+                buf.sp[2 * k + 1] = __::merge_split(src + ps, la, src + (ps + la), lb, hi - ps, cmp);
+            };
+            __::par_chunks(n, pl, fsp, opt);
+            auto f = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t k) {
+                xyu::size_t ps, la, lb;
+                seg(lo, ps, la, lb);
+                auto a = src + ps;
+                auto c = src + (ps + la);
+                xyu::size_t i = buf.sp[2 * k], j = lo - ps - i;
+                xyu::size_t ie = buf.sp[2 * k + 1], je = hi - ps - ie;
+                auto d = dst + lo;
+                while (i < ie && j < je) {
+                    if (cmp(*(c + j), *(a + i))) *d = xyu::move(*(c + j++));
+                    else *d = xyu::move(*(a + i++));
+                    ++d;
+                }
+                for (; i < ie; ++i, ++d) *d = xyu::move(*(a + i));
+                for (; j < je; ++j, ++d) *d = xyu::move(*(c + j));
+            };
+            __::par_chunks(n, pl, f, opt);
+        };
+        // 块大小整除每一轮的段长，因此每个输出段只属于一对有序段
+        bool in_buf = true;
+        for (xyu::size_t w = pl.chunk; w < n; w *= 2, in_buf = !in_buf)
+        {
+            if (in_buf) pass(buf.p, b, w);
+            else pass(b, buf.p, w);
+        }
+        if (in_buf) {
+            auto fb = [&](xyu::size_t lo, xyu::size_t hi, xyu::size_t) {
+                auto it = b + lo;
+                for (xyu::size_t i = lo; i < hi; ++i, ++it) *it = xyu::move(buf.p[i]);
+            };
+            __::par_chunks(n, pl, fb, opt);
+        }
+    }
+
+    /// 并行升序排序 (不稳定)
+    template <typename Rg>
+    void par_sort(Rg&& range, const Parallel_Option& opt = {})
+    { par_sort(range, [](const auto& a, const auto& b) { return a < b; }, opt); }
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,155 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/thread"
+#include "../../link/queue"
+
+/// 线程池
+namespace xylu::xyconc
+{
+    class ThreadPool;
+
+    namespace __
+    {
+        // 线程池任务
+        struct PoolTask
+        {
+            void (*run)(void*) noexcept;    // 执行函数
+            void* arg;                      // 执行参数
+        };
+
+        // 工作线程 (实现于源文件)
+        struct PoolWorker;
+
+        // Future 的续体 (见 future.h)
+        struct FutureCont;
+        // 将续体提交到线程池
+        void future_enqueue(ThreadPool& pool, FutureCont* k);
+    }
+
+    /**
+     * @brief 基于工作窃取 (work-stealing) 的线程池。
+     *
+     * @details
+     *   线程池在构造时创建固定数量的工作线程，提交的任务在这些线程中执行，
+     *   避免了 `Thread` 为每个任务创建新线程的开销，适用于大量细粒度的任务。
+     *
+     *   ### 调度策略:
+     *   - 每个工作线程拥有一个 Chase-Lev 双端队列。工作线程内提交的任务放入自身队列的底部，
+     *     并从底部取出执行 (后进先出，利于缓存局部性)。
+     *   - 外部线程提交的任务放入共享的有界提交队列 (MpmcQueue)，工作线程批量取出到自身队列。
+     *   - 自身队列为空时，从随机选择的其他工作线程队列的顶部窃取任务。
+     *   - 找不到任务时，短暂让步后挂起；提交任务时仅在有线程挂起时才获取锁唤醒。
+     *
+     *   ### 任务接口:
+     *   - `submit`: 提交任务，返回 `Thread` 句柄，可通过 `wait`/`get` 获取返回值或异常 (通过 ErrorPtr 传递)。
+     *   - `post`: 提交无需句柄的任务，省去状态块的分配；任务抛出的异常被记录到日志后忽略。
+     *   - `xyu::async(pool, ...)` (future.h): 返回 `Future`，可以通过 `then` 串联续体而不阻塞等待。
+     *
+     * @note 析构时会执行完所有已提交的任务，再结束工作线程。
+     * @note 提交队列已满时，外部线程的提交会挂起等待，直到有空闲位置 (背压)。
+     * @note 在任务中阻塞等待同一线程池中其他任务的句柄，可能因工作线程耗尽而死锁。
+     */
+    class ThreadPool : xyu::class_no_copy_move_t
+    {
+        friend void __::future_enqueue(ThreadPool& pool, __::FutureCont* k);
+    private:
+        __::PoolWorker* ws;                                                 // 工作线程数组
+        xyu::size_t wn;                                                     // 工作线程数量
+        MpmcQueue<__::PoolTask> inject;                                     // 外部提交队列
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::uint32> sleepers{0};  // 挂起的工作线程数量
+        xyu::Atomic<bool> stop{false};                                      // 结束标记
+        xyu::Mutex m;                                                       // 挂起使用的锁
+        xyu::CondVar cv;                                                    // 任务通知
+
+    public:
+        /* 构造析构 */
+
+        /**
+         * @brief 创建线程池并启动工作线程
+         * @param threads 工作线程数量 (为 0 时使用 hardware_count())
+         * @param queue_capa 外部提交队列的最小容量
+         * @exception E_Thread_* 创建线程失败
+         */
+        explicit ThreadPool(xyu::size_t threads = 0, xyu::size_t queue_capa = 4096);
+
+        /// 执行完所有已提交的任务后，结束并等待所有工作线程
+        ~ThreadPool() noexcept;
+
+        /* 属性 */
+
+        /// 获取工作线程数量
+        xyu::size_t count() const noexcept { return wn; }
+
+        /// 获取硬件并发线程数 (至少为 1)
+        static xyu::size_t hardware_count() noexcept { return Thread_Native::hardware_count(); }
+
+        /* 任务提交 */
+
+        /**
+         * @brief 提交任务 fun(args...)
+         * @return 任务句柄，用法与 `Thread` 相同 (status/wait/get)
+         * @exception E_Mutex_* 提交队列已满，挂起等待时出错
+         */
+        template <typename Fun, typename... Args>
+        Thread submit(Fun&& fun, Args&&... args)
+        {
+            Thread t;
+            void* arg = t.prepare(xyu::forward<Fun>(fun), xyu::forward<Args>(args)...);
+            try { enqueue({Thread::pool_fun<Fun, Args...>, arg}); }
+            catch (...) { t.drop_arg<Fun, Args...>(arg); throw; }
+            return t;
+        }
+
+        /**
+         * @brief 提交无需句柄的任务 fun(args...)
+         * @note 任务抛出的异常被记录到日志后忽略
+         * @exception E_Mutex_* 提交队列已满，挂起等待时出错
+         */
+        template <typename Fun, typename... Args>
+        void post(Fun&& fun, Args&&... args)
+        {
+            static_assert(xyu::t_can_call<Fun, Args...>);
+            using Tp = xyu::Tuple<xyu::t_decay<Fun>, xyu::Tuple<xyu::t_decay<Args>...>>;
+            auto* p = xyu::alloc<Tp>(xyu::native_v, 1);
+            try { ::new (p) Tp{ xyu::forward<Fun>(fun), { xyu::forward<Args>(args)... } }; }
+            catch (...) { xyu::dealloc(xyu::native_v, p); throw; }
+            try { enqueue({post_fun<Tp>, p}); }
+            catch (...) { p->~Tp(); xyu::dealloc(xyu::native_v, p); throw; }
+        }
+
+    private:
+        // 执行 post 提交的任务
+        template <typename Tp>
+        static void post_fun(void* arg) noexcept
+        {
+            auto& tp = *reinterpret_cast<Tp*>(arg);
+            try { tp.template get<1>().apply(tp.template get<0>()); }
+            catch (...) { post_error(); }
+            tp.~Tp();
+            xyu::dealloc(xyu::native_v, arg);
+        }
+
+        // 记录 post 任务的异常
+        static void post_error() noexcept;
+
+        // 结束并等待所有工作线程，释放工作线程数组
+        void shutdown() noexcept;
+
+        // 提交任务 (工作线程内提交到自身队列，否则提交到外部提交队列)
+        void enqueue(__::PoolTask task);
+
+        // 工作线程入口
+        static void worker_main(void* arg);
+
+        // 查找任务 (自身队列 -> 提交队列 -> 窃取)
+        bool find(__::PoolWorker& w, __::PoolTask& task) noexcept;
+
+        // 是否有待执行的任务
+        bool has_task() const noexcept;
+    };
+}
+
+#pragma clang diagnostic pop
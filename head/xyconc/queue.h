@@ -0,0 +1,925 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "hicpp-exception-baseclass"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/atomic"
+#include "../../link/log"
+#include "../../link/bitfun"
+
+#if !XY_UNTHREAD
+#include "../../link/condvar"
+#endif
+
+/// 并发队列
+namespace xylu::xyconc
+{
+    /**
+     * @brief 有界无锁的单生产者单消费者 (SPSC) 环形队列
+     *
+     * @tparam T 元素类型。T 必须满足可无异常析构的要求 (is_nothrow_destructible)。
+     *
+     * @details
+     *   容量向上取整为 2 的幂，下标为自由增长的计数器，通过掩码定位槽位。
+     *   生产者与消费者的下标各自独占一个缓存行，并各自缓存对方的下标，
+     *   仅在缓存值显示队列已满 (或已空) 时才读取对方的原子下标，以减少缓存行的来回传递。
+     *
+     *   ### 接口:
+     *   - `push` / `pop`: 单个元素的入队与出队。
+     *   - `push_n` / `pop_n`: 批量入队与出队，只发布一次下标。
+     *   - `reserve` / `commit`: 零拷贝入队，在队列内存中直接构造元素后发布。
+     *   - `peek` / `consume`: 零拷贝出队，直接访问队列内存中的元素后释放。
+     *
+     * @note 生产者接口 (push/push_n/reserve/commit) 只能由同一个线程调用，
+     *       消费者接口 (pop/pop_n/peek/consume) 只能由另一个线程调用。
+     * @note 内存通过底层分配器分配，可以在任意线程析构。
+     */
+    template <typename T>
+    class alignas(xyu::K_CACHE_LINE_SIZE) SpscRing : xyu::class_no_copy_move_t
+    {
+        static_assert(xyu::t_can_nothrow_destruct<T>);
+
+    private:
+        T* buf;                 // 环形缓冲区
+        xyu::size_t mask;       // 容量 - 1
+
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::size_t> wi{0};    // 写下标 (生产者)
+        xyu::size_t rcache{0};                                              // 读下标缓存 (生产者)
+
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::size_t> ri{0};    // 读下标 (消费者)
+        xyu::size_t wcache{0};                                              // 写下标缓存 (消费者)
+
+    public:
+        /* 构造析构 */
+
+        /**
+         * @brief 构造
+         * @param capa 最小容量 (向上取整为 2 的幂)
+         * @exception E_Logic_Invalid_Argument 容量为 0
+         * @exception E_Memory_Capacity 容量超出限制
+         */
+        explicit SpscRing(xyu::size_t capa) : buf{}, mask{}
+        {
+            if (XY_UNLIKELY(capa == 0)) {
+                xyloge(false, "E_Logic_Invalid_Argument: capacity of SpscRing cannot be 0");
+                throw xyu::E_Logic_Invalid_Argument{};
+            }
+            if (XY_UNLIKELY(capa > limit())) {
+                xyloge(false, "E_Memory_Capacity: capacity {} over limit {}", capa, limit());
+                throw xyu::E_Memory_Capacity{};
+            }
+            xyu::size_t c = 1;
+            while (c < capa) c <<= 1;
+            buf = xyu::alloc<T>(xyu::native_v, c, xyu::max(alignof(T), xyu::K_CACHE_LINE_SIZE));
+            mask = c - 1;
+        }
+
+        /// 析构 (析构队列中剩余的元素)
+        ~SpscRing() noexcept
+        {
+            xyu::size_t w = wi.load(xyu::N_ATOMIC_ACQUIRE);
+            for (xyu::size_t r = ri.load(xyu::N_ATOMIC_RELAXED); r != w; ++r) buf[r & mask].~T();
+            xyu::dealloc<T>(xyu::native_v, buf);
+        }
+
+        /* 数据容量 */
+
+        /// 获取最大容量
+        constexpr static xyu::size_t limit() noexcept { return xyu::number_traits<xyu::size_t>::max / 2 / sizeof(T); }
+        /// 获取容量
+        xyu::size_t capacity() const noexcept { return mask + 1; }
+        /// 获取元素数量 (并发时仅为近似值)
+        xyu::size_t count() const noexcept
+        {
+            xyu::size_t r = ri.load(xyu::N_ATOMIC_ACQUIRE);
+            return wi.load(xyu::N_ATOMIC_ACQUIRE) - r;
+        }
+        /// 是否为空 (并发时仅为近似值)
+        bool empty() const noexcept { return count() == 0; }
+
+        /* 生产者 */
+
+        /**
+         * @brief 入队 (通过 args 构造元素)
+         * @return 队列已满时返回 false
+         */
+        template <typename... Args>
+        bool push(Args&&... args) noexcept(xyu::t_can_nothrow_init<T, Args...>)
+        {
+            xyu::size_t w = wi.load(xyu::N_ATOMIC_RELAXED);
+            if (XY_UNLIKELY(w - rcache > mask)) {
+                rcache = ri.load(xyu::N_ATOMIC_ACQUIRE);
+                if (w - rcache > mask) return false;
+            }
+            place_init(buf + (w & mask), xyu::forward<Args>(args)...);
+            wi.store(w + 1, xyu::N_ATOMIC_RELEASE);
+            return true;
+        }
+
+        /**
+         * @brief 批量入队
+         * @details 按顺序入队范围中的元素，直到范围结束或队列已满，所有元素只发布一次
+         * @return 入队的元素数量 (即范围中前若干个元素)
+         * @note 若构造元素时抛出异常，则已构造的元素仍会发布
+         */
+        template <typename Rg, xyu::t_enable<xyu::t_is_range<Rg>, bool> = true>
+        xyu::size_t push_n(Rg&& range)
+        {
+            xyu::size_t w = wi.load(xyu::N_ATOMIC_RELAXED);
+            xyu::size_t k = xyu::min(range.count(), free_count(w, range.count()));
+            xyu::size_t i = 0;
+            try {
+                for (auto&& v : range) {
+                    if (i == k) break;
+                    place_init(buf + ((w + i) & mask), xyu::forward<decltype(v)>(v));
+                    ++i;
+                }
+            }
+            catch (...) { wi.store(w + i, xyu::N_ATOMIC_RELEASE); throw; }
+            wi.store(w + i, xyu::N_ATOMIC_RELEASE);
+            return i;
+        }
+
+        /**
+         * @brief 预留连续的空闲槽位 (零拷贝入队)
+         * @param count [输入] 希望预留的数量 [输出] 实际预留的数量 (受空闲数量及缓冲区末尾限制)
+         * @return 预留槽位的起始地址 (未初始化内存)，无空闲槽位时返回 nullptr
+         * @note 在返回的内存上构造元素后，调用 commit 发布
+         */
+        T* reserve(xyu::size_t& count) noexcept
+        {
+            xyu::size_t w = wi.load(xyu::N_ATOMIC_RELAXED);
+            xyu::size_t pos = w & mask;
+            count = xyu::min(free_count(w, count), mask + 1 - pos, count);
+            return count ? buf + pos : nullptr;
+        }
+        /**
+         * @brief 预留一个空闲槽位 (零拷贝入队)
+         * @return 槽位地址 (未初始化内存)，队列已满时返回 nullptr
+         * @note 在返回的内存上构造元素后，调用 commit 发布
+         */
+        T* reserve() noexcept { xyu::size_t count = 1; return reserve(count); }
+
+        /// 发布 reserve 预留并已构造的 count(默认为1) 个元素
+        void commit(xyu::size_t count = 1) noexcept
+        { wi.store(wi.load(xyu::N_ATOMIC_RELAXED) + count, xyu::N_ATOMIC_RELEASE); }
+
+        /* 消费者 */
+
+        /**
+         * @brief 出队 (移动赋值到 out)
+         * @return 队列为空时返回 false
+         */
+        bool pop(T& out) noexcept(xyu::t_can_nothrow_mvassign<T>)
+        {
+            xyu::size_t r = ri.load(xyu::N_ATOMIC_RELAXED);
+            if (XY_UNLIKELY(r == wcache)) {
+                wcache = wi.load(xyu::N_ATOMIC_ACQUIRE);
+                if (r == wcache) return false;
+            }
+            T& e = buf[r & mask];
+            out = xyu::move(e);
+            e.~T();
+            ri.store(r + 1, xyu::N_ATOMIC_RELEASE);
+            return true;
+        }
+
+        /**
+         * @brief 批量出队
+         * @details 依次以右值调用 f(T&&) 处理至多 max 个元素，所有槽位只释放一次
+         * @return 出队的元素数量
+         * @note 若 f 抛出异常，则包括当前元素在内的已处理元素均视为已出队
+         */
+        template <typename Fun>
+        xyu::size_t pop_n(Fun&& f, xyu::size_t max = -1)
+        {
+            xyu::size_t r = ri.load(xyu::N_ATOMIC_RELAXED);
+            xyu::size_t k = xyu::min(max, used_count(r, max));
+            for (xyu::size_t i = 0; i < k; ++i)
+            {
+                T& e = buf[(r + i) & mask];
+                try { f(xyu::move(e)); }
+                catch (...) {
+                    e.~T();
+                    ri.store(r + i + 1, xyu::N_ATOMIC_RELEASE);
+                    throw;
+                }
+                e.~T();
+            }
+            ri.store(r + k, xyu::N_ATOMIC_RELEASE);
+            return k;
+        }
+
+        /**
+         * @brief 获取连续的可读元素 (零拷贝出队)
+         * @param count [输入] 希望读取的数量 [输出] 实际可读的数量 (受元素数量及缓冲区末尾限制)
+         * @return 可读元素的起始地址，队列为空时返回 nullptr
+         * @note 处理完成后，调用 consume 析构并释放槽位
+         */
+        T* peek(xyu::size_t& count) noexcept
+        {
+            xyu::size_t r = ri.load(xyu::N_ATOMIC_RELAXED);
+            xyu::size_t pos = r & mask;
+            count = xyu::min(used_count(r, count), mask + 1 - pos, count);
+            return count ? buf + pos : nullptr;
+        }
+        /**
+         * @brief 获取队首元素 (零拷贝出队)
+         * @return 队首元素地址，队列为空时返回 nullptr
+         * @note 处理完成后，调用 consume 析构并释放槽位
+         */
+        T* peek() noexcept { xyu::size_t count = 1; return peek(count); }
+
+        /// 析构并释放 peek 获取的 count(默认为1) 个元素
+        void consume(xyu::size_t count = 1) noexcept
+        {
+            xyu::size_t r = ri.load(xyu::N_ATOMIC_RELAXED);
+            for (xyu::size_t i = 0; i < count; ++i) buf[(r + i) & mask].~T();
+            ri.store(r + count, xyu::N_ATOMIC_RELEASE);
+        }
+
+    private:
+        // 就地构造新元素
+        template <typename... Args>
+        static void place_init(void* p, Args&&... args) noexcept(xyu::t_can_nothrow_init<T, Args...>)
+        {
+            if constexpr (xyu::t_is_aggregate<T>) ::new (p) T{xyu::forward<Args>(args)...};
+            else ::new (p) T(xyu::forward<Args>(args)...);
+        }
+
+        // 空闲槽位数量 (缓存不足 want 时重新读取读下标)
+        xyu::size_t free_count(xyu::size_t w, xyu::size_t want) noexcept
+        {
+            xyu::size_t fr = mask + 1 - (w - rcache);
+            if (fr >= want) return fr;
+            rcache = ri.load(xyu::N_ATOMIC_ACQUIRE);
+            return mask + 1 - (w - rcache);
+        }
+        // 可读元素数量 (缓存不足 want 时重新读取写下标)
+        xyu::size_t used_count(xyu::size_t r, xyu::size_t want) noexcept
+        {
+            xyu::size_t us = wcache - r;
+            if (us >= want) return us;
+            wcache = wi.load(xyu::N_ATOMIC_ACQUIRE);
+            return wcache - r;
+        }
+    };
+
+    /**
+     * @brief 有界无锁的多生产者多消费者 (MPMC) 队列
+     *
+     * @tparam T 元素类型。T 必须满足可无异常析构、可无异常移动构造及移动赋值的要求。
+     *
+     * @details
+     *   基于每个槽位的序号实现 (Vyukov 算法)，容量向上取整为 2 的幂。
+     *   槽位序号等于写下标时表示可写，等于写下标 + 1 时表示可读，
+     *   生产者与消费者分别通过 CAS 抢占写下标与读下标，取得槽位后独占地构造或析构元素，
+     *   再发布槽位的序号，因此不同槽位上的操作完全并行。
+     *
+     *   ### 接口:
+     *   - `try_push` / `try_pop`: 非阻塞的入队与出队，队列满(或空)时立即返回 false。
+     *   - `try_push_n` / `try_pop_n`: 批量入队与出队，一次 CAS 抢占多个连续槽位。
+     *   - `push` / `pop`: 阻塞的入队与出队，短暂自旋后挂起等待 (XY_UNTHREAD 下不可用)。
+     *
+     * @note 若构造元素可能抛出异常，则先在队列外构造临时对象，抢占槽位后再移动进入，
+     *       以保证已抢占的槽位总能被发布。
+     * @note 仅在有线程挂起时，成功的操作才会获取锁进行唤醒。
+     */
+    template <typename T>
+    class alignas(xyu::K_CACHE_LINE_SIZE) MpmcQueue : xyu::class_no_copy_move_t
+    {
+        static_assert(xyu::t_can_nothrow_destruct<T>);
+        static_assert(xyu::t_can_nothrow_mvconstr<T>);
+        static_assert(xyu::t_can_nothrow_mvassign<T>);
+
+    private:
+        // 槽位
+        struct Cell
+        {
+            xyu::Atomic<xyu::size_t> seq;           // 序号
+            alignas(T) xyu::uint8 data[sizeof(T)];  // 元素存储
+
+            T* get() noexcept { return reinterpret_cast<T*>(data); }
+        };
+
+        // 阻塞操作挂起前的自旋次数
+        constexpr static int K_spin_count = 64;
+
+        Cell* cells;            // 槽位数组
+        xyu::size_t mask;       // 容量 - 1
+
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::size_t> wpos{0};  // 写下标
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::size_t> rpos{0};  // 读下标
+#if !XY_UNTHREAD
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::uint32> pwait{0}; // 挂起的生产者数量
+        xyu::Atomic<xyu::uint32> cwait{0};                                  // 挂起的消费者数量
+        xyu::Mutex m;                                                       // 挂起使用的锁
+        xyu::CondVar pcv;                                                   // 未满通知
+        xyu::CondVar ccv;                                                   // 非空通知
+#endif
+
+    public:
+        /* 构造析构 */
+
+        /**
+         * @brief 构造
+         * @param capa 最小容量 (向上取整为 2 的幂)
+         * @exception E_Logic_Invalid_Argument 容量为 0
+         * @exception E_Memory_Capacity 容量超出限制
+         */
+        explicit MpmcQueue(xyu::size_t capa) : cells{}, mask{}
+        {
+            if (XY_UNLIKELY(capa == 0)) {
+                xyloge(false, "E_Logic_Invalid_Argument: capacity of MpmcQueue cannot be 0");
+                throw xyu::E_Logic_Invalid_Argument{};
+            }
+            if (XY_UNLIKELY(capa > limit())) {
+                xyloge(false, "E_Memory_Capacity: capacity {} over limit {}", capa, limit());
+                throw xyu::E_Memory_Capacity{};
+            }
+            xyu::size_t c = 1;
+            while (c < capa) c <<= 1;
+            cells = xyu::alloc<Cell>(xyu::native_v, c, xyu::max(alignof(Cell), xyu::K_CACHE_LINE_SIZE));
+            for (xyu::size_t i = 0; i < c; ++i) ::new (cells + i) Cell{i, {}};
+            mask = c - 1;
+        }
+
+        /// 析构 (析构队列中剩余的元素)
+        ~MpmcQueue() noexcept
+        {
+            xyu::size_t w = wpos.load(xyu::N_ATOMIC_ACQUIRE);
+            for (xyu::size_t r = rpos.load(xyu::N_ATOMIC_RELAXED); r != w; ++r) cells[r & mask].get()->~T();
+            xyu::dealloc<Cell>(xyu::native_v, cells);
+        }
+
+        /* 数据容量 */
+
+        /// 获取最大容量
+        constexpr static xyu::size_t limit() noexcept { return xyu::number_traits<xyu::size_t>::max / 2 / sizeof(Cell); }
+        /// 获取容量
+        xyu::size_t capacity() const noexcept { return mask + 1; }
+        /// 获取元素数量 (并发时仅为近似值)
+        xyu::size_t count() const noexcept
+        {
+            xyu::size_t r = rpos.load(xyu::N_ATOMIC_ACQUIRE);
+            xyu::size_t w = wpos.load(xyu::N_ATOMIC_ACQUIRE);
+            return w > r ? xyu::min(w - r, mask + 1) : 0;
+        }
+        /// 是否为空 (并发时仅为近似值)
+        bool empty() const noexcept { return count() == 0; }
+
+        /* 非阻塞操作 */
+
+        /**
+         * @brief 尝试入队 (通过 args 构造元素)
+         * @return 队列已满时返回 false
+         * @note 若可通过 args 无异常构造元素，则入队失败时 args 不会被移动
+         */
+        template <typename... Args>
+        bool try_push(Args&&... args) noexcept(xyu::t_can_nothrow_init<T, Args...>)
+        {
+            if constexpr (xyu::t_can_nothrow_init<T, Args...>)
+            {
+                if (!push_help(xyu::forward<Args>(args)...)) return false;
+                wake<true>(1);
+                return true;
+            }
+            else
+            {
+                alignas(T) xyu::uint8 tb[sizeof(T)];
+                T* tp = reinterpret_cast<T*>(tb);
+                place_init(tp, xyu::forward<Args>(args)...);
+                bool ret = try_push(xyu::move(*tp));
+                tp->~T();
+                return ret;
+            }
+        }
+
+        /**
+         * @brief 尝试出队 (移动赋值到 out)
+         * @return 队列为空时返回 false
+         */
+        bool try_pop(T& out) noexcept
+        {
+            if (!pop_help([&](T& e) noexcept { out = xyu::move(e); })) return false;
+            wake<false>(1);
+            return true;
+        }
+
+        /**
+         * @brief 尝试批量入队
+         * @details 一次抢占至多 range.count() 个连续的空闲槽位，按顺序入队范围中前若干个元素
+         * @return 入队的元素数量
+         * @note 若构造元素可能抛出异常，则退化为逐个 try_push
+         */
+        template <typename Rg, xyu::t_enable<xyu::t_is_range<Rg>, bool> = true>
+        xyu::size_t try_push_n(Rg&& range)
+        {
+            if constexpr (xyu::t_can_nothrow_init<T, decltype(*range.begin())>)
+            {
+                xyu::size_t pos, k = claim_n<true>(range.count(), pos);
+                if (k == 0) return 0;
+                xyu::size_t i = 0;
+                for (auto&& v : range) {
+                    if (i == k) break;
+                    place_init(cells[(pos + i) & mask].get(), xyu::forward<decltype(v)>(v));
+                    ++i;
+                }
+                for (i = 0; i < k; ++i) cells[(pos + i) & mask].seq.store(pos + i + 1, xyu::N_ATOMIC_RELEASE);
+                wake<true>(k);
+                return k;
+            }
+            else
+            {
+                xyu::size_t i = 0;
+                for (auto&& v : range) {
+                    if (!try_push(xyu::forward<decltype(v)>(v))) break;
+                    ++i;
+                }
+                return i;
+            }
+        }
+
+        /**
+         * @brief 尝试批量出队
+         * @details 一次抢占至多 max 个连续的可读槽位，依次以右值调用 f(T&&) 处理
+         * @return 出队的元素数量
+         * @note 若 f 抛出异常，则本次抢占的剩余元素会被直接析构 (丢弃)，再重新抛出异常
+         */
+        template <typename Fun>
+        xyu::size_t try_pop_n(Fun&& f, xyu::size_t max = -1)
+        {
+            xyu::size_t pos, k = claim_n<false>(max, pos);
+            if (k == 0) return 0;
+            xyu::size_t i = 0;
+            try {
+                for (; i < k; ++i) {
+                    T* p = cells[(pos + i) & mask].get();
+                    f(xyu::move(*p));
+                    p->~T();
+                }
+            }
+            catch (...) {
+                for (; i < k; ++i) cells[(pos + i) & mask].get()->~T();
+                release_n(pos, k);
+                throw;
+            }
+            release_n(pos, k);
+            return k;
+        }
+
+#if !XY_UNTHREAD
+        /* 阻塞操作 */
+
+        /**
+         * @brief 入队 (通过 args 构造元素)，队列已满时挂起等待
+         * @exception E_Mutex_* 挂起等待时出错
+         */
+        template <typename... Args>
+        void push(Args&&... args)
+        {
+            if constexpr (xyu::t_can_nothrow_init<T, Args...>)
+                block<true>([&]() noexcept { return push_help(xyu::forward<Args>(args)...); });
+            else
+            {
+                alignas(T) xyu::uint8 tb[sizeof(T)];
+                T* tp = reinterpret_cast<T*>(tb);
+                place_init(tp, xyu::forward<Args>(args)...);
+                try { block<true>([&]() noexcept { return push_help(xyu::move(*tp)); }); }
+                catch (...) { tp->~T(); throw; }
+                tp->~T();
+            }
+        }
+
+        /**
+         * @brief 出队 (移动赋值到 out)，队列为空时挂起等待
+         * @exception E_Mutex_* 挂起等待时出错
+         */
+        void pop(T& out) { block<false>([&]() noexcept { return pop_help([&](T& e) noexcept { out = xyu::move(e); }); }); }
+
+        /**
+         * @brief 出队，队列为空时挂起等待
+         * @exception E_Mutex_* 挂起等待时出错
+         */
+        T pop()
+        {
+            alignas(T) xyu::uint8 tb[sizeof(T)];
+            T* tp = reinterpret_cast<T*>(tb);
+            block<false>([&]() noexcept { return pop_help([&](T& e) noexcept { ::new (tp) T(xyu::move(e)); }); });
+            T ret(xyu::move(*tp));
+            tp->~T();
+            return ret;
+        }
+#endif
+
+    private:
+        // 就地构造新元素
+        template <typename... Args>
+        static void place_init(void* p, Args&&... args) noexcept(xyu::t_can_nothrow_init<T, Args...>)
+        {
+            if constexpr (xyu::t_is_aggregate<T>) ::new (p) T{xyu::forward<Args>(args)...};
+            else ::new (p) T(xyu::forward<Args>(args)...);
+        }
+
+        // 抢占一个槽位 (Write: 可写槽位，否则可读槽位)，失败返回 nullptr
+        template <bool Write>
+        Cell* claim() noexcept
+        {
+            xyu::Atomic<xyu::size_t>& at = Write ? wpos : rpos;
+            xyu::size_t pos = at.load(xyu::N_ATOMIC_RELAXED);
+            for (;;)
+            {
+                Cell* c = cells + (pos & mask);
+                xyu::size_t seq = c->seq.load(xyu::N_ATOMIC_ACQUIRE);
+                auto diff = static_cast<xyu::diff_t>(seq - (Write ? pos : pos + 1));
+                if (diff == 0) {
+                    if (at.compare_exchange_weak(pos, pos + 1, xyu::N_ATOMIC_RELAXED)) return c;
+                }
+                else if (diff < 0) return nullptr;
+                pos = at.load(xyu::N_ATOMIC_RELAXED);
+            }
+        }
+
+        // 抢占至多 want 个连续槽位，返回抢占的数量，pos 为起始下标
+        template <bool Write>
+        xyu::size_t claim_n(xyu::size_t want, xyu::size_t& pos) noexcept
+        {
+            xyu::Atomic<xyu::size_t>& at = Write ? wpos : rpos;
+            want = xyu::min(want, mask + 1);
+            pos = at.load(xyu::N_ATOMIC_RELAXED);
+            for (;;)
+            {
+                // 序号匹配的连续槽位只能由抢占下标成功的线程修改，统计后保持有效
+                xyu::size_t k = 0;
+                for (; k < want; ++k) {
+                    xyu::size_t seq = cells[(pos + k) & mask].seq.load(xyu::N_ATOMIC_ACQUIRE);
+                    if (seq != (Write ? pos + k : pos + k + 1)) break;
+                }
+                if (k > 0) {
+                    if (at.compare_exchange_weak(pos, pos + k, xyu::N_ATOMIC_RELAXED)) return k;
+                }
+                else {
+                    xyu::size_t seq = cells[pos & mask].seq.load(xyu::N_ATOMIC_ACQUIRE);
+                    if (static_cast<xyu::diff_t>(seq - (Write ? pos : pos + 1)) < 0) return 0;
+                }
+                pos = at.load(xyu::N_ATOMIC_RELAXED);
+            }
+        }
+
+        // 入队一个元素 (不唤醒对端)
+        template <typename... Args>
+        bool push_help(Args&&... args) noexcept
+        {
+            Cell* c = claim<true>();
+            if (!c) return false;
+            place_init(c->get(), xyu::forward<Args>(args)...);
+            // 序号由 pos 变为 pos + 1，表示可读
+            c->seq.store(c->seq.load(xyu::N_ATOMIC_RELAXED) + 1, xyu::N_ATOMIC_RELEASE);
+            return true;
+        }
+
+        // 出队一个元素，通过 f(T&) 取出 (不唤醒对端)
+        template <typename Fun>
+        bool pop_help(Fun&& f) noexcept
+        {
+            Cell* c = claim<false>();
+            if (!c) return false;
+            f(*c->get());
+            c->get()->~T();
+            // 序号由 pos + 1 变为 pos + 容量，表示下一轮可写
+            c->seq.store(c->seq.load(xyu::N_ATOMIC_RELAXED) + mask, xyu::N_ATOMIC_RELEASE);
+            return true;
+        }
+
+        // 释放 try_pop_n 抢占的 k 个槽位
+        void release_n(xyu::size_t pos, xyu::size_t k) noexcept
+        {
+            for (xyu::size_t i = 0; i < k; ++i) cells[(pos + i) & mask].seq.store(pos + i + mask + 1, xyu::N_ATOMIC_RELEASE);
+            wake<false>(k);
+        }
+
+        // 唤醒挂起的对端线程 (Write: 唤醒消费者，否则唤醒生产者)
+        template <bool Write>
+        void wake(xyu::size_t n [[maybe_unused]]) noexcept
+        {
+#if !XY_UNTHREAD
+            // 与 block 中的屏障配对：要么对端看到本次发布，要么本线程看到对端挂起
+            xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+            if (XY_LIKELY((Write ? cwait : pwait).load(xyu::N_ATOMIC_RELAXED) == 0)) return;
+            try {
+                auto g = m.guard();
+                if (n == 1) (Write ? ccv : pcv).notify_one();
+                else (Write ? ccv : pcv).notify_all();
+            } catch (...) {}
+#endif
+        }
+
+#if !XY_UNTHREAD
+        // 阻塞直到 op() 成功，之后唤醒对端 (Write: 生产者，否则消费者)
+        template <bool Write, typename Op>
+        void block(Op&& op)
+        {
+            for (int i = 0; i < K_spin_count; ++i) if (op()) { wake<Write>(1); return; }
+            xyu::Atomic<xyu::uint32>& wt = Write ? pwait : cwait;
+            xyu::CondVar& cv = Write ? pcv : ccv;
+            {
+                auto g = m.guard();
+                wt.fetch_add(1, xyu::N_ATOMIC_RELAXED);
+                xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+                try { while (!op()) cv.wait(g); }
+                catch (...) { wt.fetch_sub(1, xyu::N_ATOMIC_RELAXED); throw; }
+                wt.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+            }
+            // 唤醒需要获取锁，须在释放锁后进行
+            wake<Write>(1);
+        }
+#endif
+    };
+
+    /**
+     * @brief 无界无锁的多生产者单消费者 (MPSC) 队列
+     *
+     * @tparam T 元素类型。T 必须满足可无异常析构、可无异常移动赋值的要求。
+     *
+     * @details
+     *   基于带哨兵节点的链表实现 (Vyukov 算法)：生产者通过一次原子交换接入尾节点，
+     *   消费者独占地从头部摘取节点，入队和出队均为无等待操作。
+     *
+     *   出队后的节点回收到内部的空闲链表中，入队时优先复用，稳定状态下不再分配内存。
+     *   节点以成倍增长的块分配，空闲链表以 "节点序号 + 版本号" 作为栈顶，避免 ABA 问题。
+     *   节点内存直到队列析构时才释放。
+     *
+     *   ### 接口:
+     *   - `push`: 入队 (任意线程)。
+     *   - `pop` / `drain`: 出队与批量出队 (仅消费者线程)。
+     *   - `wait` / `wait_for` / `wake`: 消费者挂起等待及唤醒 (XY_UNTHREAD 下不可用)。
+     *
+     * @note 仅在消费者挂起时，入队操作才会获取锁进行唤醒。
+     */
+    template <typename T>
+    class MpscQueue : xyu::class_no_copy_move_t
+    {
+        static_assert(xyu::t_can_nothrow_destruct<T>);
+        static_assert(xyu::t_can_nothrow_mvassign<T>);
+
+    private:
+        // 节点
+        struct Node
+        {
+            xyu::Atomic<Node*> next;                // 队列中的下一个节点
+            xyu::Atomic<xyu::uint32> fnext;         // 空闲链表中的下一个节点 (序号 + 1，0 表示无)
+            xyu::uint32 id;                         // 节点序号
+            alignas(T) xyu::uint8 data[sizeof(T)];  // 元素存储
+
+            T* get() noexcept { return reinterpret_cast<T*>(data); }
+        };
+
+        // 首个节点块的节点数量 (之后每块翻倍)
+        constexpr static xyu::uint32 K_chunk_base = 64;
+        // 节点块的最大数量 (保证节点序号不超过 uint32)
+        constexpr static xyu::size_t K_chunk_max = 26;
+
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<Node*> tail;           // 队列尾节点 (生产者)
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::uint64> ftop{0};  // 空闲链表栈顶 (高 32 位版本号，低 32 位序号 + 1)
+        alignas(xyu::K_CACHE_LINE_SIZE) Node* head;                         // 哨兵节点 (消费者)
+        xyu::Atomic<Node*> chunks[K_chunk_max]{};                           // 节点块
+#if !XY_UNTHREAD
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<bool> sleeping{false}; // 消费者是否挂起
+        xyu::Atomic<bool> woken{false};                                     // 是否被 wake 唤醒
+        xyu::Mutex m;                                                       // 挂起使用的锁
+        xyu::CondVar cv;                                                    // 非空通知
+#endif
+
+    public:
+        /* 构造析构 */
+
+        /// 默认构造
+        MpscQueue() : tail{nullptr}, head{nullptr}
+        {
+            head = take();
+            head->next.store(nullptr, xyu::N_ATOMIC_RELAXED);
+            tail.store(head, xyu::N_ATOMIC_RELAXED);
+        }
+
+        /// 析构 (析构队列中剩余的元素)
+        ~MpscQueue() noexcept
+        {
+            for (Node* p = head->next.load(xyu::N_ATOMIC_ACQUIRE); p; p = p->next.load(xyu::N_ATOMIC_ACQUIRE))
+                p->get()->~T();
+            for (auto& c : chunks)
+                if (Node* p = c.load(xyu::N_ATOMIC_RELAXED)) xyu::dealloc<Node>(xyu::native_v, p);
+        }
+
+        /* 数据容量 */
+
+        /// 是否为空 (仅消费者线程的结果准确)
+        bool empty() const noexcept { return head->next.load(xyu::N_ATOMIC_ACQUIRE) == nullptr; }
+
+        /* 生产者 */
+
+        /**
+         * @brief 入队 (通过 args 构造元素)
+         * @exception E_Memory_Capacity 节点数量超出限制
+         * @note 空闲链表为空时才分配新的节点块
+         */
+        template <typename... Args>
+        void push(Args&&... args)
+        {
+            Node* n = take();
+            if constexpr (xyu::t_can_nothrow_init<T, Args...>) place_init(n->get(), xyu::forward<Args>(args)...);
+            else {
+                try { place_init(n->get(), xyu::forward<Args>(args)...); }
+                catch (...) { give(n); throw; }
+            }
+            n->next.store(nullptr, xyu::N_ATOMIC_RELAXED);
+            Node* tn = tail.exchange(n, xyu::N_ATOMIC_ACQ_REL);
+            tn->next.store(n, xyu::N_ATOMIC_RELEASE);
+#if !XY_UNTHREAD
+            // 与 wait 中的屏障配对：要么消费者看到本次入队，要么本线程看到消费者挂起
+            xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+            if (XY_UNLIKELY(sleeping.load(xyu::N_ATOMIC_RELAXED))) notify();
+#endif
+        }
+
+        /* 消费者 */
+
+        /**
+         * @brief 出队 (移动赋值到 out)
+         * @return 队列为空时返回 false
+         * @note 若生产者已交换尾节点但尚未完成链接，该元素暂时不可见
+         */
+        bool pop(T& out) noexcept
+        {
+            Node* n = head->next.load(xyu::N_ATOMIC_ACQUIRE);
+            if (!n) return false;
+            out = xyu::move(*n->get());
+            advance(n);
+            return true;
+        }
+
+        /**
+         * @brief 批量出队
+         * @details 依次以右值调用 f(T&&) 处理至多 max 个元素
+         * @return 出队的元素数量
+         * @note 若 f 抛出异常，则当前元素视为已出队
+         */
+        template <typename Fun>
+        xyu::size_t drain(Fun&& f, xyu::size_t max = -1)
+        {
+            xyu::size_t k = 0;
+            for (; k < max; ++k)
+            {
+                Node* n = head->next.load(xyu::N_ATOMIC_ACQUIRE);
+                if (!n) break;
+                try { f(xyu::move(*n->get())); }
+                catch (...) { advance(n); throw; }
+                advance(n);
+            }
+            return k;
+        }
+
+#if !XY_UNTHREAD
+        /**
+         * @brief 挂起等待，直到队列非空 或 被 wake 唤醒
+         * @exception E_Mutex_* 挂起等待时出错
+         * @note 仅消费者线程调用
+         */
+        void wait()
+        {
+            if (!empty()) return;
+            auto g = m.guard();
+            sleeping.store(true, xyu::N_ATOMIC_RELAXED);
+            xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+            try { cv.wait(g, [this]{ return !empty() || woken.exchange(false, xyu::N_ATOMIC_RELAXED); }); }
+            catch (...) { sleeping.store(false, xyu::N_ATOMIC_RELAXED); throw; }
+            sleeping.store(false, xyu::N_ATOMIC_RELAXED);
+        }
+
+        /**
+         * @brief 挂起等待，直到队列非空 或 被 wake 唤醒 或 超时(从当前时间开始的时间段)
+         * @return 超时返回 false
+         * @exception E_Mutex_* 挂起等待时出错
+         * @note 仅消费者线程调用
+         */
+        template <typename Tp, Tp Scale>
+        bool wait_for(const xyu::Duration<Tp, Scale>& timeout)
+        {
+            if (!empty()) return true;
+            auto g = m.guard();
+            sleeping.store(true, xyu::N_ATOMIC_RELAXED);
+            xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+            bool ret;
+            try { ret = cv.wait_for(g, [this]{ return !empty() || woken.exchange(false, xyu::N_ATOMIC_RELAXED); }, timeout); }
+            catch (...) { sleeping.store(false, xyu::N_ATOMIC_RELAXED); throw; }
+            sleeping.store(false, xyu::N_ATOMIC_RELAXED);
+            return ret;
+        }
+
+        /**
+         * @brief 唤醒挂起的消费者 (如用于结束等待)
+         * @note 若消费者未挂起，则下一次 wait 立即返回
+         */
+        void wake()
+        {
+            auto g = m.guard();
+            woken.store(true, xyu::N_ATOMIC_RELAXED);
+            cv.notify_one();
+        }
+#endif
+
+    private:
+        // 就地构造新元素
+        template <typename... Args>
+        static void place_init(void* p, Args&&... args) noexcept(xyu::t_can_nothrow_init<T, Args...>)
+        {
+            if constexpr (xyu::t_is_aggregate<T>) ::new (p) T{xyu::forward<Args>(args)...};
+            else ::new (p) T(xyu::forward<Args>(args)...);
+        }
+
+        // 消费者前进到节点 n (析构 n 中的元素，n 成为新的哨兵节点，回收旧的哨兵节点)
+        void advance(Node* n) noexcept
+        {
+            n->get()->~T();
+            Node* old = head;
+            head = n;
+            give(old);
+        }
+
+        // 通过序号获取节点
+        Node* node(xyu::uint32 id) const noexcept
+        {
+            xyu::uint32 k = xyu::bit_count_effect(id / K_chunk_base + 1) - 1;
+            xyu::uint32 off = id - K_chunk_base * ((xyu::uint32{1} << k) - 1);
+            return chunks[k].load(xyu::N_ATOMIC_ACQUIRE) + off;
+        }
+
+        // 从空闲链表取出节点 (为空时分配新的节点块)
+        Node* take()
+        {
+            for (;;)
+            {
+                xyu::uint64 t = ftop.load(xyu::N_ATOMIC_ACQUIRE);
+                xyu::uint32 i = static_cast<xyu::uint32>(t);
+                if (i == 0) {
+                    if (Node* n = grow()) return n;
+                    continue;
+                }
+                Node* n = node(i - 1);
+                // 版本号每次修改都增加，即使 n 已被其他线程取出并放回，CAS 也会失败
+                xyu::uint64 nt = ((t >> 32) + 1) << 32 | n->fnext.load(xyu::N_ATOMIC_RELAXED);
+                if (ftop.compare_exchange_weak(t, nt, xyu::N_ATOMIC_ACQUIRE)) return n;
+            }
+        }
+
+        // 将节点链 [first, last] 放回空闲链表
+        void give(Node* first, Node* last) noexcept
+        {
+            for (;;)
+            {
+                xyu::uint64 t = ftop.load(xyu::N_ATOMIC_RELAXED);
+                last->fnext.store(static_cast<xyu::uint32>(t), xyu::N_ATOMIC_RELAXED);
+                xyu::uint64 nt = ((t >> 32) + 1) << 32 | (first->id + 1);
+                if (ftop.compare_exchange_weak(t, nt, xyu::N_ATOMIC_RELEASE)) return;
+            }
+        }
+        // 将节点放回空闲链表
+        void give(Node* n) noexcept { give(n, n); }
+
+        // 分配新的节点块，返回其中一个节点，其余节点放入空闲链表 (与其他线程竞争失败时返回 nullptr)
+        Node* grow()
+        {
+            xyu::size_t k = 0;
+            while (k < K_chunk_max && chunks[k].load(xyu::N_ATOMIC_ACQUIRE)) ++k;
+            if (XY_UNLIKELY(k == K_chunk_max)) {
+                xyloge(false, "E_Memory_Capacity: node count of MpscQueue over limit");
+                throw xyu::E_Memory_Capacity{};
+            }
+            xyu::uint32 cnt = K_chunk_base << k;
+            xyu::uint32 id0 = K_chunk_base * ((xyu::uint32{1} << k) - 1);
+            Node* p = xyu::alloc<Node>(xyu::native_v, cnt);
+            for (xyu::uint32 i = 0; i < cnt; ++i) {
+                ::new (p + i) Node{{nullptr}, {i + 1 < cnt ? id0 + i + 2 : 0}, id0 + i, {}};
+            }
+            if (!chunks[k].compare_exchange_strong(nullptr, p, xyu::N_ATOMIC_RELEASE)) {
+                xyu::dealloc<Node>(xyu::native_v, p);
+                return nullptr;
+            }
+            if (cnt > 1) give(p + 1, p + cnt - 1);
+            return p;
+        }
+
+#if !XY_UNTHREAD
+        // 唤醒挂起的消费者
+        void notify() noexcept
+        {
+            try {
+                auto g = m.guard();
+                cv.notify_one();
+            } catch (...) {}
+        }
+#endif
+    };
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,144 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/atomic"
+#include "../../link/memfun"
+
+/// 顺序锁
+namespace xylu::xyconc
+{
+    /**
+     * @brief 顺序锁 (SeqLock)，用于频繁读取、很少写入的小型数据快照。
+     *
+     * @details
+     *   写者在写入前后各递增一次序号 (写入期间序号为奇数)。
+     *   读者读取序号与数据后重新检查序号，若写者在此期间写入过则重试。
+     *   读者不修改任何共享内存，读取的开销接近一次普通复制，适合限流参数、时钟偏移、计数器等。
+     *
+     *   ### 使用方式:
+     *   - `load()`: 获取数据的一致快照。
+     *   - `store(v)`: 写入新数据。
+     *   - `modify(f)`: 以 f(T&) 原地修改数据 (读-改-写在写者锁内完成)。
+     *
+     * @tparam T 数据类型 (必须可平凡复制)
+     * @note 写者之间通过自旋串行化，写入 (及 modify 中的 f) 应当尽量简短。
+     * @note 写入频繁时读者可能多次重试；数据较大时应使用 `Mutex_RW`。
+     * @note 数据按字存储于原子变量中，读者与写者并发时不会产生数据竞争。
+     */
+    template <typename T>
+    class alignas(xyu::K_CACHE_LINE_SIZE) SeqLock : xyu::class_no_copy_move_t
+    {
+        static_assert(xyu::t_can_trivial_copy<T>, "SeqLock<T> must be a trivially copyable type");
+
+    private:
+        // 存储数据需要的字数
+        constexpr static xyu::size_t K_words = (sizeof(T) + sizeof(xyu::size_t) - 1) / sizeof(xyu::size_t);
+
+        xyu::Atomic<xyu::size_t> seq{0};        // 序号 (奇数表示正在写入)
+        xyu::Atomic<xyu::size_t> buf[K_words];  // 数据
+
+    public:
+        /* 构造 */
+
+        /// 默认构造 (数据值初始化，仅此构造要求 T 可默认构造)
+        SeqLock() noexcept : SeqLock{T{}} {}
+
+        /// 以初始值构造
+        explicit SeqLock(const T& value) noexcept { put(value); }
+
+        /* 读写 */
+
+        /**
+         * @brief 获取数据的一致快照
+         * @note 与写者冲突时重试，不会阻塞写者
+         */
+        T load() const noexcept
+        {
+            xyu::size_t tmp[K_words];
+            for (;;)
+            {
+                xyu::size_t s = seq.load(xyu::N_ATOMIC_ACQUIRE);
+                // 正在写入
+                if (XY_UNLIKELY(s & 1)) { xyu::cpu_pause(); continue; }
+                for (xyu::size_t i = 0; i < K_words; ++i) tmp[i] = buf[i].load(xyu::N_ATOMIC_RELAXED);
+                // 保证数据读取在序号重新检查之前完成
+                xyu::atomic_fence(xyu::N_ATOMIC_ACQUIRE);
+                if (XY_LIKELY(seq.load(xyu::N_ATOMIC_RELAXED) == s)) break;
+            }
+            return from_words(tmp);
+        }
+
+        /// 写入新数据
+        void store(const T& value) noexcept
+        {
+            xyu::size_t s = lock();
+            put(value);
+            unlock(s);
+        }
+
+        /**
+         * @brief 原地修改数据
+         * @param f 以 T& 为参数的修改函数 (在写者锁内执行，期间读者会重试)
+         * @return f 的返回值 (按值返回)
+         * @note f 抛出异常时，已进行的修改仍然生效
+         */
+        template <typename Fun>
+        auto modify(Fun&& f)
+        {
+            static_assert(xyu::t_can_call<Fun, T&>);
+            struct Unlock { SeqLock& sl; T& v; xyu::size_t s; ~Unlock() { sl.put(v); sl.unlock(s); } };
+            xyu::size_t s = lock();
+            // 写者独占，直接读取不会与其他写者冲突
+            T value = get();
+            Unlock u{*this, value, s};
+            return f(value);
+        }
+
+    private:
+        // 写者上锁 (序号设置为奇数)，返回原序号
+        xyu::size_t lock() noexcept
+        {
+            for (;;)
+            {
+                xyu::size_t s = seq.load(xyu::N_ATOMIC_RELAXED);
+                if (XY_LIKELY(!(s & 1)) && seq.compare_exchange_weak(s, s + 1, xyu::N_ATOMIC_ACQUIRE)) {
+                    // 保证序号更新在数据写入之前可见
+                    xyu::atomic_fence(xyu::N_ATOMIC_RELEASE);
+                    return s;
+                }
+                xyu::cpu_pause();
+            }
+        }
+
+        // 写者解锁 (序号设置为下一个偶数)
+        void unlock(xyu::size_t s) noexcept { seq.store(s + 2, xyu::N_ATOMIC_RELEASE); }
+
+        // 写入数据 (仅写者)
+        void put(const T& value) noexcept
+        {
+            xyu::size_t tmp[K_words]{};
+            xyu::mem_copy(tmp, &value, sizeof(T));
+            for (xyu::size_t i = 0; i < K_words; ++i) buf[i].store(tmp[i], xyu::N_ATOMIC_RELAXED);
+        }
+
+        // 读取数据 (仅写者)
+        T get() const noexcept
+        {
+            xyu::size_t tmp[K_words];
+            for (xyu::size_t i = 0; i < K_words; ++i) tmp[i] = buf[i].load(xyu::N_ATOMIC_RELAXED);
+            return from_words(tmp);
+        }
+
+        // 由数据字复制出 T (经过对齐的字节缓冲区，不要求 T 可默认构造)
+        static T from_words(const xyu::size_t* w) noexcept
+        {
+            alignas(T) xyu::uint8 vb[sizeof(T)];
+            xyu::mem_copy(vb, w, sizeof(T));
+            return *reinterpret_cast<const T*>(vb);
+        }
+    };
+}
+
+#pragma clang diagnostic pop
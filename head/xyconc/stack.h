@@ -0,0 +1,156 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/atomic"
+
+/// 并发栈
+namespace xylu::xyconc
+{
+    /**
+     * @brief 无界无锁的多生产者多消费者 (MPMC) 栈
+     *
+     * @tparam T 元素类型。T 必须满足可无异常析构、可无异常移动赋值的要求。
+     *
+     * @details
+     *   基于 Treiber 栈实现：栈顶为 "节点指针 + 版本号" 的 16 字节原子变量 (64 位平台)，
+     *   每次修改栈顶都增加版本号，即使节点被其他线程取出并放回，CAS 也会失败，避免 ABA 问题。
+     *   支持双字 CAS 的平台上 (XY_ATOMIC_DWCAS) 入栈和出栈均为无锁操作，可通过 `is_lock_free()` 查询。
+     *   x86-64 下需要以 -mcx16 编译 (CMake 构建会为 xylu 及其使用者添加)，否则 16 字节的 CAS 由编译器的运行时库实现，不保证无锁。
+     *
+     *   出栈后的节点回收到内部的空闲栈中 (同样带版本号)，入栈时优先复用，稳定状态下不再分配内存。
+     *   节点内存直到栈析构时才释放，因此出栈时读取已被其他线程取出的节点是安全的。
+     *
+     *   ### 接口:
+     *   - `push`: 入栈 (任意线程)。
+     *   - `pop`: 出栈 (任意线程)。
+     */
+    template <typename T>
+    class MpmcStack : xyu::class_no_copy_move_t
+    {
+        static_assert(xyu::t_can_nothrow_destruct<T>);
+        static_assert(xyu::t_can_nothrow_mvassign<T>);
+
+    private:
+        // 节点
+        struct Node
+        {
+            xyu::Atomic<Node*> next;                // 栈中的下一个节点 (可能与其他线程的出栈并发读取)
+            alignas(T) xyu::uint8 data[sizeof(T)];  // 元素存储
+
+            T* get() noexcept { return reinterpret_cast<T*>(data); }
+        };
+
+        // 栈顶 (节点指针 + 版本号)
+        struct Top
+        {
+            Node* p;            // 栈顶节点
+            xyu::size_t tag;    // 版本号
+        };
+
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<Top> top{};    // 元素栈
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<Top> ftop{};   // 空闲栈
+
+    public:
+        /* 构造析构 */
+
+        /// 默认构造
+        MpmcStack() noexcept = default;
+
+        /// 析构 (析构栈中剩余的元素，释放所有节点)
+        ~MpmcStack() noexcept
+        {
+            for (Node* p = top.load(xyu::N_ATOMIC_ACQUIRE).p; p; ) {
+                Node* n = p->next.load(xyu::N_ATOMIC_RELAXED);
+                p->get()->~T();
+                xyu::dealloc<Node>(xyu::native_v, p);
+                p = n;
+            }
+            for (Node* p = ftop.load(xyu::N_ATOMIC_ACQUIRE).p; p; ) {
+                Node* n = p->next.load(xyu::N_ATOMIC_RELAXED);
+                xyu::dealloc<Node>(xyu::native_v, p);
+                p = n;
+            }
+        }
+
+        /* 数据容量 */
+
+        /// 是否为空 (并发时仅为近似值)
+        bool empty() const noexcept { return top.load(xyu::N_ATOMIC_ACQUIRE).p == nullptr; }
+
+        /// 入栈与出栈是否为无锁操作
+        bool is_lock_free() const noexcept { return top.is_lock_free(); }
+
+        /* 操作 */
+
+        /**
+         * @brief 入栈 (通过 args 构造元素)
+         * @exception E_Memory_* 分配节点失败
+         * @note 空闲栈为空时才分配新的节点
+         */
+        template <typename... Args>
+        void push(Args&&... args)
+        {
+            Node* n = unlink(ftop);
+            if (!n) n = xyu::alloc<Node>(xyu::native_v, 1);
+            if constexpr (xyu::t_can_nothrow_init<T, Args...>) place_init(n->get(), xyu::forward<Args>(args)...);
+            else {
+                try { place_init(n->get(), xyu::forward<Args>(args)...); }
+                catch (...) { link(ftop, n); throw; }
+            }
+            link(top, n);
+        }
+
+        /**
+         * @brief 出栈 (移动赋值到 out)
+         * @return 栈为空时返回 false
+         */
+        bool pop(T& out) noexcept
+        {
+            Node* n = unlink(top);
+            if (!n) return false;
+            out = xyu::move(*n->get());
+            n->get()->~T();
+            link(ftop, n);
+            return true;
+        }
+
+    private:
+        // 就地构造新元素
+        template <typename... Args>
+        static void place_init(void* p, Args&&... args) noexcept(xyu::t_can_nothrow_init<T, Args...>)
+        {
+            if constexpr (xyu::t_is_aggregate<T>) ::new (p) T{xyu::forward<Args>(args)...};
+            else ::new (p) T(xyu::forward<Args>(args)...);
+        }
+
+        // 将节点压入栈 s
+        static void link(xyu::Atomic<Top>& s, Node* n) noexcept
+        {
+            Top t = s.load(xyu::N_ATOMIC_RELAXED);
+            for (;;)
+            {
+                n->next.store(t.p, xyu::N_ATOMIC_RELAXED);
+                if (s.compare_exchange_weak(t, Top{n, t.tag + 1}, xyu::N_ATOMIC_RELEASE)) return;
+                t = s.load(xyu::N_ATOMIC_RELAXED);
+            }
+        }
+
+        // 从栈 s 弹出节点 (为空时返回 nullptr)
+        static Node* unlink(xyu::Atomic<Top>& s) noexcept
+        {
+            Top t = s.load(xyu::N_ATOMIC_ACQUIRE);
+            while (t.p)
+            {
+                // t.p 可能已被其他线程弹出并重新压入，此时版本号已改变，CAS 必然失败
+                Top nt{t.p->next.load(xyu::N_ATOMIC_RELAXED), t.tag + 1};
+                if (s.compare_exchange_weak(t, nt, xyu::N_ATOMIC_ACQUIRE)) return t.p;
+                t = s.load(xyu::N_ATOMIC_ACQUIRE);
+            }
+            return nullptr;
+        }
+    };
+}
+
+#pragma clang diagnostic pop
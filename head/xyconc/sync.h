@@ -0,0 +1,352 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "hicpp-exception-baseclass"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/atomic"
+#include "../../link/time"
+#include "../../link/log"
+
+/// 同步原语
+namespace xylu::xyconc
+{
+    namespace __
+    {
+        // 系统时间点转换为 UTC 时间
+        inline xyu::Duration_ns utc_of(const xyu::Calendar& timepoint) noexcept
+        { return xyu::Duration_ns{timepoint - xyu::Calendar{} - xyu::Duration_utcdiff()}; }
+    }
+
+    /**
+     * @brief 计数信号量
+     *
+     * @details
+     *   内部只有一个 32 位计数，获取时计数减一 (为 0 时挂起)，释放时计数增加并唤醒等待线程。
+     *   基于地址等待 (__::wait_addr) 实现，不需要互斥锁，不进行动态分配；没有等待线程时释放不进入内核。
+     *
+     *   ### 使用方式:
+     *   - `acquire()`: 获取一个计数，计数为 0 时挂起等待。
+     *   - `try_acquire()` / `try_acquire_for(du)` / `try_acquire_to(tp)`: 尝试获取 / 超时获取。
+     *   - `release(n)`: 释放 n 个计数。
+     *
+     * @note 不保证等待线程的获取顺序 (非公平)。
+     */
+    class Semaphore : xyu::class_no_copy_move_t
+    {
+    private:
+        xyu::Atomic<xyu::uint32> c;     // 计数
+
+    public:
+        /// 以初始计数构造
+        explicit Semaphore(xyu::uint32 count = 0) noexcept : c{count} {}
+
+        /// 获取当前计数 (并发时仅为近似值)
+        xyu::uint32 count() const noexcept { return c.load(xyu::N_ATOMIC_RELAXED); }
+
+        /// 尝试获取一个计数 (不挂起)
+        bool try_acquire() noexcept
+        {
+            for (xyu::uint32 v = c.load(xyu::N_ATOMIC_RELAXED); v; v = c.load(xyu::N_ATOMIC_RELAXED))
+                if (XY_LIKELY(c.compare_exchange_weak(v, v - 1, xyu::N_ATOMIC_ACQUIRE))) return true;
+            return false;
+        }
+
+        /// 获取一个计数，计数为 0 时挂起等待
+        void acquire() noexcept
+        {
+            if (XY_LIKELY(try_acquire())) return;
+            acquire_help();
+        }
+
+        /**
+         * @brief 获取一个计数，直到超时(从当前时间开始的时间段)
+         * @return 是否获取成功
+         */
+        template <typename T, T Scale>
+        bool try_acquire_for(const xyu::Duration<T, Scale>& timeout) noexcept
+        {
+            if (XY_LIKELY(try_acquire())) return true;
+            if (XY_UNLIKELY(timeout.count <= 0)) return false;
+            return acquire_to_help(xyu::Duration_utc() + xyu::Duration_ns{timeout});
+        }
+
+        /**
+         * @brief 获取一个计数，直到超时(系统时间点)
+         * @return 是否获取成功
+         */
+        bool try_acquire_to(const xyu::Calendar& timepoint) noexcept
+        {
+            if (XY_LIKELY(try_acquire())) return true;
+            return acquire_to_help(__::utc_of(timepoint));
+        }
+
+        /// 释放 n 个计数，并唤醒等待线程
+        void release(xyu::uint32 n = 1) noexcept
+        {
+            if (XY_UNLIKELY(n == 0)) return;
+            c.fetch_add(n, xyu::N_ATOMIC_RELEASE);
+            __::wake_addr(&c, n == 1 ? 1 : __::K_wake_all);
+        }
+
+    private:
+        // 挂起等待获取
+        void acquire_help() noexcept;
+        // 挂起等待获取 (UTC 时间点)
+        bool acquire_to_help(xyu::Duration_ns utc) noexcept;
+    };
+
+    /**
+     * @brief 一次性倒计时门闩
+     *
+     * @details
+     *   以初始计数构造，各线程通过 `count_down()` 减少计数，计数减为 0 时唤醒所有等待线程。
+     *   计数归零后不可重置，之后的等待立即返回；需要重复使用时请使用 `Barrier`。
+     *
+     *   ### 使用方式:
+     *   - `count_down(n)`: 减少计数。
+     *   - `wait()` / `wait_for(du)` / `wait_to(tp)`: 等待计数归零。
+     *   - `arrive_and_wait(n)`: 减少计数后等待计数归零。
+     */
+    class Latch : xyu::class_no_copy_move_t
+    {
+    private:
+        xyu::Atomic<xyu::uint32> c;     // 剩余计数
+
+    public:
+        /// 以初始计数构造
+        explicit Latch(xyu::uint32 count) noexcept : c{count} {}
+
+        /**
+         * @brief 减少计数，归零时唤醒所有等待线程
+         * @exception E_Logic_Invalid_Argument n 大于剩余计数
+         */
+        void count_down(xyu::uint32 n = 1)
+        {
+            xyu::uint32 v = c.load(xyu::N_ATOMIC_RELAXED);
+            for (;;)
+            {
+                if (XY_UNLIKELY(n > v)) {
+                    xyloge(false, "E_Logic_Invalid_Argument: count down {} over remaining count {} of Latch", n, v);
+                    throw xyu::E_Logic_Invalid_Argument{};
+                }
+                if (XY_LIKELY(c.compare_exchange_weak(v, v - n, xyu::N_ATOMIC_ACQ_REL))) break;
+                v = c.load(xyu::N_ATOMIC_RELAXED);
+            }
+            if (v == n) __::wake_addr(&c, __::K_wake_all);
+        }
+
+        /// 计数是否已归零
+        bool try_wait() const noexcept { return c.load(xyu::N_ATOMIC_ACQUIRE) == 0; }
+
+        /// 等待计数归零
+        void wait() const noexcept
+        {
+            if (XY_LIKELY(try_wait())) return;
+            wait_help();
+        }
+
+        /**
+         * @brief 等待计数归零，直到超时(从当前时间开始的时间段)
+         * @return 计数是否已归零
+         */
+        template <typename T, T Scale>
+        bool wait_for(const xyu::Duration<T, Scale>& timeout) const noexcept
+        {
+            if (XY_LIKELY(try_wait())) return true;
+            if (XY_UNLIKELY(timeout.count <= 0)) return false;
+            return wait_to_help(xyu::Duration_utc() + xyu::Duration_ns{timeout});
+        }
+
+        /**
+         * @brief 等待计数归零，直到超时(系统时间点)
+         * @return 计数是否已归零
+         */
+        bool wait_to(const xyu::Calendar& timepoint) const noexcept
+        {
+            if (XY_LIKELY(try_wait())) return true;
+            return wait_to_help(__::utc_of(timepoint));
+        }
+
+        /**
+         * @brief 减少计数后等待计数归零
+         * @exception E_Logic_Invalid_Argument n 大于剩余计数
+         */
+        void arrive_and_wait(xyu::uint32 n = 1)
+        {
+            count_down(n);
+            wait();
+        }
+
+    private:
+        // 挂起等待计数归零
+        void wait_help() const noexcept;
+        // 挂起等待计数归零 (UTC 时间点)
+        bool wait_to_help(xyu::Duration_ns utc) const noexcept;
+    };
+
+    /**
+     * @brief 可重复使用的线程屏障
+     *
+     * @details
+     *   固定数量的线程在每个阶段都到达屏障后，所有线程一起进入下一阶段。
+     *   内部只有一个 32 位字: 高 16 位为阶段序号，低 16 位为当前阶段已到达的线程数量。
+     *   最后一个到达的线程推进阶段并唤醒所有等待线程。
+     *
+     *   ### 使用方式:
+     *   - `arrive_and_wait()`: 到达并等待当前阶段完成。
+     *   - `arrive()`: 到达但不等待，返回阶段令牌；之后通过 `wait(token)` / `wait_for(token, du)` 等待。
+     *
+     * @note 每个线程在一个阶段内只能到达一次 (阶段完成前不能再次 arrive)。
+     */
+    class Barrier : xyu::class_no_copy_move_t
+    {
+    public:
+        /// 阶段令牌
+        using Token = xyu::uint32;
+
+        /// 最大线程数量
+        static constexpr xyu::uint32 K_max_count = 0xFFFF;
+
+    private:
+        xyu::Atomic<xyu::uint32> w{0};  // 阶段序号 << 16 | 已到达数量
+        xyu::uint32 n;                  // 线程数量
+
+    public:
+        /**
+         * @brief 以线程数量构造
+         * @exception E_Logic_Invalid_Argument 线程数量为 0 或超过 K_max_count
+         */
+        explicit Barrier(xyu::uint32 count) : n{count}
+        {
+            if (XY_UNLIKELY(count == 0 || count > K_max_count)) {
+                xyloge(false, "E_Logic_Invalid_Argument: thread count {} of Barrier is not in [1, {}]", count, K_max_count);
+                throw xyu::E_Logic_Invalid_Argument{};
+            }
+        }
+
+        /// 获取线程数量
+        xyu::uint32 count() const noexcept { return n; }
+
+        /**
+         * @brief 到达屏障 (不等待)
+         * @return 当前阶段的令牌，用于 wait
+         */
+        Token arrive() noexcept
+        {
+            xyu::uint32 v = w.fetch_add(1, xyu::N_ATOMIC_ACQ_REL);
+            Token gen = v >> 16;
+            if ((v & K_max_count) + 1 == n) {
+                // 最后一个到达: 推进阶段 (序号溢出时回绕)
+                w.store((gen + 1) << 16, xyu::N_ATOMIC_RELEASE);
+                __::wake_addr(&w, __::K_wake_all);
+            }
+            return gen;
+        }
+
+        /// 令牌对应的阶段是否已完成
+        bool try_wait(Token token) const noexcept { return (w.load(xyu::N_ATOMIC_ACQUIRE) >> 16) != token; }
+
+        /// 等待令牌对应的阶段完成
+        void wait(Token token) const noexcept
+        {
+            if (try_wait(token)) return;
+            wait_help(token);
+        }
+
+        /**
+         * @brief 等待令牌对应的阶段完成，直到超时(从当前时间开始的时间段)
+         * @return 阶段是否已完成
+         */
+        template <typename T, T Scale>
+        bool wait_for(Token token, const xyu::Duration<T, Scale>& timeout) const noexcept
+        {
+            if (try_wait(token)) return true;
+            if (XY_UNLIKELY(timeout.count <= 0)) return false;
+            return wait_to_help(token, xyu::Duration_utc() + xyu::Duration_ns{timeout});
+        }
+
+        /**
+         * @brief 等待令牌对应的阶段完成，直到超时(系统时间点)
+         * @return 阶段是否已完成
+         */
+        bool wait_to(Token token, const xyu::Calendar& timepoint) const noexcept
+        {
+            if (try_wait(token)) return true;
+            return wait_to_help(token, __::utc_of(timepoint));
+        }
+
+        /// 到达屏障，并等待当前阶段完成
+        void arrive_and_wait() noexcept { wait(arrive()); }
+
+    private:
+        // 挂起等待阶段完成
+        void wait_help(Token token) const noexcept;
+        // 挂起等待阶段完成 (UTC 时间点)
+        bool wait_to_help(Token token, xyu::Duration_ns utc) const noexcept;
+    };
+
+    /**
+     * @brief 一次性事件
+     *
+     * @details
+     *   初始为未触发状态，`set()` 后变为已触发并唤醒所有等待线程，之后的等待立即返回。
+     *   只有第一次 `set()` 会尝试唤醒，重复调用没有额外开销。
+     */
+    class Event : xyu::class_no_copy_move_t
+    {
+    private:
+        xyu::Atomic<xyu::uint32> s{0};  // 是否已触发
+
+    public:
+        /// 构造 (未触发)
+        Event() noexcept = default;
+
+        /// 触发事件，唤醒所有等待线程
+        void set() noexcept
+        {
+            if (s.load(xyu::N_ATOMIC_RELAXED)) return;
+            if (s.exchange(1, xyu::N_ATOMIC_RELEASE) == 0) __::wake_addr(&s, __::K_wake_all);
+        }
+
+        /// 是否已触发
+        bool is_set() const noexcept { return s.load(xyu::N_ATOMIC_ACQUIRE) != 0; }
+
+        /// 等待事件触发
+        void wait() const noexcept
+        {
+            if (XY_LIKELY(is_set())) return;
+            wait_help();
+        }
+
+        /**
+         * @brief 等待事件触发，直到超时(从当前时间开始的时间段)
+         * @return 事件是否已触发
+         */
+        template <typename T, T Scale>
+        bool wait_for(const xyu::Duration<T, Scale>& timeout) const noexcept
+        {
+            if (XY_LIKELY(is_set())) return true;
+            if (XY_UNLIKELY(timeout.count <= 0)) return false;
+            return wait_to_help(xyu::Duration_utc() + xyu::Duration_ns{timeout});
+        }
+
+        /**
+         * @brief 等待事件触发，直到超时(系统时间点)
+         * @return 事件是否已触发
+         */
+        bool wait_to(const xyu::Calendar& timepoint) const noexcept
+        {
+            if (XY_LIKELY(is_set())) return true;
+            return wait_to_help(__::utc_of(timepoint));
+        }
+
+    private:
+        // 挂起等待事件触发
+        void wait_help() const noexcept;
+        // 挂起等待事件触发 (UTC 时间点)
+        bool wait_to_help(xyu::Duration_ns utc) const noexcept;
+    };
+}
+
+#pragma clang diagnostic pop
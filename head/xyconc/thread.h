@@ -19,6 +19,61 @@ namespace xylu::xyconc
         };
     }
 
+    /**
+     * @brief CPU 集合，用于设置线程的 CPU 亲和性。
+     * @details 以位图存储 CPU 编号 [0, K_max_count)，与 Linux 的 cpu_set_t 大小一致。
+     */
+    class CpuSet
+    {
+    public:
+        /// 支持的最大 CPU 数量
+        static constexpr xyu::size_t K_max_count = 1024;
+
+    private:
+        xyu::uint64 bits[K_max_count / 64]{};   // CPU 位图
+
+    public:
+        /// 默认构造 (空集合)
+        constexpr CpuSet() noexcept = default;
+
+        /**
+         * @brief 添加 CPU
+         * @exception E_Logic_Out_Of_Range cpu 超出 K_max_count
+         */
+        CpuSet& set(xyu::size_t cpu);
+
+        /**
+         * @brief 移除 CPU
+         * @exception E_Logic_Out_Of_Range cpu 超出 K_max_count
+         */
+        CpuSet& reset(xyu::size_t cpu);
+
+        /// 是否包含 CPU (超出范围时返回 false)
+        bool test(xyu::size_t cpu) const noexcept
+        { return cpu < K_max_count && (bits[cpu / 64] >> (cpu % 64) & 1); }
+
+        /// 清空集合
+        void clear() noexcept { for (auto& b : bits) b = 0; }
+
+        /// 是否为空集合
+        bool empty() const noexcept
+        {
+            for (auto b : bits) if (b) return false;
+            return true;
+        }
+
+        /// 获取 CPU 数量
+        xyu::size_t count() const noexcept
+        {
+            xyu::size_t n = 0;
+            for (auto b : bits) n += __builtin_popcountll(b);
+            return n;
+        }
+
+        /// 获取位图 (K_max_count / 64 个字，CPU i 对应第 i / 64 个字的第 i % 64 位)
+        const xyu::uint64* data() const noexcept { return bits; }
+    };
+
     /**
      * @brief 一个封装了原生线程句柄的、符合RAII原则的线程类。
      * @details
@@ -27,6 +82,8 @@ namespace xylu::xyconc
      *
      *   一个关键特性是，它的析构函数会自动等待（join）尚未结束的线程，
      *   以防止资源泄露。该类是移动专属的，禁止拷贝。
+     *
+     *   创建时可以通过 `Option` 指定线程属性 (名称、栈大小、栈保护区大小、CPU 亲和性)。
      */
     class Thread_Native : xyu::class_no_copy_t, __::ThreadStatus
     {
@@ -34,6 +91,23 @@ namespace xylu::xyconc
         /// 线程函数类型
         using Fun_t = void(*)(void*);
 
+        /**
+         * @brief 线程属性
+         * @note Linux 下支持全部属性；Windows 下仅支持栈大小与前 64 个 CPU 的亲和性；CYGWIN 下忽略所有属性。
+         */
+        struct Option
+        {
+            /// 使用系统默认值
+            static constexpr xyu::size_t K_default = static_cast<xyu::size_t>(-1);
+
+            const char* name;           ///< 线程名称 (nullptr 为不设置，用于 perf/top 等工具；Linux 下最多保留 15 字节)
+            xyu::size_t stack_size;     ///< 栈大小 (K_default 为系统默认值，Linux 下通常为 8 MiB)
+            xyu::size_t guard_size;     ///< 栈保护区大小 (K_default 为系统默认值，0 为不设置保护区)
+            CpuSet affinity;            ///< CPU 亲和性 (为空时不限制)
+
+            constexpr Option() noexcept : name{nullptr}, stack_size{K_default}, guard_size{K_default}, affinity{} {}
+        };
+
     private:
         void* h = nullptr;      // 线程句柄
         Status s = Uninit;      // 线程状态
@@ -53,6 +127,17 @@ namespace xylu::xyconc
          */
         explicit Thread_Native(Fun_t fun, void* arg = nullptr) { create(fun, arg); }
 
+        /**
+         * @brief 构造并立即以指定属性创建一个新线程来执行指定的函数。
+         * @param op 线程属性。
+         * @param fun 要在新线程中执行的函数。
+         * @param arg 传递给线程函数的参数。
+         * @throws E_Logic_Null_Pointer fun 为 nullptr。
+         * @exception E_Logic_Invalid_Argument 线程状态是 Running 或 Joined
+         * @throws E_Thread_*
+         */
+        Thread_Native(const Option& op, Fun_t fun, void* arg = nullptr) { create(op, fun, arg); }
+
         /**
           * @brief 析构函数。
           * @details 如果线程对象在销毁时仍处于 Running 状态，此析构函数将
@@ -82,7 +167,18 @@ namespace xylu::xyconc
          * @exception E_Logic_Invalid_Argument 线程状态是 Running 或 Joined
          * @throws E_Thread_*
          */
-        void create(Fun_t fun, void* arg = nullptr);
+        void create(Fun_t fun, void* arg = nullptr) { create(Option{}, fun, arg); }
+
+        /**
+         * @brief 在当前线程对象上以指定属性创建并启动一个新线程。
+         * @param op 线程属性。
+         * @param fun 要在新线程中执行的函数。
+         * @param arg 传递给线程函数的参数。
+         * @throws E_Logic_Null_Pointer fun 为 nullptr。
+         * @exception E_Logic_Invalid_Argument 线程状态是 Running 或 Joined，或属性无效 (如栈大小过小)
+         * @throws E_Thread_*
+         */
+        void create(const Option& op, Fun_t fun, void* arg = nullptr);
 
         /**
          * @brief 等待线程结束
@@ -104,6 +200,20 @@ namespace xylu::xyconc
         static void* id() noexcept;
         ///线程让步
         static void yield() noexcept;
+
+        /**
+         * @brief 设置当前线程的 CPU 亲和性
+         * @exception E_Logic_Invalid_Argument cpus 中不包含可用的 CPU
+         * @exception E_Thread 当前平台不支持
+         * @note Windows 下仅使用前 64 个 CPU
+         */
+        static void set_affinity(const CpuSet& cpus);
+
+        /// 获取当前线程正在运行的 CPU 编号 (不支持时返回 -1)
+        static int current_cpu() noexcept;
+
+        /// 获取硬件并发线程数 (至少为 1)
+        static xyu::size_t hardware_count() noexcept;
     };
 
 }
@@ -116,6 +226,9 @@ namespace xylu::xyconc
         // 线程状态基类
         struct ThreadStatus_Base : ThreadStatus
         {
+            // 运行中且有线程在等待 (仅用于状态块内部，任务结束时需要唤醒等待者)
+            static constexpr Status Waited = static_cast<Status>(Detached + 1);
+
             xyu::Atomic<Status> s = Uninit;  // 线程状态
         };
         // 线程状态析构
@@ -174,6 +287,7 @@ namespace xylu::xyconc
      *   调用 `get()` 的线程中被重新抛出。
      * - **非阻塞状态查询:** `status()` 方法可以随时无锁地查询任务的当前状态。
      * - **阻塞式结果获取:** `get<T>()` 方法会阻塞等待任务完成，并返回其结果。
+     * - **事件驱动等待:** 等待者挂起直到任务结束时被唤醒，不进行轮询；`wait_for`/`wait_to` 支持超时。
      *
      * @example
      *   xyu::Thread t([](int x) {
@@ -189,6 +303,11 @@ namespace xylu::xyconc
      */
     class Thread : xyu::class_no_copy_t, __::ThreadStatus
     {
+        friend class ThreadPool;
+    public:
+        /// 线程属性
+        using Option = Thread_Native::Option;
+
     private:
         void* sp = nullptr;     // 线程状态
 
@@ -209,10 +328,20 @@ namespace xylu::xyconc
          * 新创建的线程是分离的 (detached)，`Thread` 对象仅作为该任务的句柄。
          * 如果当前的 `Thread` 对象已经持有一个未完成的任务，旧任务的状态将被安全地销毁。
          */
-        template <typename Fun, typename... Args>
+        template <typename Fun, typename... Args, typename = xyu::t_enable<!xyu::t_is_same<xyu::t_remove_cvref<Fun>, Option>>>
         explicit Thread(Fun&& fun, Args&&... args)
         { create(xyu::forward<Fun>(fun), xyu::forward<Args>(args)...); }
 
+        /**
+         * @brief 以指定线程属性启动一个新的异步任务。
+         * @param op    线程属性。
+         * @param fun   要异步执行的可调用对象。
+         * @param args  要传递给可调用对象的参数。
+         */
+        template <typename Fun, typename... Args>
+        Thread(const Option& op, Fun&& fun, Args&&... args)
+        { create(op, xyu::forward<Fun>(fun), xyu::forward<Args>(args)...); }
+
         /**
          * @brief 析构函数。
          * @details 如果线程对象在销毁时仍处于 Running 状态，此析构函数将
@@ -222,18 +351,13 @@ namespace xylu::xyconc
         {
             if (XY_UNLIKELY(!sp)) return;
             auto& status = *reinterpret_cast<__::ThreadStatus_Del*>(sp);
-            for (;;)
-            {
-                Status s = status.s.load(xyu::N_ATOMIC_ACQUIRE);
-                // 等待
-                if (s > Finished) { xyu::Duration_s{1}.sleep(); continue; }
-                // 析构返回值
-                if (s == Finished && status.dtor) status.dtor(sp);
-                // 释放内存
-                xyu::dealloc(xyu::native_v, sp);
-                sp = nullptr;
-                break;
-            }
+            // 等待
+            wait();
+            // 析构返回值
+            if (status.s.load(xyu::N_ATOMIC_ACQUIRE) == Finished && status.dtor) status.dtor(sp);
+            // 释放内存
+            xyu::dealloc(xyu::native_v, sp);
+            sp = nullptr;
         }
 
         /* 移动 */
@@ -247,7 +371,8 @@ namespace xylu::xyconc
         Status status() const noexcept
         {
             if (XY_UNLIKELY(!sp)) return Uninit;
-            return reinterpret_cast<__::ThreadStatus_Base*>(sp)->s.load(xyu::N_ATOMIC_ACQUIRE);
+            Status s = reinterpret_cast<__::ThreadStatus_Base*>(sp)->s.load(xyu::N_ATOMIC_ACQUIRE);
+            return s == __::ThreadStatus_Base::Waited ? Running : s;
         }
 
         /* 线程管理 */
@@ -263,48 +388,75 @@ namespace xylu::xyconc
          * 此方法会创建一个新的后台线程来执行 `fun(args...)`。
          * 新创建的线程是分离的 (detached)，`Thread` 对象仅作为该任务的句柄。
          */
-        template <typename Fun, typename... Args>
+        template <typename Fun, typename... Args, typename = xyu::t_enable<!xyu::t_is_same<xyu::t_remove_cvref<Fun>, Option>>>
         void create(Fun&& fun, Args&&... args)
+        { create(Option{}, xyu::forward<Fun>(fun), xyu::forward<Args>(args)...); }
+
+        /**
+         * @brief 以指定线程属性启动一个新的异步任务。
+         * @param op    线程属性。
+         * @param fun   要异步执行的可调用对象。
+         * @param args  要传递给可调用对象的参数。
+         * @exception E_Thread_Invalid_State 旧线程正在运行。
+         * @exception E_Logic_Invalid_Argument 属性无效 (如栈大小过小)
+         */
+        template <typename Fun, typename... Args>
+        void create(const Option& op, Fun&& fun, Args&&... args)
         {
-            static_assert(xyu::t_can_call<Fun, Args...>);
-            using ret = xyu::t_get_ret<Fun, Args...>;
-            // 状态检查
-            void* tmp = sp; // (状态缓存，防止丢失)
-            check_status();
-            // 分配新状态
-            using Sta = __::ThreadStatus_Total<ret>;
-            sp = xyu::alloc(xyu::native_v, sizeof(Sta), alignof(Sta));
-            ::new (sp) __::ThreadStatus_Base{{}, Uninit};
-            constexpr auto dtor = xyu::t_is_void<ret> || xyu::t_can_trivial_destruct<ret> ? nullptr : ret_dtor<ret>;
-            reinterpret_cast<__::ThreadStatus_Del*>(sp)->dtor = dtor;
-            // 释放旧状态
-            if (tmp) xyu::dealloc(xyu::native_v, tmp);
+            void* arg = prepare(xyu::forward<Fun>(fun), xyu::forward<Args>(args)...);
             // 线程创建
-            create_help(call_fun<Fun, Args...>, make_arg(xyu::forward<Fun>(fun), xyu::forward<Args>(args)...));
-            reinterpret_cast<__::ThreadStatus_Base*>(sp)->s.store(Running, xyu::N_ATOMIC_RELEASE);
+            try { create_help(op, call_fun<Fun, Args...>, arg); }
+            catch (...) { drop_arg<Fun, Args...>(arg); throw; }
         }
 
         /**
-        * @brief 阻塞等待，直到异步任务完成（成功或失败）。
-        * @param du 轮询等待的间隔时间。
-        * @note 这是一个简单的轮询等待。在任务完成前，它会阻塞当前线程。
-        */
-        void wait(xyu::Duration_ms du = {1000}) noexcept
+         * @brief 阻塞等待，直到异步任务完成（成功或失败）。
+         * @note 等待者挂起，直到任务结束时被唤醒，不进行轮询。
+         */
+        void wait() noexcept
         {
             if (XY_UNLIKELY(!sp)) return;
-            auto& status = *reinterpret_cast<__::ThreadStatus_Del*>(sp);
-            for (;;)
-            {
-                Status s = status.s.load(xyu::N_ATOMIC_ACQUIRE);
-                if (s <= Finished) break;
-                du.sleep();
-            }
+            if (done()) return;
+            wait_help();
+        }
+
+        /**
+         * @brief 阻塞等待，直到异步任务完成（成功或失败）。
+         * @param du 原轮询等待的间隔时间 (已忽略)。
+         * @deprecated 等待不再轮询，请使用 `wait()`。
+         */
+        [[deprecated("Thread no longer polls; use wait()")]]
+        void wait(xyu::Duration_ms du [[maybe_unused]]) noexcept { wait(); }
+
+        /**
+         * @brief 阻塞等待异步任务完成，直到超时(从当前时间开始的时间段)
+         * @return 任务是否已完成 (未创建任务时返回 true)
+         * @exception E_Mutex_* 挂起等待时出错
+         */
+        template <typename T, T Scale>
+        bool wait_for(const xyu::Duration<T, Scale>& timeout)
+        {
+            if (XY_UNLIKELY(!sp)) return true;
+            if (done()) return true;
+            if (XY_UNLIKELY(timeout.count <= 0)) return false;
+            return wait_for_help(xyu::Duration_ns{timeout});
+        }
+
+        /**
+         * @brief 阻塞等待异步任务完成，直到超时(系统时间点)
+         * @return 任务是否已完成 (未创建任务时返回 true)
+         * @exception E_Mutex_* 挂起等待时出错
+         */
+        bool wait_to(const xyu::Calendar& timepoint)
+        {
+            if (XY_UNLIKELY(!sp)) return true;
+            if (done()) return true;
+            return wait_to_help(timepoint);
         }
 
         /**
          * @brief 阻塞等待任务完成，并获取其返回值。
          * @tparam T 期望的返回类型。必须与任务函数的实际返回类型兼容 或为 void。
-         * @param du 轮询等待的间隔时间。
          * @return 任务函数的返回值。返回值通过复制获取，可以重复得到。
          * @exception ... 如果后台任务抛出了异常，该异常将被在此处重新抛出。
          * @details
@@ -313,10 +465,10 @@ namespace xylu::xyconc
          * 如果任务因抛出异常而失败，此函数会重新抛出该异常。
          */
         template <typename T>
-        T get(xyu::Duration_ms du = {1000})
+        T get()
         {
             // 等待线程结束
-            get_help(du);
+            get_help();
             auto& status = *reinterpret_cast<__::ThreadStatus_Total<T>*>(sp);
             // 获取返回值 (不进行类型检测，调用者确保与原返回类型相同)
             if constexpr (xyu::t_is_void<T>) return;
@@ -324,7 +476,57 @@ namespace xylu::xyconc
             else return *reinterpret_cast<T*>(status.data);
         }
 
+        /**
+         * @brief 阻塞等待任务完成，并获取其返回值。
+         * @param du 原轮询等待的间隔时间 (已忽略)。
+         * @deprecated 等待不再轮询，请使用 `get<T>()`。
+         */
+        template <typename T>
+        [[deprecated("Thread no longer polls; use get<T>()")]]
+        T get(xyu::Duration_ms du [[maybe_unused]]) { return get<T>(); }
+
     private:
+        // 准备任务 (分配新状态并构造传递参数)，返回传递参数
+        // 状态在任务交付执行前即设置为 Running，避免覆盖任务已完成的状态
+        template <typename Fun, typename... Args>
+        void* prepare(Fun&& fun, Args&&... args)
+        {
+            static_assert(xyu::t_can_call<Fun, Args...>);
+            using ret = xyu::t_get_ret<Fun, Args...>;
+            // 状态检查
+            void* tmp = sp; // (状态缓存，防止丢失)
+            check_status();
+            // 分配新状态
+            using Sta = __::ThreadStatus_Total<ret>;
+            sp = xyu::alloc(xyu::native_v, sizeof(Sta), alignof(Sta));
+            ::new (sp) __::ThreadStatus_Base{{}, Uninit};
+            constexpr auto dtor = xyu::t_is_void<ret> || xyu::t_can_trivial_destruct<ret> ? nullptr : ret_dtor<ret>;
+            reinterpret_cast<__::ThreadStatus_Del*>(sp)->dtor = dtor;
+            // 释放旧状态
+            if (tmp) xyu::dealloc(xyu::native_v, tmp);
+            // 构造传递参数
+            void* arg;
+            try { arg = make_arg(xyu::forward<Fun>(fun), xyu::forward<Args>(args)...); }
+            catch (...) { xyu::dealloc(xyu::native_v, sp); sp = nullptr; throw; }
+            reinterpret_cast<__::ThreadStatus_Base*>(sp)->s.store(Running, xyu::N_ATOMIC_RELEASE);
+            return arg;
+        }
+
+        // 任务未能交付执行时，释放传递参数并重置状态
+        template <typename Fun, typename... Args>
+        void drop_arg(void* arg) noexcept
+        {
+            using ret = xyu::t_get_ret<Fun, Args...>;
+            using Tp = xyu::Tuple<__::ThreadStatus_Total<ret>&, xyu::t_decay<Fun>, xyu::Tuple<xyu::t_decay<Args>...>>;
+            reinterpret_cast<Tp*>(arg)->~Tp();
+            xyu::dealloc(xyu::native_v, arg);
+            reinterpret_cast<__::ThreadStatus_Base*>(sp)->s.store(Uninit, xyu::N_ATOMIC_RELEASE);
+        }
+
+        // 在线程池中执行任务
+        template <typename Fun, typename... Args>
+        static void pool_fun(void* arg) noexcept { call_fun<Fun, Args...>(arg); }
+
         // 返回值析构函数
         template <typename T>
         static void ret_dtor(void* sp) noexcept
@@ -358,7 +560,8 @@ namespace xylu::xyconc
             using ret = xyu::t_get_ret<Fun, Args...>;
             using Sta = __::ThreadStatus_Total<ret>;
             // 获取参数
-            auto& tp = *reinterpret_cast<xyu::Tuple<Sta&, xyu::t_decay<Fun>, xyu::Tuple<xyu::t_decay<Args>...>>*>(arg);
+            using Tp = xyu::Tuple<Sta&, xyu::t_decay<Fun>, xyu::Tuple<xyu::t_decay<Args>...>>;
+            auto& tp = *reinterpret_cast<Tp*>(arg);
             Sta& status = tp.template get<0>();
             try {
                 // 无返回值
@@ -369,31 +572,54 @@ namespace xylu::xyconc
                 // 返回值动态分配 (非引用)
                 else ::new (status.data) ret(tp.template get<2>().apply(tp.template get<1>()));
                 // 释放参数内存
+                tp.~Tp();
                 xyu::dealloc(xyu::native_v, arg);
                 // 状态设置为 Finished
-                status.s.store(Finished, xyu::N_ATOMIC_RELEASE);
+                finish(status, Finished);
             }
                 // 捕获异常并设置状态为 Failed
             catch (...) {
+                tp.~Tp();
                 xyu::dealloc(xyu::native_v, arg);
                 status.ep = xyu::ErrorPtr::current();
-                status.s.store(Failed, xyu::N_ATOMIC_RELEASE);
+                finish(status, Failed);
             }
             return 0;
         }
 
+        // 设置结束状态，并唤醒等待者
+        // (等待者可能在状态设置后立即释放状态块，因此唤醒时只使用其地址)
+        static void finish(__::ThreadStatus_Base& status, Status s) noexcept
+        {
+            if (XY_UNLIKELY(status.s.exchange(s, xyu::N_ATOMIC_ACQ_REL) == __::ThreadStatus_Base::Waited))
+                notify_help(&status);
+        }
+
+        // 任务是否已结束
+        bool done() const noexcept
+        { return reinterpret_cast<__::ThreadStatus_Base*>(sp)->s.load(xyu::N_ATOMIC_ACQUIRE) <= Finished; }
+
+        // 挂起等待任务结束
+        void wait_help() noexcept;
+        // 挂起等待任务结束 (超时)
+        bool wait_for_help(xyu::Duration_ns timeout);
+        // 挂起等待任务结束 (时间点)
+        bool wait_to_help(const xyu::Calendar& timepoint);
+        // 唤醒等待状态块的线程
+        static void notify_help(void* status) noexcept;
+
         // 检查旧线程状态
         void check_status();
 
         // 创建线程
 #if (defined(__CYGWIN__) || defined(_WIN32))
-        static void create_help(xyu::uint __stdcall (*fun)(void*), void* arg);
+        static void create_help(const Option& op, xyu::uint __stdcall (*fun)(void*), void* arg);
 #else
-        static void create_help(void* (*fun)(void*), void* arg);
+        static void create_help(const Option& op, void* (*fun)(void*), void* arg);
 #endif
 
         // 等待返回值
-        void get_help(xyu::Duration_ms du);
+        void get_help();
     };
 
 }
@@ -0,0 +1,176 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/function"
+#include "../../link/thread"
+#include "../../link/condvar"
+
+/// 定时器
+namespace xylu::xyconc
+{
+    namespace __
+    {
+        // 时间轮槽位的链表节点
+        struct WheelLink
+        {
+            WheelLink* prev;    // 前一个节点
+            WheelLink* next;    // 后一个节点
+        };
+
+        // 定时器节点 (实现于源文件)
+        struct WheelNode;
+        // 节点块 (实现于源文件)
+        struct WheelChunk;
+    }
+
+    /**
+     * @brief 分层时间轮 (hierarchical timing wheel)，管理大量的超时 (如会话过期、重试)。
+     *
+     * @details
+     *   时间被划分为固定长度的刻度 (tick)，共 K_levels 层，每层 K_slots 个槽位，
+     *   第 l 层的一个槽位覆盖 K_slots^l 个刻度。定时器按到期刻度与当前刻度的距离放入对应层的槽位，
+     *   高层槽位到期时将其中的定时器逐层下放 (cascade)，最终在第 0 层到期执行。
+     *
+     *   ### 复杂度:
+     *   - `schedule` / `cancel`: O(1)，节点从内部的空闲链表中获取，不为每个定时器分配内存。
+     *   - `advance`: 每层使用 64 位位图记录非空槽位，跳过空的刻度，处理时间与到期的定时器数量相关。
+     *
+     *   ### 执行方式:
+     *   - 手动驱动：定期调用 `advance()`，执行所有已到期的定时器。
+     *   - 线程驱动：`start()` 创建后台线程，睡眠到下一个到期时间后执行到期的定时器；
+     *     调度了更早到期的定时器时唤醒后台线程。
+     *
+     *   到期的定时器在一次加锁中批量取出，释放锁后依次执行回调，因此回调中可以调度或取消定时器。
+     *
+     * @note 到期时间向上取整到刻度，定时器不会提前执行，最多延迟一个刻度 (加上驱动的延迟)。
+     * @note 回调抛出的异常被记录到日志后忽略。
+     * @note 超出时间轮范围 (K_slots^K_levels 个刻度) 的定时器放在最高层，到达时重新放入。
+     *
+     * @example
+     *   xyu::TimerWheel tw;     // 默认刻度 1ms
+     *   tw.start();             // 启动后台线程
+     *   auto h = tw.schedule(xyu::Duration_s{30}, [id]{ expire_session(id); });
+     *   tw.cancel(h);           // 会话活跃时取消
+     */
+    class TimerWheel : xyu::class_no_copy_move_t
+    {
+    public:
+        /// 每层槽位数量的位数
+        static constexpr xyu::uint K_bits = 6;
+        /// 每层槽位数量
+        static constexpr xyu::uint K_slots = 1u << K_bits;
+        /// 层数
+        static constexpr xyu::uint K_levels = 6;
+
+        /// 定时器回调
+        using Callback = xyu::Function<void()>;
+
+        /// 定时器句柄 (用于取消；定时器到期或取消后句柄失效)
+        struct Handle
+        {
+            __::WheelNode* n = nullptr;     // 节点
+            xyu::uint64 gen = 0;            // 节点的代数 (节点复用时递增)
+
+            /// 是否曾经指向定时器 (不表示定时器尚未到期)
+            bool valid() const noexcept { return n != nullptr; }
+        };
+
+    private:
+        xyu::Mutex m;                                       // 保护时间轮
+        xyu::CondVar cv;                                    // 唤醒后台线程
+        xyu::int64 tick;                                    // 刻度长度 (纳秒)
+        xyu::int64 base;                                    // 起始时间 (单调时钟，纳秒)
+        xyu::uint64 cur = 0;                                // 已处理到的刻度
+        xyu::size_t n = 0;                                  // 等待中的定时器数量
+        xyu::uint64 bits[K_levels] {};                      // 每层非空槽位的位图
+        __::WheelLink slots[K_levels * K_slots];            // 槽位链表头
+        __::WheelNode* frees = nullptr;                     // 空闲节点链表
+        __::WheelChunk* chunks = nullptr;                   // 已分配的节点块
+        Thread_Native th;                                   // 后台线程
+        xyu::uint64 wait_tick = ~xyu::uint64{0};            // 后台线程睡眠到的刻度
+        bool running = false;                               // 后台线程是否运行中
+        bool quit = false;                                  // 请求后台线程结束
+
+    public:
+        /* 构造析构 */
+
+        /**
+         * @brief 创建时间轮
+         * @param tick 刻度长度 (至少 1 微秒)
+         * @exception E_Logic_Invalid_Argument 刻度过小
+         */
+        template <typename T, T Scale>
+        explicit TimerWheel(const xyu::Duration<T, Scale>& tick) { init(xyu::Duration_ns{tick}.count); }
+
+        /// 创建刻度为 1ms 的时间轮
+        TimerWheel() { init(1000000); }
+
+        /// 析构 (结束后台线程，未到期的定时器不再执行)
+        ~TimerWheel() noexcept;
+
+        /* 定时器 */
+
+        /**
+         * @brief 调度定时器，在 delay 之后执行 cb (delay <= 0 时在下次推进时执行)
+         * @return 定时器句柄
+         * @exception E_Memory_Alloc 分配节点失败
+         */
+        template <typename T, T Scale>
+        Handle schedule(const xyu::Duration<T, Scale>& delay, Callback cb)
+        { return schedule_help(xyu::Duration_ns{delay}.count, cb); }
+
+        /**
+         * @brief 取消定时器
+         * @return 是否取消成功 (定时器已到期、正在执行或已取消时返回 false)
+         */
+        bool cancel(const Handle& h);
+
+        /// 获取等待中的定时器数量
+        xyu::size_t count();
+
+        /* 驱动 */
+
+        /**
+         * @brief 推进到当前时间，执行所有已到期的定时器
+         * @return 执行的定时器数量
+         */
+        xyu::size_t advance();
+
+        /**
+         * @brief 获取距离下次需要推进的时间 (没有定时器时返回 -1)
+         * @note 可能早于实际的到期时间 (高层槽位下放时)，此时推进不执行定时器
+         */
+        xyu::Duration_ns next_timeout();
+
+        /**
+         * @brief 启动后台线程驱动时间轮 (已启动时忽略)
+         * @exception E_Thread_* 创建线程失败
+         */
+        void start();
+
+        /// 结束并等待后台线程 (未启动时忽略；不能在回调中调用)
+        void stop() noexcept;
+
+    private:
+        // 初始化
+        void init(xyu::int64 tick_ns);
+        // 调度定时器
+        Handle schedule_help(xyu::int64 delay_ns, Callback& cb);
+        // 将节点放入对应的槽位 (需持有锁)
+        void insert(__::WheelNode* p) noexcept;
+        // 下一个需要处理的刻度 (需持有锁，没有定时器时返回最大值)
+        xyu::uint64 next_tick() const noexcept;
+        // 推进到 target 刻度，取出到期的节点 (需持有锁)
+        __::WheelNode* expire(xyu::uint64 target) noexcept;
+        // 执行到期的节点并回收
+        xyu::size_t run(__::WheelNode* list);
+        // 当前时间对应的刻度
+        xyu::uint64 now_tick() const noexcept;
+        // 后台线程入口
+        static void driver_main(void* arg);
+    };
+}
+
+#pragma clang diagnostic pop
@@ -0,0 +1,508 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "misc-unconventional-assign-operator"
+#pragma ide diagnostic ignored "OCUnusedStructInspection"
+#pragma ide diagnostic ignored "UnreachableCallsOfFunction"
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "hicpp-exception-baseclass"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma ide diagnostic ignored "google-explicit-constructor"
+#pragma once
+
+#include "../../link/log"
+
+/// 迭代器
+namespace xylu::xyrange
+{
+    // 迭代器 - 存储类 - 分块指针
+    template <typename T>
+    struct RangeIter_Storage_Block
+    {
+        T* i;       // 当前元素
+        T** b;      // 当前块在块映射中的位置
+        constexpr RangeIter_Storage_Block(T* p = nullptr, T** pb = nullptr) noexcept : i{p}, b{pb} {}
+    };
+
+    // 迭代器 - 自增 - 分块指针 (到达块尾时跳转到下一块的块首)
+    template <xyu::size_t B>
+    struct RangeIter_Increment_Block
+    {
+        template <typename Iter>
+        constexpr void operator()(Iter& it) noexcept
+        { if (++it.i == *it.b + B) it.i = *++it.b; }
+    };
+
+    // 迭代器 - 自减 - 分块指针 (位于块首时跳转到上一块的块尾)
+    template <xyu::size_t B>
+    struct RangeIter_Decrement_Block
+    {
+        template <typename Iter>
+        constexpr void operator()(Iter& it) noexcept
+        {
+            if (it.i == *it.b) it.i = *--it.b + B;
+            --it.i;
+        }
+    };
+
+    /**
+     * @brief 用于遍历分块存储结构的双向迭代器。
+     * @tparam T 元素类型
+     * @tparam B 每个块的元素数量
+     * @note 块映射中终点所在的位置必须可读 (未分配时为 nullptr)
+     */
+    template <typename T, xyu::size_t B>
+    using RangeIter_BlockPtr = RangeIter<RangeIter_Storage_Block<T>,
+            RangeIter_Valid_Native, RangeIter_Address_Native, RangeIter_Dereference_Native,
+            RangeIter_Increment_Block<B>, RangeIter_Decrement_Block<B>, RangeIter_None, RangeIter_None,
+            RangeIter_None, RangeIter_Equal_Native, RangeIter_None>;
+}
+
+namespace xylu::xycontain
+{
+    /**
+     * @brief 基于分块存储的双端队列容器
+     *
+     * @tparam T 存储的元素类型。T 必须满足可无异常析构的要求 (is_nothrow_destructible)。
+     *
+     * @details
+     * `xyu::Deque` 将元素存储在若干个固定大小的块中，并通过块映射 (块指针数组) 进行索引，
+     * 两端的增删均为 O(1)，且不会移动已有元素 (增删不会使其他元素的引用失效)。
+     *
+     * ### 核心亮点 (Key Features):
+     *
+     * 1.  **两端 O(1) 增删:**
+     *     - `append()` / `prepend()` 与 `Vector` 一致，支持多元素、范围、可构造范围与原地构造。
+     *     - `erase_back()` / `erase_front()` 删除两端元素，适合作为 FIFO 或 LIFO 的工作队列。
+     *
+     * 2.  **块内存复用:**
+     *     - 块内存通过 `xylu` 的线程局部内存池分配，且会保留一个空闲块，
+     *       在 FIFO 等一端增加另一端删除的场景下，稳定状态时不再进行内存分配。
+     *
+     * 3.  **随机访问与范围:**
+     *     - `operator[]` 与 `Vector` 一样支持负索引，定位元素仅需一次除法与取模 (块大小为 2 的幂)。
+     *     - `range()` 按块遍历，块内为连续的指针移动。
+     */
+    template <typename T>
+    class Deque
+    {
+        static_assert(xyu::t_can_nothrow_destruct<T>);
+
+    public:
+        /* 静态常量 */
+        /// 每个块的元素数量 (2 的幂，块大小约为 1KB，至少 16 个元素)
+        static constexpr xyu::size_t K_block_size = []{
+            xyu::size_t b = 16;
+            while (b * 2 * sizeof(T) <= 1024) b *= 2;
+            return b;
+        }();
+        /// 块映射的最小长度
+        static constexpr xyu::size_t K_map_min_size = 8;
+
+    private:
+        static constexpr xyu::size_t B = K_block_size;
+
+        T** map;            // 块映射 (未分配的块为 nullptr)
+        xyu::size_t mapn;   // 块映射长度
+        xyu::size_t head;   // 首元素位置 (以 map[0] 块首为起点)
+        xyu::size_t n;      // 元素数量
+        T* spare;           // 空闲块
+
+        /* 不变式：
+         * 已分配的块均位于 [head / B, (head + n) / B] 之间，且包含元素的块一定已分配
+         * (head + n) / B < mapn，即终点所在的映射位置总是可读的
+         */
+
+    public:
+        /* 构造析构 */
+
+        /// 默认构造
+        Deque() noexcept : map{nullptr}, mapn{0}, head{0}, n{0}, spare{nullptr} {}
+        /// 移动构造
+        Deque(Deque&& other) noexcept : Deque{} { swap(other); }
+        /// 复制构造
+        Deque(const Deque& other) : Deque{} { append(other.range()); }
+
+        /// 分配空间并初始化
+        Deque(xyu::size_t n, const T& value) : Deque{} { append(xyu::make_range_repeat(value, n)); }
+
+        /// 初始化列表构造
+        Deque(std::initializer_list<T> il) : Deque{} { append(il); }
+
+        /// 析构
+        ~Deque() noexcept { release(); }
+
+        /* 赋值交换 */
+
+        /// 移动赋值
+        Deque& operator=(Deque&& other) noexcept { return swap(other); }
+        /// 复制赋值
+        Deque& operator=(const Deque& other)
+        {
+            if (XY_UNLIKELY(this == &other)) return *this;
+            Deque tmp{other};
+            return swap(tmp);
+        }
+
+        /// 交换
+        Deque& swap(Deque&& other) noexcept { return swap(other); }
+        /// 交换
+        Deque& swap(Deque& other) noexcept
+        {
+            xyu::swap(map, other.map);
+            xyu::swap(mapn, other.mapn);
+            xyu::swap(head, other.head);
+            xyu::swap(n, other.n);
+            xyu::swap(spare, other.spare);
+            return *this;
+        }
+
+        /* 数据容量 */
+
+        /// 获取最大容量
+        constexpr static xyu::size_t limit() noexcept { return xyu::number_traits<xyu::size_t>::max / 4; }
+
+        /// 获取元素数量
+        xyu::size_t count() const noexcept { return n; }
+        /// 是否为空
+        bool empty() const noexcept { return n == 0; }
+
+        /* 元素获取 */
+
+        /// 获取元素
+        T& get(xyu::size_t index) XY_NOEXCEPT_NDEBUG
+        {
+#if XY_DEBUG
+            return at(index);
+#else
+            return elem(head + index);
+#endif
+        }
+        /// 获取元素 (const)
+        const T& get(xyu::size_t index) const XY_NOEXCEPT_NDEBUG { return const_cast<Deque*>(this)->get(index); }
+
+        /// 获取元素 [检测范围]
+        T& at(xyu::size_t index)
+        {
+            if (XY_UNLIKELY(index >= n)) {
+                xyloge(false, "E_Logic_Out_Of_Range: index {} out of range [0, {})", index, n);
+                throw xyu::E_Logic_Out_Of_Range{};
+            }
+            return elem(head + index);
+        }
+        /// 获取元素 (const) [检测范围]
+        const T& at(xyu::size_t index) const { return const_cast<Deque*>(this)->at(index); }
+
+        /* 数据管理 */
+
+        /// 清空元素 (保留块映射与一个空闲块)
+        void clear() noexcept
+        {
+            if (XY_UNLIKELY(mapn == 0)) return;
+            erase_back(n);
+            back_block(map[head / B]);
+            head = mapn / 2 * B;
+        }
+        /// 释放内存
+        void release() noexcept
+        {
+            if (XY_UNLIKELY(mapn == 0)) return;
+            clear();
+            if (spare) xyu::dealloc<T>(spare, B);
+            xyu::dealloc<T*>(map, mapn);
+            map = nullptr;
+            spare = nullptr;
+            mapn = head = 0;
+        }
+
+        /* 尾增 */
+
+        /**
+         * @brief 尾部增加元素 (多元素)
+         * @note 将每一个 args 作为一个元素添加到尾部
+         */
+        template <typename Tag = void, typename... Args, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && xyu::t_can_init<T, xyu::t_args_get<xyu::typelist_c<Args..., void>, 0>>, bool> = true>
+        Deque& append(Args&&... args)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            static_assert((... && xyu::t_can_init<T, Args>));
+            append_help<(... && xyu::t_can_nothrow_init<T, Args>)>(sizeof...(args),
+                         [&](auto put){ (..., put(xyu::forward<Args>(args))); });
+            return *this;
+        }
+
+        /**
+         * @brief 尾部增加元素 (范围)
+         * @note 将 range 中的每一个元素添加到尾部
+         */
+        template <typename Tag = void, typename Rg, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && !xyu::t_can_init<T, Rg> && xyu::t_is_range<Rg>, bool> = true>
+        Deque& append(Rg&& range)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            append_help<xyu::t_can_nothrow_init<T, decltype(*range.begin())>>(range.count(),
+                         [&](auto put){ for (auto&& v : range) put(xyu::forward<decltype(v)>(v)); });
+            return *this;
+        }
+
+        /**
+         * @brief 尾部增加元素 (构造范围)
+         * @note 将 args 构造为一个 xyu::range 后，逐元素添加到尾部
+         */
+        template <typename Tag = void, typename Arg, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && !xyu::t_can_init<T, Arg> && !xyu::t_is_range<Arg>, bool> = true>
+        Deque& append(Arg&& arg)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            static_assert(xyu::t_can_make_range<Arg>);
+            return append<Tag>(xyu::make_range(arg));
+        }
+
+        /**
+         * @brief 尾部增加元素 (单元素)
+         * @tparam Tag 显式指定为 xyu::special_t
+         * @note 将 args 作为一个元素的构造参数添加到尾部
+         */
+        template <typename Tag, typename... Args, xyu::t_enable<xyu::t_is_same<Tag, xyu::special_t>, bool> = false>
+        Deque& append(Args&&... args)
+        {
+            static_assert(xyu::t_can_init<T, Args...>);
+            append_help<xyu::t_can_nothrow_init<T, Args...>>(1, [&](auto put){ put(xyu::forward<Args>(args)...); });
+            return *this;
+        }
+
+        /// 尾部增加元素 (初始化列表)
+        Deque& append(std::initializer_list<T> il) { return append(xyu::make_range(il)); }
+
+        /* 头增 */
+
+        /**
+         * @brief 头部增加元素 (多元素)
+         * @note 将每一个 args 作为一个元素添加到头部 (保持参数顺序)
+         */
+        template <typename Tag = void, typename... Args, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && xyu::t_can_init<T, xyu::t_args_get<xyu::typelist_c<Args..., void>, 0>>, bool> = true>
+        Deque& prepend(Args&&... args)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            static_assert((... && xyu::t_can_init<T, Args>));
+            prepend_help<(... && xyu::t_can_nothrow_init<T, Args>)>(sizeof...(args),
+                         [&](auto put){ (..., put(xyu::forward<Args>(args))); });
+            return *this;
+        }
+
+        /**
+         * @brief 头部增加元素 (范围)
+         * @note 将 range 中的每一个元素添加到头部 (保持范围顺序)
+         */
+        template <typename Tag = void, typename Rg, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && !xyu::t_can_init<T, Rg> && xyu::t_is_range<Rg>, bool> = true>
+        Deque& prepend(Rg&& range)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            prepend_help<xyu::t_can_nothrow_init<T, decltype(*range.begin())>>(range.count(),
+                         [&](auto put){ for (auto&& v : range) put(xyu::forward<decltype(v)>(v)); });
+            return *this;
+        }
+
+        /**
+         * @brief 头部增加元素 (构造范围)
+         * @note 将 args 构造为一个 xyu::range 后，逐元素添加到头部 (保持范围顺序)
+         */
+        template <typename Tag = void, typename Arg, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && !xyu::t_can_init<T, Arg> && !xyu::t_is_range<Arg>, bool> = true>
+        Deque& prepend(Arg&& arg)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            static_assert(xyu::t_can_make_range<Arg>);
+            return prepend<Tag>(xyu::make_range(arg));
+        }
+
+        /**
+         * @brief 头部增加元素 (单元素)
+         * @tparam Tag 显式指定为 xyu::special_t
+         * @note 将 args 作为一个元素的构造参数添加到头部
+         */
+        template <typename Tag, typename... Args, xyu::t_enable<xyu::t_is_same<Tag, xyu::special_t>, bool> = false>
+        Deque& prepend(Args&&... args)
+        {
+            static_assert(xyu::t_can_init<T, Args...>);
+            prepend_help<xyu::t_can_nothrow_init<T, Args...>>(1, [&](auto put){ put(xyu::forward<Args>(args)...); });
+            return *this;
+        }
+
+        /// 头部增加元素 (初始化列表)
+        Deque& prepend(std::initializer_list<T> il) { return prepend(xyu::make_range(il)); }
+
+        /* 删除 */
+
+        /// 删除尾部 count(默认为1) 个元素
+        Deque& erase_back(xyu::size_t count = 1) noexcept
+        {
+            if (XY_UNLIKELY(count > n)) count = n;
+            xyu::size_t eb = (head + n) / B;
+            for (; count; --count) elem(head + --n).~T();
+            for (xyu::size_t nb = (head + n) / B; eb > nb; --eb) back_block(map[eb]);
+            return *this;
+        }
+
+        /// 删除头部 count(默认为1) 个元素
+        Deque& erase_front(xyu::size_t count = 1) noexcept
+        {
+            if (XY_UNLIKELY(count > n)) count = n;
+            xyu::size_t fb = head / B;
+            for (; count; --count, --n) elem(head++).~T();
+            for (xyu::size_t nb = head / B; fb < nb; ++fb) back_block(map[fb]);
+            return *this;
+        }
+
+        /* 范围 */
+
+        /// 创建范围 (按块遍历)
+        auto range() noexcept
+        {
+            using Iter = xyu::RangeIter_BlockPtr<T, B>;
+            if (XY_UNLIKELY(n == 0)) return xyu::Range<Iter>{0, Iter{}, Iter{}};
+            xyu::size_t e = head + n;
+            return xyu::Range<Iter>{n, Iter{map[head / B] + head % B, map + head / B},
+                                       Iter{map[e / B] + e % B, map + e / B}};
+        }
+        /// 创建范围 (const)
+        auto range() const noexcept { return const_cast<Deque*>(this)->range().crange(); }
+
+        /* 运算符 */
+
+        /**
+         * @brief 索引访问 (可修改)
+         * @note 支持负索引，即 [-count,-1] 映射到 [0,count-1]
+         * @note (-∞,-count) 与 [count,+∞) 则 映射到 两端 即 0 和 count-1
+         */
+        T& operator[](xyu::diff_t index) XY_NOEXCEPT_NDEBUG
+        {
+            auto i = static_cast<xyu::size_t>(index);
+            if (index >= 0) return get(i >= n ? n - 1 : i);
+            else return get(XY_UNLIKELY((i += n) >= n) ? 0 : i);
+        }
+        /**
+         * @brief 索引访问 (不可修改)
+         * @note 支持负索引，即 [-count,-1] 映射到 [0,count-1]
+         * @note (-∞,-count) 与 [count,+∞) 则 映射到 两端 即 0 和 count-1
+         */
+        const T& operator[](xyu::diff_t index) const XY_NOEXCEPT_NDEBUG
+        { return const_cast<Deque*>(this)->operator[](index); }
+
+        /// 尾部添加元素
+        template <typename Arg>
+        Deque& operator<<(Arg&& arg) { return append(xyu::forward<Arg>(arg)); }
+
+    private:
+        // 获取位置 p 的元素
+        T& elem(xyu::size_t p) noexcept { return map[p / B][p % B]; }
+
+        // 就地构造新元素
+        template <typename... Args>
+        void place_init(void* p, Args&&... args) noexcept(xyu::t_can_nothrow_init<T, Args...>)
+        {
+            if constexpr (xyu::t_is_aggregate<T>) ::new (p) T{xyu::forward<Args>(args)...};
+            else ::new (p) T(xyu::forward<Args>(args)...);
+        }
+
+        // 获取新块 (优先使用空闲块)
+        T* get_block()
+        {
+            if (spare) { T* b = spare; spare = nullptr; return b; }
+            return xyu::alloc<T>(B);
+        }
+        // 归还块 (保留为空闲块或释放)
+        void back_block(T*& b) noexcept
+        {
+            if (!b) return;
+            if (!spare) spare = b;
+            else xyu::dealloc<T>(b, B);
+            b = nullptr;
+        }
+
+        // 检查增加的元素数量
+        void check_add(xyu::size_t count) const
+        {
+            if (XY_UNLIKELY(count > limit() - n)) {
+                xyloge(false, "E_Memory_Capacity: count {} add {} over limit {}", n, count, limit());
+                throw xyu::E_Memory_Capacity{};
+            }
+        }
+
+        // 调整块映射，保证头部可增加 nf 个元素，尾部可增加 nb 个元素 (仅移动块指针，不移动元素)
+        void remap(xyu::size_t nf, xyu::size_t nb)
+        {
+            xyu::size_t off = head % B, fb = head / B;
+            xyu::size_t used = mapn ? (off + n) / B + 1 : 0;            // 需要保留的块 [fb, fb + used)
+            xyu::size_t addf = nf > off ? (nf - off + B - 1) / B : 0;   // 头部需要新增的块数
+            xyu::size_t total = addf + (off + n + nb) / B + 1;          // 所需的块映射长度
+            // 原映射足够大，则居中移动
+            if (total * 2 <= mapn)
+            {
+                xyu::size_t nfb = addf + (mapn - total) / 2;
+                if (nfb < fb) for (xyu::size_t i = 0; i < used; ++i) map[nfb + i] = map[fb + i];
+                else for (xyu::size_t i = used; i > 0;) --i, map[nfb + i] = map[fb + i];
+                for (xyu::size_t i = 0; i < nfb; ++i) map[i] = nullptr;
+                for (xyu::size_t i = nfb + used; i < mapn; ++i) map[i] = nullptr;
+                head = nfb * B + off;
+            }
+            // 重新分配映射
+            else
+            {
+                xyu::size_t newmapn = xyu::max(total * 2, K_map_min_size);
+                T** newmap = xyu::alloc<T*>(newmapn);
+                xyu::size_t nfb = addf + (newmapn - total) / 2;
+                for (xyu::size_t i = 0; i < newmapn; ++i) newmap[i] = nullptr;
+                for (xyu::size_t i = 0; i < used; ++i) newmap[nfb + i] = map[fb + i];
+                if (map) xyu::dealloc<T*>(map, mapn);
+                map = newmap;
+                mapn = newmapn;
+                head = nfb * B + off;
+            }
+        }
+
+        // append 辅助函数
+        // 依次在尾部构造新元素，若构造失败，则删除本次已构造的元素
+        template <bool nothrow_init, typename Fun>
+        void append_help(xyu::size_t count, Fun f)
+        {
+            check_add(count);
+            if (XY_UNLIKELY(head + n + count >= mapn * B)) remap(0, count);
+            auto put = [this](auto&&... args) {
+                xyu::size_t p = head + n;
+                T*& b = map[p / B];
+                if (!b) b = get_block();
+                place_init(b + p % B, xyu::forward<decltype(args)>(args)...);
+                ++n;
+            };
+            if constexpr (nothrow_init) f(put);
+            else {
+                xyu::size_t on = n;
+                try { f(put); }
+                catch (...) { erase_back(n - on); throw; }
+            }
+        }
+
+        // prepend 辅助函数
+        // 在头部预留位置后依次构造新元素，若构造失败，则析构已构造的元素并归还新增的块
+        template <bool nothrow_init, typename Fun>
+        void prepend_help(xyu::size_t count, Fun f)
+        {
+            check_add(count);
+            if (XY_UNLIKELY(head < count)) remap(count, 0);
+            xyu::size_t fb = head / B, nh = head - count, p = nh;
+            auto put = [this, &p](auto&&... args) {
+                T*& b = map[p / B];
+                if (!b) b = get_block();
+                place_init(b + p % B, xyu::forward<decltype(args)>(args)...);
+                ++p;
+            };
+            if constexpr (nothrow_init) f(put);
+            else try { f(put); }
+                catch (...) {
+                    for (; p > nh;) elem(--p).~T();
+                    for (xyu::size_t i = nh / B; i < fb; ++i) back_block(map[i]);
+                    throw;
+                }
+            head = nh;
+            n += count;
+        }
+    };
+}
+
+#pragma clang diagnostic pop
@@ -20,6 +20,9 @@ namespace xylu::xycontain::__
         RbTreeNode_Base* left{};                // 左子节点
         RbTreeNode_Base* right{};               // 右子节点
         enum Color { RED, BLACK } color {RED};  // 颜色
+#if XY_RBTREE_RANK
+        xyu::size_t size{1};                    // 子树节点数量 (含自身)
+#endif
     };
 
     /// 红黑树节点
@@ -55,6 +58,35 @@ namespace xylu::xycontain
     // 辅助函数
     namespace __
     {
+        //旋转后更新子树节点数量 (n 为原子树根，cn 为新子树根)
+        constexpr void sizeRotate(RbTreeNode_Base* n, RbTreeNode_Base* cn) noexcept
+        {
+#if XY_RBTREE_RANK
+            cn->size = n->size;
+            n->size = (n->left ? n->left->size : 0) + (n->right ? n->right->size : 0) + 1;
+#endif
+        }
+        //沿父链更新子树节点数量 (直至哨兵节点)
+        constexpr void sizeUpdate(RbTreeNode_Base* n, const RbTreeNode_Base& lead, bool add) noexcept
+        {
+#if XY_RBTREE_RANK
+            for (; n != &lead; n = n->up) add ? ++n->size : --n->size;
+#endif
+        }
+#if XY_RBTREE_RANK
+        //获取子树中第 i 个节点 (需保证 i 小于子树节点数量)
+        constexpr RbTreeNode_Base* rankNode(RbTreeNode_Base* n, xyu::size_t i) noexcept
+        {
+            for (;;)
+            {
+                xyu::size_t ls = n->left ? n->left->size : 0;
+                if (i < ls) n = n->left;
+                else if (i == ls) return n;
+                else { i -= ls + 1; n = n->right; }
+            }
+        }
+#endif
+
         //左旋节点
         template <bool reColor = true>
         constexpr void leftRotate(RbTreeNode_Base* n, RbTreeNode_Base*& pns) noexcept
@@ -66,6 +98,7 @@ namespace xylu::xycontain
             rn->up = n->up;
             n->up = rn;
             pns = rn;
+            sizeRotate(n, rn);
             if constexpr (reColor)
             {
                 n->color = RbTreeNode_Base::RED;
@@ -89,6 +122,7 @@ namespace xylu::xycontain
             ln->up = n->up;
             n->up = ln;
             pns = ln;
+            sizeRotate(n, ln);
             if constexpr (reColor)
             {
                 n->color = RbTreeNode_Base::RED;
@@ -191,7 +225,7 @@ namespace xylu::xycontain
                         }
                         bn->color = pn->color;
                         pn->color = RbTreeNode_Base::BLACK;
-                        if (bn->right) bn->right->color = RbTreeNode_Base::BLACK;
+                        bn->left->color = RbTreeNode_Base::BLACK;
                         rightRotate<false>(pn, lead);
                     }
                 }
@@ -201,6 +235,15 @@ namespace xylu::xycontain
         constexpr void fixErase(RbTreeNode_Base* n, RbTreeNode_Base& lead) noexcept
         {
             RbTreeNode_Base *sn{}, *pn{};
+#if XY_RBTREE_RANK
+            //更新实际移除位置到根节点路径上的子树节点数量
+            if (n->left && n->right) {
+                RbTreeNode_Base* nn = n->right;
+                while (nn->left) nn = nn->left;
+                sizeUpdate(nn->up, lead, false);
+            }
+            else sizeUpdate(n->up, lead, false);
+#endif
             if (!n->left) sn = n->right;
             else if (!n->right) sn = n->left;
             //删除节点有两个子节点 (转换为只有一个或没有子节点)
@@ -211,6 +254,9 @@ namespace xylu::xycontain
                 sn = nn->right;
                 //用后继节点代替删除节点
                 xyu::swap(n->color, nn->color);
+#if XY_RBTREE_RANK
+                nn->size = n->size;
+#endif
                 n->left->up = nn; //左
                 nn->left = n->left;
                 if (nn != n->right) {  //右
@@ -247,6 +293,36 @@ namespace xylu::xycontain
             //删除节点无子节点且为黑色，则需要修正 (红色不做处理)
             else if (n->color == RbTreeNode_Base::BLACK && pn != &lead) fixEraseImpl(sn, pn, lead);
         }
+        //由有序链表构建平衡子树 (链表通过 right 串联，cur 前进 n 个节点)
+        //深度为 red 的节点着红色，其余着黑色
+        constexpr RbTreeNode_Base* buildSorted(RbTreeNode_Base*& cur, xyu::size_t n, xyu::size_t dp, xyu::size_t red) noexcept
+        {
+            if (n == 0) return nullptr;
+            RbTreeNode_Base* ln = buildSorted(cur, n / 2, dp + 1, red);
+            RbTreeNode_Base* rt = cur;
+            cur = cur->right;
+            rt->left = ln;
+            if (ln) ln->up = rt;
+            rt->color = dp == red ? RbTreeNode_Base::RED : RbTreeNode_Base::BLACK;
+#if XY_RBTREE_RANK
+            rt->size = n;
+#endif
+            RbTreeNode_Base* rn = buildSorted(cur, n - n / 2 - 1, dp + 1, red);
+            rt->right = rn;
+            if (rn) rn->up = rt;
+            return rt;
+        }
+        constexpr void buildSorted(RbTreeNode_Base* first, RbTreeNode_Base* last, xyu::size_t n, RbTreeNode_Base& lead) noexcept
+        {
+            //中分构建的树中，空链接深度只有 h 与 h+1 两种，将最深一层 (深度 h) 着红色即可满足黑高一致
+            xyu::size_t h = 0;
+            for (xyu::size_t t = n; t > 1; t >>= 1) ++h;
+            RbTreeNode_Base* cur = first;
+            lead.up = buildSorted(cur, n, 0, h == 0 ? -1 : h);
+            lead.up->up = &lead;
+            lead.left = first;
+            lead.right = last;
+        }
     }
 
     /**
@@ -306,7 +382,7 @@ namespace xylu::xycontain
         /// 默认构造
         RbTree() noexcept : lead{nullptr, &lead, &lead}, num{0} {}
         /// 复制构造
-        RbTree(const RbTree& other) : RbTree{} { insert(other.range()); }
+        RbTree(const RbTree& other) : RbTree{} { build_sorted(other.range()); }
         /// 移动构造
         RbTree(RbTree&& other) noexcept : RbTree{} { swap(other); }
 
@@ -317,6 +393,31 @@ namespace xylu::xycontain
         template <typename Test = Value, xyu::t_enable<xyu::t_is_void<Test>, bool> = false>
         RbTree(std::initializer_list<Tuple<Key>> il) : RbTree{} { insert(il); }
 
+        /**
+         * @brief 由有序范围直接构建 (O(n))
+         * @details 不进行逐个插入时的查找与旋转，按中序一次性构建平衡树并直接着色；重复键仅保留第一个
+         * @param range 按键升序排列的范围 (元素类型与 insert 相同)
+         * @exception E_Logic_Invalid_Argument 范围未按键升序排列
+         */
+        template <typename Rg, xyu::t_enable<xyu::t_is_range<Rg>, bool> = true>
+        static RbTree from_sorted(Rg&& range)
+        {
+            RbTree tree;
+            tree.build_sorted(xyu::forward<Rg>(range));
+            return tree;
+        }
+        /**
+         * @brief 将参数构造为范围后，由有序范围直接构建 (O(n))
+         * @param arg 用于构造范围的参数 (按键升序排列，为右值时移动其中的元素)
+         * @exception E_Logic_Invalid_Argument 范围未按键升序排列
+         */
+        template <typename Arg, xyu::t_enable<!xyu::t_is_range<Arg>, bool> = false>
+        static RbTree from_sorted(Arg&& arg)
+        {
+            if constexpr (xyu::t_is_lrefer<Arg>) return from_sorted(xyu::make_range(arg));
+            else return from_sorted(xyu::make_range(arg).mrange());
+        }
+
         /// 析构
         ~RbTree() noexcept { release(); }
 
@@ -326,9 +427,9 @@ namespace xylu::xycontain
         RbTree& operator=(const RbTree& other)
         {
             if (XY_UNLIKELY(this == &other)) return *this;
-            release();
-            insert(other.range());
-            return *this;
+            RbTree tmp;
+            tmp.build_sorted(other.range());
+            return swap(tmp);
         }
         /// 移动赋值
         RbTree& operator=(RbTree&& other) noexcept { return swap(other); }
@@ -667,6 +768,48 @@ namespace xylu::xycontain
         template <typename Test = Value, typename = xyu::t_enable<!xyu::t_is_void<Test>>>
         auto vrange() const noexcept { return const_cast<RbTree*>(this)->vrange().crange(); }
 
+#if XY_RBTREE_RANK
+        /* 按序查询 (需开启 XY_RBTREE_RANK) */
+
+        /**
+         * @brief 获取按键升序排列的第 i 个元素 (从 0 开始)
+         * @param i 序号
+         * @exception E_Logic_Out_Of_Range 序号越界
+         */
+        Data& at_rank(xyu::size_t i)
+        {
+            if (XY_UNLIKELY(i >= num)) {
+                xyloge(false, "E_Logic_Out_Of_Range: rank {} out of range [0, {})", i, num);
+                throw xyu::E_Logic_Out_Of_Range{};
+            }
+            return *static_cast<Node*>(__::rankNode(lead.up, i));
+        }
+        /**
+         * @brief 获取按键升序排列的第 i 个元素 (从 0 开始)
+         * @param i 序号
+         * @exception E_Logic_Out_Of_Range 序号越界
+         */
+        const Data& at_rank(xyu::size_t i) const { return const_cast<RbTree*>(this)->at_rank(i); }
+
+        /**
+         * @brief 获取小于键的元素数量
+         * @details 若键存在，即为键的序号
+         * @param key 键
+         */
+        xyu::size_t rank_of(const Key& key) const noexcept { return count_less<false>(key); }
+
+        /**
+         * @brief 获取键位于闭区间 [lo, hi] 内的元素数量
+         * @param lo 下界
+         * @param hi 上界
+         */
+        xyu::size_t count_range(const Key& lo, const Key& hi) const noexcept
+        {
+            if (XY_UNLIKELY(xyu::compare(hi, lo) < 0)) return 0;
+            return count_less<true>(hi) - count_less<false>(lo);
+        }
+#endif
+
         /* 运算符 */
 
         /**
@@ -720,6 +863,25 @@ namespace xylu::xycontain
             }
             return static_cast<Node*>(cur);
         }
+#if XY_RBTREE_RANK
+        // 统计小于 (equal 为真时为不大于) 键的节点数量
+        template <bool equal>
+        xyu::size_t count_less(const Key& key) const noexcept
+        {
+            xyu::size_t r = 0;
+            NodeBase* cur = lead.up;
+            while (cur)
+            {
+                int cmp = xyu::compare(static_cast<Node*>(cur)->key, key);
+                if (cmp < 0 || (equal && cmp == 0)) {
+                    r += (cur->left ? cur->left->size : 0) + 1;
+                    cur = cur->right;
+                }
+                else cur = cur->left;
+            }
+            return r;
+        }
+#endif
         // 查找或新增节点
         auto find_node_add(const Key& key) const noexcept
         {
@@ -777,6 +939,7 @@ namespace xylu::xycontain
                 else { pn->right = n; if (pn == lead.right) lead.right = n; }
                 //连接节点
                 n->up = pn;
+                __::sizeUpdate(pn, lead, true);
                 if (pn->color == Node::RED) __::fixInsert(pn, less, lead);
             }
             ++num;
@@ -797,18 +960,76 @@ namespace xylu::xycontain
             return n;
         }
 
+        // 由有序范围构建 (仅在空树时调用)
+        template <typename Rg>
+        void build_sorted(Rg&& range)
+        {
+            constexpr int kind = __::get_range_kv_type<Rg, Key>;
+            static_assert(kind < 0 || (kind > 0 && !xyu::t_is_void<Value>));
+            // 按序构造节点，通过 right 串联成链表
+            NodeBase *first = nullptr, *last = nullptr;
+            xyu::size_t cnt = 0;
+            try {
+                for (auto&& e : range)
+                {
+                    Node* n = xyu::alloc<Node>(1);
+                    try {
+                        if constexpr (kind == -1) ::new (n) Node{xyu::forward<decltype(e)>(e)};
+                        else if constexpr (kind == -2) ::new (n) Node{xyu::forward<decltype(e)>(e).key};
+                        else if constexpr (kind == -3) ::new (n) Node{xyu::forward<decltype(e)>(e).template get<0>()};
+                        else if constexpr (kind < 0) { auto&& [key] = xyu::forward<decltype(e)>(e); ::new (n) Node{xyu::forward<decltype(key)>(key)}; }
+                        else if constexpr (kind == 2) ::new (n) Node{xyu::forward<decltype(e)>(e).key, xyu::forward<decltype(e)>(e).val};
+                        else if constexpr (kind == 3) ::new (n) Node{xyu::forward<decltype(e)>(e).template get<0>(), xyu::forward<decltype(e)>(e).template get<1>()};
+                        else { auto&& [key, val] = xyu::forward<decltype(e)>(e); ::new (n) Node{xyu::forward<decltype(key)>(key), xyu::forward<decltype(val)>(val)}; }
+                    }
+                    catch (...) { xyu::dealloc<Node>(n, 1); throw; }
+                    if (XY_LIKELY(last != nullptr))
+                    {
+                        int cmp = xyu::compare(n->key, static_cast<Node*>(last)->key);
+                        if (XY_UNLIKELY(cmp < 0)) {
+                            back_node(n);
+                            xyloge(false, "E_Logic_Invalid_Argument: range is not sorted in ascending order");
+                            throw xyu::E_Logic_Invalid_Argument{};
+                        }
+                        if (cmp == 0) { back_node(n); continue; }
+                        last->right = n;
+                    }
+                    else first = n;
+                    last = n;
+                    ++cnt;
+                }
+            }
+            catch (...) {
+                while (first) { NodeBase* rn = first->right; back_node(first); first = rn; }
+                throw;
+            }
+            if (XY_UNLIKELY(cnt == 0)) return;
+            __::buildSorted(first, last, cnt, lead);
+            num = cnt;
+        }
+
         // 释放单个节点
         static void back_node(NodeBase* n) noexcept
         {
             static_cast<Node*>(n)->~Node();
             xyu::dealloc<Node>(static_cast<Node*>(n), 1);
         }
-        // 递归释放节点
+        // 迭代释放节点
+        // 通过右旋将左子树逐步展开为右链，按中序依次释放，不使用递归与额外空间
         static void back_nodes(NodeBase* n) noexcept
         {
-            if (n->left) back_nodes(n->left);
-            if (n->right) back_nodes(n->right);
-            back_node(n);
+            while (n)
+            {
+                if (NodeBase* ln = n->left) {
+                    n->left = ln->right;
+                    ln->right = n;
+                    n = ln;
+                } else {
+                    NodeBase* rn = n->right;
+                    back_node(n);
+                    n = rn;
+                }
+            }
         }
         // 删除节点
         void delete_node(NodeBase* n) noexcept
@@ -837,7 +1058,7 @@ namespace xylu::xycontain
         /// 默认构造
         RbTree() noexcept : lead{nullptr, &lead, &lead}, num{0} {}
         /// 复制构造
-        RbTree(const RbTree& other) : RbTree{} { insert(other.range()); }
+        RbTree(const RbTree& other) : RbTree{} { build_sorted(other.range()); }
         /// 移动构造
         RbTree(RbTree&& other) noexcept : RbTree{} { swap(other); }
 
@@ -848,6 +1069,31 @@ namespace xylu::xycontain
         template <typename Test = Value, xyu::t_enable<xyu::t_is_void<Test>, bool> = false>
         RbTree(std::initializer_list<Tuple<Key>> il) : RbTree{} { insert(il); }
 
+        /**
+         * @brief 由有序范围直接构建 (O(n))
+         * @details 不进行逐个插入时的查找与旋转，按中序一次性构建平衡树并直接着色；等价键全部保留
+         * @param range 按键升序排列的范围 (元素类型与 insert 相同)
+         * @exception E_Logic_Invalid_Argument 范围未按键升序排列
+         */
+        template <typename Rg, xyu::t_enable<xyu::t_is_range<Rg>, bool> = true>
+        static RbTree from_sorted(Rg&& range)
+        {
+            RbTree tree;
+            tree.build_sorted(xyu::forward<Rg>(range));
+            return tree;
+        }
+        /**
+         * @brief 将参数构造为范围后，由有序范围直接构建 (O(n))
+         * @param arg 用于构造范围的参数 (按键升序排列，为右值时移动其中的元素)
+         * @exception E_Logic_Invalid_Argument 范围未按键升序排列
+         */
+        template <typename Arg, xyu::t_enable<!xyu::t_is_range<Arg>, bool> = false>
+        static RbTree from_sorted(Arg&& arg)
+        {
+            if constexpr (xyu::t_is_lrefer<Arg>) return from_sorted(xyu::make_range(arg));
+            else return from_sorted(xyu::make_range(arg).mrange());
+        }
+
         /// 析构
         ~RbTree() noexcept { release(); }
 
@@ -857,9 +1103,9 @@ namespace xylu::xycontain
         RbTree& operator=(const RbTree& other)
         {
             if (XY_UNLIKELY(this == &other)) return *this;
-            release();
-            insert(other.range());
-            return *this;
+            RbTree tmp;
+            tmp.build_sorted(other.range());
+            return swap(tmp);
         }
         /// 移动赋值
         RbTree& operator=(RbTree&& other) noexcept { return swap(other); }
@@ -1226,6 +1472,48 @@ namespace xylu::xycontain
         template <typename Test = Value, typename = xyu::t_enable<!xyu::t_is_void<Test>>>
         auto vrange() const noexcept { return const_cast<RbTree*>(this)->vrange().crange(); }
 
+#if XY_RBTREE_RANK
+        /* 按序查询 (需开启 XY_RBTREE_RANK) */
+
+        /**
+         * @brief 获取按键升序排列的第 i 个元素 (从 0 开始)
+         * @param i 序号
+         * @exception E_Logic_Out_Of_Range 序号越界
+         */
+        Data& at_rank(xyu::size_t i)
+        {
+            if (XY_UNLIKELY(i >= num)) {
+                xyloge(false, "E_Logic_Out_Of_Range: rank {} out of range [0, {})", i, num);
+                throw xyu::E_Logic_Out_Of_Range{};
+            }
+            return *static_cast<Node*>(__::rankNode(lead.up, i));
+        }
+        /**
+         * @brief 获取按键升序排列的第 i 个元素 (从 0 开始)
+         * @param i 序号
+         * @exception E_Logic_Out_Of_Range 序号越界
+         */
+        const Data& at_rank(xyu::size_t i) const { return const_cast<RbTree*>(this)->at_rank(i); }
+
+        /**
+         * @brief 获取小于键的元素数量
+         * @details 若键存在，即为等价键中第一个的序号
+         * @param key 键
+         */
+        xyu::size_t rank_of(const Key& key) const noexcept { return count_less<false>(key); }
+
+        /**
+         * @brief 获取键位于闭区间 [lo, hi] 内的元素数量
+         * @param lo 下界
+         * @param hi 上界
+         */
+        xyu::size_t count_range(const Key& lo, const Key& hi) const noexcept
+        {
+            if (XY_UNLIKELY(xyu::compare(hi, lo) < 0)) return 0;
+            return count_less<true>(hi) - count_less<false>(lo);
+        }
+#endif
+
         /**
          * @brief 获取范围
          * @details
@@ -1349,6 +1637,25 @@ namespace xylu::xycontain
             return res;
         }
 
+#if XY_RBTREE_RANK
+        // 统计小于 (equal 为真时为不大于) 键的节点数量
+        template <bool equal>
+        xyu::size_t count_less(const Key& key) const noexcept
+        {
+            xyu::size_t r = 0;
+            NodeBase* cur = lead.up;
+            while (cur)
+            {
+                int cmp = xyu::compare(static_cast<Node*>(cur)->key, key);
+                if (cmp < 0 || (equal && cmp == 0)) {
+                    r += (cur->left ? cur->left->size : 0) + 1;
+                    cur = cur->right;
+                }
+                else cur = cur->left;
+            }
+            return r;
+        }
+#endif
         // 查找或新增节点
         auto find_node_add(const Key& key) const noexcept
         {
@@ -1401,6 +1708,7 @@ namespace xylu::xycontain
                 else { pn->right = n; if (pn == lead.right) lead.right = n; }
                 //连接节点
                 n->up = pn;
+                __::sizeUpdate(pn, lead, true);
                 if (pn->color == Node::RED) __::fixInsert(pn, less, lead);
             }
             ++num;
@@ -1421,18 +1729,75 @@ namespace xylu::xycontain
             return n;
         }
 
+        // 由有序范围构建 (仅在空树时调用)
+        template <typename Rg>
+        void build_sorted(Rg&& range)
+        {
+            constexpr int kind = __::get_range_kv_type<Rg, Key>;
+            static_assert(kind < 0 || (kind > 0 && !xyu::t_is_void<Value>));
+            // 按序构造节点，通过 right 串联成链表
+            NodeBase *first = nullptr, *last = nullptr;
+            xyu::size_t cnt = 0;
+            try {
+                for (auto&& e : range)
+                {
+                    Node* n = xyu::alloc<Node>(1);
+                    try {
+                        if constexpr (kind == -1) ::new (n) Node{xyu::forward<decltype(e)>(e)};
+                        else if constexpr (kind == -2) ::new (n) Node{xyu::forward<decltype(e)>(e).key};
+                        else if constexpr (kind == -3) ::new (n) Node{xyu::forward<decltype(e)>(e).template get<0>()};
+                        else if constexpr (kind < 0) { auto&& [key] = xyu::forward<decltype(e)>(e); ::new (n) Node{xyu::forward<decltype(key)>(key)}; }
+                        else if constexpr (kind == 2) ::new (n) Node{xyu::forward<decltype(e)>(e).key, xyu::forward<decltype(e)>(e).val};
+                        else if constexpr (kind == 3) ::new (n) Node{xyu::forward<decltype(e)>(e).template get<0>(), xyu::forward<decltype(e)>(e).template get<1>()};
+                        else { auto&& [key, val] = xyu::forward<decltype(e)>(e); ::new (n) Node{xyu::forward<decltype(key)>(key), xyu::forward<decltype(val)>(val)}; }
+                    }
+                    catch (...) { xyu::dealloc<Node>(n, 1); throw; }
+                    if (XY_LIKELY(last != nullptr))
+                    {
+                        int cmp = xyu::compare(n->key, static_cast<Node*>(last)->key);
+                        if (XY_UNLIKELY(cmp < 0)) {
+                            back_node(n);
+                            xyloge(false, "E_Logic_Invalid_Argument: range is not sorted in ascending order");
+                            throw xyu::E_Logic_Invalid_Argument{};
+                        }
+                        last->right = n;
+                    }
+                    else first = n;
+                    last = n;
+                    ++cnt;
+                }
+            }
+            catch (...) {
+                while (first) { NodeBase* rn = first->right; back_node(first); first = rn; }
+                throw;
+            }
+            if (XY_UNLIKELY(cnt == 0)) return;
+            __::buildSorted(first, last, cnt, lead);
+            num = cnt;
+        }
+
         // 释放单个节点
         static void back_node(NodeBase* n) noexcept
         {
             static_cast<Node*>(n)->~Node();
             xyu::dealloc<Node>(static_cast<Node*>(n), 1);
         }
-        // 递归释放节点
+        // 迭代释放节点
+        // 通过右旋将左子树逐步展开为右链，按中序依次释放，不使用递归与额外空间
         static void back_nodes(NodeBase* n) noexcept
         {
-            if (n->left) back_nodes(n->left);
-            if (n->right) back_nodes(n->right);
-            back_node(n);
+            while (n)
+            {
+                if (NodeBase* ln = n->left) {
+                    n->left = ln->right;
+                    ln->right = n;
+                    n = ln;
+                } else {
+                    NodeBase* rn = n->right;
+                    back_node(n);
+                    n = rn;
+                }
+            }
         }
         // 删除节点
         void delete_node(NodeBase* n) noexcept
@@ -1444,4 +1809,4 @@ namespace xylu::xycontain
     };
 }
 
-#pragma clang diagnostic pop
\ No newline at end of file
+#pragma clang diagnostic pop
\ No newline at end of file
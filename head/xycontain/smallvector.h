@@ -0,0 +1,606 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "UnusedParameter"
+#pragma ide diagnostic ignored "misc-unconventional-assign-operator"
+#pragma ide diagnostic ignored "OCUnusedStructInspection"
+#pragma ide diagnostic ignored "UnreachableCode"
+#pragma ide diagnostic ignored "LoopDoesntUseConditionVariableInspection"
+#pragma ide diagnostic ignored "EndlessLoop"
+#pragma ide diagnostic ignored "UnreachableCallsOfFunction"
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "hicpp-exception-baseclass"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/log"
+
+namespace xylu::xycontain
+{
+    /**
+     * @brief 带内置存储的动态数组容器
+     *
+     * @tparam T 存储的元素类型。T 必须满足可无异常析构的要求 (is_nothrow_destructible)。
+     * @tparam N 内置存储可容纳的元素数量 (N > 0)
+     *
+     * @details
+     * `xyu::SmallVector` 与 `xyu::Vector` 提供相同的接口 (负索引、范围化的 append/insert、range() 与格式化)，
+     * 区别在于元素数量不超过 N 时直接存储在对象内部，不进行任何内存分配；
+     * 超过 N 时才转移到通过 `xyu::alloc` 分配的内存中，适合大多数情况下只保存少量元素的场景。
+     *
+     * ### 存储模式 (Storage Mode):
+     *
+     * - **内置模式:** 初始状态，容量为 N，元素位于对象内部的缓冲区。
+     * - **堆模式:** 元素数量超过 N 后进入，行为与 `xyu::Vector` 一致。
+     * - `release()` 以及元素数量不超过 N 时的 `reduce()` 会使容器回到内置模式。
+     * - 移动内置模式的容器需要逐个移动元素，因此移动操作仅在 T 可无异常移动构造时为 noexcept。
+     */
+    template <typename T, xyu::size_t N>
+    class SmallVector
+    {
+        static_assert(xyu::t_can_nothrow_destruct<T>);
+        static_assert(N > 0);
+
+    public:
+        /* 静态常量 */
+        /// 释放空间条件比例
+        static constexpr double K_shrink_factor = 0.5;
+        /// 扩容比例
+        static constexpr double K_grow_factor = 2;
+
+    private:
+        T* data;            // 数组指针 (内置模式时指向 buf)
+        xyu::size_t n;      // 使用的元素数量
+        xyu::size_t capa;   // 数组容量 (内置模式时为 N)
+        alignas(T) xyu::uint8 buf[sizeof(T) * N];   // 内置存储
+
+    public:
+        /* 构造析构 */
+
+        /// 默认构造
+        SmallVector() noexcept : data{local()}, n{0}, capa{N} {}
+        /// 移动构造
+        SmallVector(SmallVector&& other) noexcept(xyu::t_can_nothrow_mvconstr<T>) : SmallVector{} { take(other); }
+        /// 复制构造
+        SmallVector(const SmallVector& other) : SmallVector{} { append(other.range()); }
+
+        /// 预分配空间构造
+        explicit SmallVector(xyu::size_t capa) : SmallVector{} { reserve(capa); }
+        /// 分配空间并初始化
+        SmallVector(xyu::size_t n, const T& value) : SmallVector{} { append(xyu::make_range_repeat(value, n)); }
+
+        /// 初始化列表构造
+        SmallVector(std::initializer_list<T> il) : SmallVector{} { append(il); }
+
+        /// 析构
+        ~SmallVector() noexcept { release(); }
+
+        /* 赋值交换 */
+
+        /// 移动赋值
+        SmallVector& operator=(SmallVector&& other) noexcept(xyu::t_can_nothrow_mvconstr<T>)
+        {
+            if (XY_UNLIKELY(this == &other)) return *this;
+            release();
+            take(other);
+            return *this;
+        }
+        /// 复制赋值
+        SmallVector& operator=(const SmallVector& other)
+        {
+            if (XY_UNLIKELY(this == &other)) return *this;
+            // 需要扩容
+            if (capa < other.n)
+            {
+                clear();
+                append(other.range());
+            }
+            // 容量足够
+            else
+            {
+                bool app = n < other.n;
+                for (xyu::size_t i = 0, j = app ? n : other.n; i < j; ++i) data[i] = other.data[i];
+                if (app) for (;n < other.n; ++n) place_init(data + n, other.data[n]);
+                else for (; n > other.n;) data[--n].~T();
+            }
+            return *this;
+        }
+
+        /// 交换
+        SmallVector& swap(SmallVector&& other) noexcept(xyu::t_can_nothrow_mvconstr<T>) { return swap(other); }
+        /// 交换
+        SmallVector& swap(SmallVector& other) noexcept(xyu::t_can_nothrow_mvconstr<T>)
+        {
+            if (XY_UNLIKELY(this == &other)) return *this;
+            // 均为堆模式，直接交换指针
+            if (!is_inline() && !other.is_inline())
+            {
+                xyu::swap(data, other.data);
+                xyu::swap(n, other.n);
+                xyu::swap(capa, other.capa);
+            }
+            // 存在内置模式，需要移动元素
+            else
+            {
+                SmallVector tmp{xyu::move(other)};
+                other.take(*this);
+                take(tmp);
+            }
+            return *this;
+        }
+
+        /* 数据容量 */
+
+        /// 获取最大容量
+        constexpr static xyu::size_t limit() noexcept { return xyu::number_traits<xyu::size_t>::max / 2; }
+        /// 获取当前容量
+        xyu::size_t capacity() const noexcept { return capa; }
+        /// 是否处于内置模式 (元素存储在对象内部)
+        bool is_inline() const noexcept { return data == reinterpret_cast<const T*>(buf); }
+
+        /// 获取元素数量
+        xyu::size_t count() const noexcept { return n; }
+        /// 是否为空
+        bool empty() const noexcept { return n == 0; }
+
+        /* 元素获取 */
+
+        /// 获取元素
+        T& get(xyu::size_t index) XY_NOEXCEPT_NDEBUG
+        {
+#if XY_DEBUG
+            return at(index);
+#else
+            return data[index];
+#endif
+        }
+        /// 获取元素 (const)
+        const T& get(xyu::size_t index) const XY_NOEXCEPT_NDEBUG { return const_cast<SmallVector*>(this)->at(index); }
+
+        /// 获取元素 [检测范围]
+        T& at(xyu::size_t index)
+        {
+            if (XY_UNLIKELY(index >= n)) {
+                xyloge(false, "E_Logic_Out_Of_Range: index {} out of range [0, {})", index, n);
+                throw xyu::E_Logic_Out_Of_Range{};
+            }
+            return data[index];
+        }
+        /// 获取元素 (const) [检测范围]
+        const T& at(xyu::size_t index) const { return const_cast<SmallVector*>(this)->at(index); }
+
+        /* 数据管理 */
+
+        /// 预分配空间
+        void reserve(xyu::size_t mincapa)
+        {
+            if (mincapa > capa) realloc_capa(calc_new_capa(mincapa));
+        }
+        /// 缩减容量 (仅当 元素数量 < 容量 * K_shrink_factor，元素数量不超过 N 时回到内置模式)
+        void reduce()
+        {
+            if (!is_inline() && n < capa * K_shrink_factor) realloc_capa(n);
+        }
+
+        /// 调整元素数量 (可以缩减或扩容)
+        void resize(xyu::size_t newsize, const T& value = T{})
+        {
+            if (newsize <= n) while (n > newsize) data[--n].~T();
+            else {
+                reserve(newsize);
+                while (n < newsize) place_init(data + n++, value);
+            }
+        }
+
+        /// 清空元素
+        void clear() noexcept
+        {
+            for (xyu::size_t i = 0; i < n; ++i) data[i].~T();
+            n = 0;
+        }
+        /// 释放内存 (回到内置模式)
+        void release() noexcept
+        {
+            clear();
+            if (XY_LIKELY(is_inline())) return;
+            xyu::dealloc<T>(data, capa);
+            data = local();
+            capa = N;
+        }
+
+        /* 尾增 */
+
+        /**
+         * @brief 尾部增加元素 (多元素)
+         * @note 将每一个 args 作为一个元素添加到尾部
+         */
+        template <typename Tag = void, typename... Args, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && xyu::t_can_init<T, xyu::t_args_get<xyu::typelist_c<Args..., void>, 0>>, bool> = true>
+        SmallVector& append(Args&&... args)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            static_assert((... && xyu::t_can_init<T, Args>));
+            static_assert(sizeof...(args) <= limit());
+            append_help<(... && xyu::t_can_nothrow_init<T, Args>)>(n + sizeof...(args),
+                         [&]{ (..., place_init(data + n++, xyu::forward<Args>(args))); },
+                         [&](T* newdata, xyu::size_t& i){ (..., place_init(newdata + i++, xyu::forward<Args>(args))); });
+            return *this;
+        }
+
+        /**
+         * @brief 尾部增加元素 (范围)
+         * @note 将 range 中的每一个元素添加到尾部
+         */
+        template <typename Tag = void, typename Rg, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && !xyu::t_can_init<T, Rg> && xyu::t_is_range<Rg>, bool> = true>
+        SmallVector& append(Rg&& range)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            check_add(range.count());
+            append_help<xyu::t_can_nothrow_init<T, decltype(*range.begin())>>(n + range.count(),
+                         [&]{ for (auto&& v : range) place_init(data + n++, xyu::forward<decltype(v)>(v)); },
+                         [&](T* newdata, xyu::size_t& i){ for (auto&& v : range) place_init(newdata + i++, xyu::forward<decltype(v)>(v)); });
+            return *this;
+        }
+
+        /**
+         * @brief 尾部增加元素 (构造范围)
+         * @note 将 args 构造为一个 xyu::range 后，逐元素添加到尾部
+         */
+        template <typename Tag = void, typename Arg, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && !xyu::t_can_init<T, Arg> && !xyu::t_is_range<Arg>, bool> = true>
+        SmallVector& append(Arg&& arg)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            static_assert(xyu::t_can_make_range<Arg>);
+            return append<Tag>(xyu::make_range(arg));
+        }
+
+        /**
+         * @brief 尾部增加元素 (单元素)
+         * @tparam Tag 显式指定为 xyu::special_t
+         * @note 将 args 作为一个元素的构造参数添加到尾部
+         */
+        template <typename Tag, typename... Args, xyu::t_enable<xyu::t_is_same<Tag, xyu::special_t>, bool> = false>
+        SmallVector& append(Args&&... args)
+        {
+            static_assert(xyu::t_can_init<T, Args...>);
+            append_help<xyu::t_can_nothrow_init<T, Args...>>(n + 1,
+                                 [&]{ place_init(data + n++, xyu::forward<Args>(args)...); },
+                                 [&](T* newdata, xyu::size_t& i){ place_init(newdata + i++, xyu::forward<Args>(args)...); });
+            return *this;
+        }
+
+        /// 尾部增加元素 (初始化列表)
+        SmallVector& append(std::initializer_list<T> il) { return append(xyu::make_range(il)); }
+
+        /* 插入 */
+
+        /**
+         * @brief 中间插入元素 (多元素)
+         * @note 将每一个 args 作为一个元素依次插入到 index 位置
+         * @note 若 index 越界，则在尾部插入
+         */
+        template <typename Tag = void, typename... Args, xyu::t_enable<sizeof...(Args) && !xyu::t_is_same<Tag, xyu::special_t> && xyu::t_can_init<T, xyu::t_args_get<xyu::typelist_c<Args..., void>, 0>>, bool> = true>
+        SmallVector& insert(xyu::size_t index, Args&&... args)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            static_assert((... && xyu::t_can_init<T, Args>));
+            static_assert(sizeof...(args) <= limit());
+            insert_help<(... && xyu::t_can_nothrow_init<T, Args>)>(index, sizeof...(Args),
+                                 [&]{ (..., place_init(data + index++, xyu::forward<Args>(args))); },
+                                 [&](T* newdata, xyu::size_t& i){ (..., place_init(newdata + i++, xyu::forward<Args>(args))); });
+            return *this;
+        }
+
+        /**
+         * @brief 中间插入元素 (范围)
+         * @note 将 range 中的每一个元素依次插入到 index 位置
+         * @note 若 index 越界，则在尾部插入
+         */
+        template <typename Tag = void, typename Rg, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && !xyu::t_can_init<T, Rg> && xyu::t_is_range<Rg>, bool> = true>
+        SmallVector& insert(xyu::size_t index, Rg&& range)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            check_add(range.count());
+            insert_help<xyu::t_can_nothrow_init<T, decltype(*range.begin())>>(index, range.count(),
+                         [&]{ for (auto&& v : range) place_init(data + index++, xyu::forward<decltype(v)>(v)); },
+                         [&](T* newdata, xyu::size_t& i){ for (auto&& v : range) place_init(newdata + i++, xyu::forward<decltype(v)>(v)); });
+            return *this;
+        }
+
+        /**
+         * @brief 中间插入元素 (构造范围)
+         * @note 将 args 构造为一个 xyu::range 后，逐元素插入到 index 位置
+         * @note 若 index 越界，则在尾部插入
+         */
+        template <typename Tag = void, typename Arg, xyu::t_enable<!xyu::t_is_same<Tag, xyu::special_t> && !xyu::t_can_init<T, Arg> && !xyu::t_is_range<Arg>, bool> = true>
+        SmallVector& insert(xyu::size_t index, Arg&& arg)
+        {
+            static_assert(xyu::t_is_same<Tag, void>);
+            static_assert(xyu::t_can_make_range<Arg>);
+            return insert<Tag>(index, xyu::make_range(arg));
+        }
+
+        /**
+         * @brief 中间插入元素 (单元素)
+         * @tparam Tag 显式指定为 xyu::special_t
+         * @note 将 args 作为一个元素的构造参数依次插入到 index 位置
+         * @note 若 index 越界，则在尾部插入
+         */
+        template <typename Tag, typename... Args, xyu::t_enable<xyu::t_is_same<Tag, xyu::special_t>, bool> = false>
+        SmallVector& insert(xyu::size_t index, Args&&... args)
+        {
+            static_assert(xyu::t_can_init<T, Args...>);
+            insert_help<xyu::t_can_nothrow_init<T, Args...>>(index, 1,
+                    [&]{ place_init(data + index, xyu::forward<Args>(args)...); },
+                    [&](T* newdata, xyu::size_t& i){ place_init(newdata + i++, xyu::forward<Args>(args)...); });
+            return *this;
+        }
+
+        /// 中间插入元素 (初始化列表)
+        SmallVector& insert(xyu::size_t index, std::initializer_list<T> il) { return insert(index, xyu::make_range(il)); }
+
+        /* 删除 */
+
+        /// 删除索引开始的 count(默认为1) 个元素
+        SmallVector& erase(xyu::size_t index, xyu::size_t count = 1)
+        {
+            if (XY_UNLIKELY(index >= n)) return *this;
+            if (n - index <= count) while (n > index) data[--n].~T();
+            else {
+                xyu::size_t i;
+                for (i = index; i < n - count; ++i) data[i] = xyu::move(data[i + count]);
+                for (; i < n; ++i) data[i].~T();
+                n -= count;
+            }
+            return *this;
+        }
+
+        /* 范围 */
+
+        /// 创建范围
+        auto range() noexcept { return xyu::make_range(n, data, data + n); }
+        /// 创建范围 (const)
+        auto range() const noexcept { return xyu::make_range(n, data, data + n).crange(); }
+
+        /* 运算符 */
+
+        /**
+         * @brief 索引访问 (可修改)
+         * @note 支持负索引，即 [-count,-1] 映射到 [0,count-1]
+         * @note (-∞,-count) 与 [count,+∞) 则 映射到 两端 即 0 和 count-1
+         */
+        T& operator[](xyu::diff_t index) XY_NOEXCEPT_NDEBUG
+        {
+            auto i = static_cast<xyu::size_t>(index);
+            if (index >= 0) return get(i >= n ? n - 1 : i);
+            else return get(XY_UNLIKELY((i += n) >= n) ? 0 : i);
+        }
+        /**
+         * @brief 索引访问 (不可修改)
+         * @note 支持负索引，即 [-count,-1] 映射到 [0,count-1]
+         * @note (-∞,-count) 与 [count,+∞) 则 映射到 两端 即 0 和 count-1
+         */
+        const T& operator[](xyu::diff_t index) const XY_NOEXCEPT_NDEBUG
+        { return const_cast<SmallVector*>(this)->operator[](index); }
+
+        /// 尾部添加元素
+        template <typename Arg>
+        SmallVector& operator<<(Arg&& arg) { return append(xyu::forward<Arg>(arg)); }
+
+    private:
+        // 获取内置存储
+        T* local() noexcept { return reinterpret_cast<T*>(buf); }
+
+        // 释放堆内存 (内置模式时不做处理)
+        void back_data() noexcept { if (!is_inline()) xyu::dealloc<T>(data, capa); }
+
+        // 接管另一个容器的元素 (当前容器需为空且处于内置模式)
+        void take(SmallVector& other) noexcept(xyu::t_can_nothrow_mvconstr<T>)
+        {
+            // 内置模式，逐个移动元素
+            if (other.is_inline())
+            {
+                xyu::size_t i = 0;
+                if constexpr (xyu::t_can_nothrow_mvconstr<T>)
+                    for (; i < other.n; ++i) ::new (data + i) T{xyu::move(other.data[i])};
+                else try { for (; i < other.n; ++i) ::new (data + i) T{xyu::move(other.data[i])}; }
+                    catch (...) {
+                        for (; i > 0;) data[--i].~T();
+                        throw;
+                    }
+                n = other.n;
+                other.clear();
+            }
+            // 堆模式，直接接管内存
+            else
+            {
+                data = other.data;
+                n = other.n;
+                capa = other.capa;
+                other.data = other.local();
+                other.n = 0;
+                other.capa = N;
+            }
+        }
+
+        // 就地构造新元素
+        template <typename... Args>
+        void place_init(void* p, Args&&... args) noexcept(xyu::t_can_nothrow_init<T, Args...>)
+        {
+            if constexpr (xyu::t_is_aggregate<T>) ::new (p) T{xyu::forward<Args>(args)...};
+            else ::new (p) T(xyu::forward<Args>(args)...);
+        }
+
+        // 检查增加的元素数量
+        static void check_add(xyu::size_t count)
+        {
+            if (XY_UNLIKELY(count > limit())) {
+                xyloge(false, "E_Memory_Capacity: add {} over limit {}", count, limit());
+                throw xyu::E_Memory_Capacity{};
+            }
+        }
+        // 计算新容量
+        xyu::size_t calc_new_capa(xyu::size_t mincapa) const
+        {
+            if (XY_UNLIKELY(mincapa > limit())) {
+                xyloge(false, "E_Memory_Capacity: capacity {} over limit {}", capa, limit());
+                throw xyu::E_Memory_Capacity{};
+            }
+            return xyu::max(mincapa, static_cast<xyu::size_t>(capa * K_grow_factor));
+        }
+        // 重新分配内存 (新容量不超过 N 时转移到内置存储)
+        void realloc_capa(xyu::size_t newcapa)
+        {
+            // 重新分配内存
+            bool loc = newcapa <= N;
+            if (loc) newcapa = N;
+            T* newdata = loc ? local() : xyu::alloc<T>(newcapa);
+            // 资源转移
+            if constexpr (xyu::t_can_nothrow_mvconstr<T>) {
+                for (xyu::size_t i = 0; i < n; ++i) {
+                    ::new (newdata + i) T{xyu::move(data[i])};
+                    data[i].~T();
+                }
+            } else {
+                xyu::size_t i = 0;
+                try { for (; i < n; ++i) ::new (newdata + i) T{xyu::move(data[i])}; }
+                catch (...) {
+                    for (; i > 0;) newdata[--i].~T();
+                    if (!loc) xyu::dealloc<T>(newdata, newcapa);
+                    throw;
+                }
+                for (i = 0; i < n; ++i) data[i].~T();
+            }
+            // 释放旧内存
+            back_data();
+            // 更新状态
+            data = newdata;
+            capa = newcapa;
+        }
+
+        // append 辅助函数
+        // 扩容时，先构造新元素，再释放旧元素，保证插入容器内元素时不会因扩容而失效
+        template <bool nothrow_init, typename AppFun, typename ReFun>
+        void append_help(xyu::size_t newn, AppFun af, ReFun rf)
+        {
+            if (newn <= capa) af();
+            else {
+                xyu::size_t newcapa = calc_new_capa(newn);
+                T* newdata = xyu::alloc<T>(newcapa);
+                xyu::size_t i = n;
+                // 构造新元素
+                if constexpr (nothrow_init) rf(newdata, i);
+                else try { rf(newdata, i); }
+                    catch (...) {
+                        --i; while (i > n) newdata[--i].~T();
+                        xyu::dealloc<T>(newdata, newcapa);
+                        throw;
+                    }
+                // 移动旧元素
+                if constexpr (xyu::t_can_nothrow_mvconstr<T>)
+                    for (i = 0; i < n; ++i) {
+                        ::new (newdata + i) T{xyu::move(data[i])};
+                        data[i].~T();
+                    }
+                else {
+                    try { for (i = 0; i < n; ++i) ::new (newdata + i) T{xyu::move(data[i])}; }
+                    catch (...) {
+                        for (; i > 0;) newdata[--i].~T();
+                        for (i = newn; i > n;) newdata[--i].~T();
+                        xyu::dealloc<T>(newdata, newcapa);
+                        throw;
+                    }
+                    for (i = 0; i < n; ++i) data[i].~T();
+                }
+                // 释放旧内存
+                back_data();
+                // 更新状态
+                n = newn;
+                data = newdata;
+                capa = newcapa;
+            }
+        }
+
+        // insert 辅助函数
+        // 扩容时，先构造新元素，再释放旧元素，保证插入容器内元素时不会因扩容而失效
+        template <bool nothrow_init, typename InsFun, typename ReFun>
+        void insert_help(xyu::size_t index, xyu::size_t count, InsFun sf, ReFun rf)
+        {
+            if (XY_UNLIKELY(index >= n)) index = n;
+            xyu::size_t newn = n + count;
+            // 容量足够
+            if (newn <= capa)
+            {
+                // 移动构造
+                xyu::size_t i = n, j = n - xyu::min(count, n - index);
+                if constexpr (xyu::t_can_nothrow_mvconstr<T>)
+                    for (; i > j;) --i, ::new (data + i + count) T{xyu::move(data[i])};
+                else try { for (; i > j;) --i, ::new (data + i + count) T{xyu::move(data[i])}; }
+                    catch (...) {
+                        for (++i; i < n; ++i) data[i].~T();
+                        throw;
+                    }
+                // 移动赋值
+                if constexpr (xyu::t_can_nothrow_mvassign<T>)
+                    for (; i > index;) --i, data[i + count] = xyu::move(data[i]);
+                else try { for (; i > index;) --i, data[i + count] = xyu::move(data[i]); }
+                    catch (...) {
+                        for (; j < n; ++j) data[j].~T();
+                        throw;
+                    }
+                n = newn;
+                // 新元素赋值
+                sf();
+            }
+            // 容量不足
+            else
+            {
+                // 重新分配内存
+                xyu::size_t newcapa = calc_new_capa(newn);
+                T* newdata = xyu::alloc<T>(newcapa);
+                // 构造新元素
+                xyu::size_t i = index;
+                if constexpr (nothrow_init) rf(newdata, i);
+                else try { rf(newdata, i); }
+                    catch (...) {
+                        --i; while (i > index) newdata[--i].~T();
+                        xyu::dealloc<T>(newdata, newcapa);
+                        throw;
+                    }
+                // 移动旧元素
+                i = 0;
+                if constexpr (xyu::t_can_nothrow_mvconstr<T>) {
+                    for (; i < index; ++i) {
+                        ::new (newdata + i) T{xyu::move(data[i])};
+                        data[i].~T();
+                    }
+                    for (; i < n; ++i) {
+                        ::new (newdata + i + count) T{xyu::move(data[i])};
+                        data[i].~T();
+                    }
+                } else {
+                    try {
+                        for (; i < index; ++i) ::new (newdata + i) T{xyu::move(data[i])};
+                        for (; i < n; ++i) ::new (newdata + i + count) T{xyu::move(data[i])};
+                    } catch (...) {
+                        for (; i > index;) newdata[--i + count].~T();
+                        for (; i > 0;) newdata[--i].~T();
+                        for (i = index + count; i > index;) newdata[--i].~T();
+                        xyu::dealloc<T>(newdata, newcapa);
+                        throw;
+                    }
+                    for (i = 0; i < n; ++i) data[i].~T();
+                }
+                // 释放旧内存
+                back_data();
+                // 更新状态
+                n = newn;
+                data = newdata;
+                capa = newcapa;
+            }
+        }
+
+    private:
+        static_assert(K_grow_factor >= 1);
+        static_assert(K_shrink_factor <= 1 && K_shrink_factor > 0);
+    };
+}
+
+#pragma clang diagnostic pop
\ No newline at end of file
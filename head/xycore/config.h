@@ -22,6 +22,15 @@ namespace xylu::xycore
     // 是否不使用多线程 (导入线程库时进行静态断言)
     #define XY_UNTHREAD 0
 
+    // Linux 下是否使用 futex 实现 Mutex 和 CondVar (关闭时使用 pthread，其他平台忽略)
+    #define XY_FUTEX 1
+
+    // 是否编译锁竞争分析 (开启后 Mutex/Mutex_RW 在竞争时可记录等待与持有时间，运行时由 LockProfiler::enable() 启动)
+    #define XY_LOCK_PROFILE 0
+
+    // 红黑树是否维护子树节点数量 (开启后支持 at_rank / rank_of / count_range 按序查询，每个节点额外占用一个 size_t)
+    #define XY_RBTREE_RANK 0
+
     // 日志等级 (仅用于设置 XY_LOG_LEVEL 宏，之后会被 undef，使用 N_LOG_XX 枚举代替)
     #define XY_LOG_LEVEL_NONE   0
     #define XY_LOG_LEVEL_FATAL  1
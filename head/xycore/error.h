@@ -283,6 +283,22 @@ namespace xylu::xycore
     struct E_CondVar_Not_Owned : E_CondVar, E_Mutex_Not_Owned {};
 }
 
+/// 事件循环异常类
+namespace xylu::xycore
+{
+    /// 事件循环异常基类
+    struct E_Reactor : E_Resource {};
+
+    /// 系统资源空间不足
+    struct E_Reactor_No_Memory : E_Reactor, E_Resource_No_Memory {};
+
+    /// 文件描述符或监听数量达到上限
+    struct E_Reactor_Limit : E_Reactor {};
+
+    /// 文件描述符无效或不支持监听
+    struct E_Reactor_Invalid_State : E_Reactor, E_Resource_Invalid_State {};
+}
+
 
 // 异常信息输出
 namespace xylu::xystring::__
@@ -0,0 +1,180 @@
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "OCUnusedGlobalDeclarationInspection"
+#pragma ide diagnostic ignored "modernize-use-nodiscard"
+#pragma once
+
+#include "../../link/function"
+#include "../../link/vector"
+#include "../../link/atomic"
+#include "../../link/time"
+
+// 是否支持事件循环 (Linux 下基于 epoll)
+#if defined(__linux__) && !defined(__CYGWIN__)
+#define XY_REACTOR 1
+#else
+#define XY_REACTOR 0
+#endif
+
+#if XY_REACTOR
+
+/* 事件循环 */
+
+namespace xylu::xysystem
+{
+    namespace __
+    {
+        // 文件描述符的事件处理器 (实现于源文件)
+        struct ReactorHandler;
+    }
+
+    /**
+     * @brief 基于 epoll 的事件循环 (Reactor)，在一个线程中处理大量管道、套接字与定时器。
+     *
+     * @details
+     *   注册的文件描述符以边沿触发 (EPOLLET) 方式监听，就绪时调用对应的回调 `cb(fd, events)`。
+     *   每次等待最多取出 K_batch 个事件并依次分发，减少系统调用次数。
+     *
+     *   ### 使用方式:
+     *   - `add(fd, events, cb)` / `modify(fd, events)` / `remove(fd)`: 管理文件描述符 (需为非阻塞)。
+     *   - `add_timer(first, interval, cb)`: 创建 timerfd 定时器，返回其文件描述符 (由 Reactor 持有并关闭)。
+     *   - `poll()` / `poll_for(timeout)` / `run()`: 处理一批事件 / 最多等待 timeout / 循环直到 `stop()`。
+     *   - `wakeup()` / `stop()`: 可在任意线程调用，通过 eventfd 唤醒等待中的事件循环。
+     *
+     * @note 边沿触发：回调中应当读写直到返回 EAGAIN，否则剩余的数据不会再次通知。
+     * @note 除 wakeup 与 stop 外，其他操作只能在事件循环所在线程中调用 (包括在回调中)。
+     * @note 回调中可以安全地移除任意文件描述符 (包括自身)，处理器在本批次结束后才释放。
+     * @note 回调抛出异常时仍会处理本批次剩余的事件，之后将第一个异常传播到 poll/run 的调用者。
+     *
+     * @example
+     *   xyu::Reactor r;
+     *   r.add(sock, xyu::Reactor::READ, [](int fd, xyu::uint32 ev) { ... read until EAGAIN ... });
+     *   r.add_timer(xyu::Duration_ms{100}, xyu::Duration_ms{100}, [&](int, xyu::uint32) { r.stop(); });
+     *   r.run();
+     */
+    class Reactor : xyu::class_no_copy_move_t
+    {
+    public:
+        /// 事件
+        enum Event : xyu::uint32
+        {
+            READ    = 1 << 0,   // 可读 (注册时同时监听对端关闭)
+            WRITE   = 1 << 1,   // 可写
+            ERROR   = 1 << 2,   // 出错 (仅回调时报告，总是监听)
+            HANGUP  = 1 << 3,   // 挂断或对端关闭 (仅回调时报告，总是监听)
+        };
+
+        /// 事件回调 (文件描述符, 就绪的事件)
+        using Callback = xyu::Function<void(int, xyu::uint32)>;
+
+        /// 每次等待最多处理的事件数量
+        static constexpr xyu::size_t K_batch = 64;
+
+    private:
+        int ep = -1;                            // epoll 句柄
+        int wfd = -1;                           // 跨线程唤醒的 eventfd
+        xyu::Atomic<bool> stopped{false};       // 是否请求停止 run
+        bool dispatching = false;               // 是否正在分发事件
+        xyu::Vector<__::ReactorHandler*> hs;    // 按文件描述符索引的处理器
+        __::ReactorHandler* dead = nullptr;     // 分发期间移除的处理器 (批次结束后释放)
+
+    public:
+        /* 构造析构 */
+
+        /**
+         * @brief 创建事件循环
+         * @exception E_Reactor_* 创建 epoll 或 eventfd 失败
+         */
+        Reactor();
+
+        /// 析构 (关闭定时器与内部句柄，不关闭通过 add 注册的文件描述符)
+        ~Reactor() noexcept;
+
+        /* 注册 */
+
+        /**
+         * @brief 注册文件描述符
+         * @param events 监听的事件 (READ | WRITE)
+         * @exception E_Logic_Invalid_Argument fd 无效或已注册
+         * @exception E_Reactor_Invalid_State fd 不支持 epoll (如普通文件)
+         * @exception E_Reactor_* 其他错误
+         */
+        void add(int fd, xyu::uint32 events, Callback cb);
+
+        /**
+         * @brief 修改监听的事件
+         * @exception E_Logic_Invalid_Argument fd 未注册
+         * @exception E_Reactor_* 其他错误
+         */
+        void modify(int fd, xyu::uint32 events);
+
+        /**
+         * @brief 移除文件描述符 (不关闭；定时器由此关闭)
+         * @note fd 未注册时忽略
+         */
+        void remove(int fd) noexcept;
+
+        /// fd 是否已注册
+        bool contains(int fd) const noexcept;
+
+        /**
+         * @brief 创建定时器
+         * @param first 首次到期的时间 (从当前时间开始，单调时钟)
+         * @param interval 之后的周期 (为 0 时仅触发一次)
+         * @param cb 到期时的回调 (事件为 READ；回调前已读取到期次数，多次到期合并为一次回调)
+         * @return 定时器的文件描述符 (用于 remove)
+         * @exception E_Reactor_* 创建定时器失败
+         */
+        template <typename T, T Scale, typename U, U Scale2>
+        int add_timer(const xyu::Duration<T, Scale>& first, const xyu::Duration<U, Scale2>& interval, Callback cb)
+        { return add_timer_help(xyu::Duration_ns{first}.count, xyu::Duration_ns{interval}.count, xyu::move(cb)); }
+
+        /* 事件循环 */
+
+        /**
+         * @brief 等待并处理一批事件 (没有事件时阻塞)
+         * @return 处理的事件数量 (被信号中断时返回 0)
+         * @exception E_Reactor_* 等待失败
+         * @exception ... 回调抛出的异常
+         */
+        xyu::size_t poll() { return poll_help(-1); }
+
+        /**
+         * @brief 等待并处理一批事件，最多等待 timeout (为 0 时不等待)
+         * @return 处理的事件数量 (超时时返回 0)
+         */
+        template <typename T, T Scale>
+        xyu::size_t poll_for(const xyu::Duration<T, Scale>& timeout)
+        {
+            if (timeout.count <= 0) return poll_help(0);
+            // 向上取整到毫秒 (避免提前返回导致空转)
+            xyu::int64 ms = (xyu::Duration_ns{timeout}.count + 999999) / 1000000;
+            return poll_help(ms > 0x7FFFFFFF ? 0x7FFFFFFF : static_cast<int>(ms));
+        }
+
+        /**
+         * @brief 循环处理事件，直到调用 stop()
+         * @note 返回时清除停止请求，之后可以再次调用
+         */
+        void run();
+
+        /// 请求 run 返回 (线程安全)
+        void stop() noexcept;
+
+        /// 唤醒等待中的 poll/run (线程安全)
+        void wakeup() noexcept;
+
+    private:
+        // 等待并处理一批事件 (timeout_ms < 0 时无限等待)
+        xyu::size_t poll_help(int timeout_ms);
+        // 创建定时器
+        int add_timer_help(xyu::int64 first_ns, xyu::int64 interval_ns, Callback cb);
+        // 注册处理器
+        void add_help(int fd, xyu::uint32 events, Callback cb, bool timer);
+        // 释放分发期间移除的处理器
+        void reap() noexcept;
+    };
+}
+
+#endif
+
+#pragma clang diagnostic pop
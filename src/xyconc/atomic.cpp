@@ -0,0 +1,163 @@
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/atomic.h"
+#include "../../link/mutex"
+#if !XY_MUTEX_FUTEX
+#include "../../link/condvar"
+#include "../../link/thread"
+#endif
+
+namespace
+{
+    // 散列桶数量
+    constexpr xyu::size_t K_park_count = 256;
+
+    // 地址等待的散列桶 (按地址散列，等待的变量中无需存储额外状态)
+    struct alignas(xyu::K_CACHE_LINE_SIZE) AddrPark
+    {
+        xyu::Atomic<xyu::uint32> w{0};      // 等待线程数量 (为 0 时唤醒不进入内核)
+#if XY_MUTEX_FUTEX
+        xyu::Atomic<xyu::uint32> seq{0};    // 通知序号 (散列桶等待时 futex 等待于此)
+#else
+        xyu::Mutex m;                       // 锁
+        xyu::CondVar cv;                    // 唤醒通知
+#endif
+    };
+
+    // 获取地址对应的散列桶
+    AddrPark& park(const void* addr) noexcept
+    {
+        static AddrPark parks[K_park_count];
+        return parks[(reinterpret_cast<xyu::size_t>(addr) >> 2) % K_park_count];
+    }
+
+#if !XY_MUTEX_FUTEX
+    // 转换为 UTC 时间
+    xyu::Duration_ns utc_of(xyu::size_t s, xyu::size_t ns) noexcept
+    { return xyu::Duration_ns{static_cast<xyu::int64>(s) * 1000000000 + static_cast<xyu::int64>(ns)}; }
+
+    // 32 位字仍然等于 *val (没有 futex 时，32 位字的等待同样使用散列桶)
+    bool same_word(const void* addr, const void* val) noexcept
+    {
+        return static_cast<const xyu::Atomic<xyu::uint32>*>(addr)->load(xyu::N_ATOMIC_ACQUIRE)
+               == *static_cast<const xyu::uint32*>(val);
+    }
+#endif
+}
+
+namespace xylu::xyconc
+{
+#if XY_MUTEX_FUTEX
+    void __::wait_addr(const void* addr, xyu::uint32 val) noexcept
+    {
+        auto& p = park(addr);
+        // 与唤醒者的屏障配对：要么本线程看到新值 (futex 内核检查)，要么唤醒者看到等待线程
+        p.w.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        futex_wait(const_cast<void*>(addr), val);
+        p.w.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+    }
+
+    bool __::wait_addr_to(const void* addr, xyu::uint32 val, xyu::size_t s, xyu::size_t ns) noexcept
+    {
+        auto& p = park(addr);
+        p.w.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        bool ret = futex_wait_to(const_cast<void*>(addr), val, s, ns);
+        p.w.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+        return ret;
+    }
+
+    void __::wake_addr(const void* addr, int n) noexcept
+    {
+        auto& p = park(addr);
+        xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+        if (XY_UNLIKELY(p.w.load(xyu::N_ATOMIC_RELAXED) != 0)) futex_wake(const_cast<void*>(addr), n);
+    }
+
+    void __::park_wait(const void* addr, bool (*still)(const void*, const void*) noexcept, const void* arg) noexcept
+    {
+        auto& p = park(addr);
+        // 先读取通知序号再检查条件：之后的通知会修改序号，futex 等待立即返回
+        p.w.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        xyu::uint32 s = p.seq.load(xyu::N_ATOMIC_ACQUIRE);
+        if (still(addr, arg)) futex_wait(&p.seq, s);
+        p.w.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+    }
+
+    bool __::park_wait_to(const void* addr, bool (*still)(const void*, const void*) noexcept, const void* arg,
+                          xyu::size_t s, xyu::size_t ns) noexcept
+    {
+        auto& p = park(addr);
+        bool ret = true;
+        p.w.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        xyu::uint32 sq = p.seq.load(xyu::N_ATOMIC_ACQUIRE);
+        if (still(addr, arg)) ret = futex_wait_to(&p.seq, sq, s, ns);
+        p.w.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+        return ret;
+    }
+
+    void __::park_wake(const void* addr) noexcept
+    {
+        auto& p = park(addr);
+        xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+        if (XY_UNLIKELY(p.w.load(xyu::N_ATOMIC_RELAXED) != 0)) {
+            p.seq.fetch_add(1, xyu::N_ATOMIC_RELEASE);
+            futex_wake(&p.seq, K_wake_all);
+        }
+    }
+#else
+    void __::park_wait(const void* addr, bool (*still)(const void*, const void*) noexcept, const void* arg) noexcept
+    {
+        auto& p = park(addr);
+        // 与唤醒者的屏障配对：要么本线程看到新值，要么唤醒者看到等待线程并在锁内通知
+        p.w.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        try {
+            auto g = p.m.guard();
+            if (still(addr, arg)) p.cv.wait(g);
+        } catch (...) {
+            // 无法挂起时退化为让步 (调用者重新检查)
+            Thread_Native::yield();
+        }
+        p.w.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+    }
+
+    bool __::park_wait_to(const void* addr, bool (*still)(const void*, const void*) noexcept, const void* arg,
+                          xyu::size_t s, xyu::size_t ns) noexcept
+    {
+        auto& p = park(addr);
+        xyu::Duration_ns utc = utc_of(s, ns);
+        bool ret = true;
+        p.w.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        try {
+            auto g = p.m.guard();
+            if (still(addr, arg)) ret = p.cv.wait_to(g, utc);
+        } catch (...) {
+            Thread_Native::yield();
+            ret = xyu::Duration_utc() < utc;
+        }
+        p.w.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+        return ret;
+    }
+
+    void __::park_wake(const void* addr) noexcept
+    {
+        auto& p = park(addr);
+        xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+        if (XY_UNLIKELY(p.w.load(xyu::N_ATOMIC_RELAXED) != 0)) {
+            try {
+                auto g = p.m.guard();
+                p.cv.notify_all();
+            } catch (...) {}
+        }
+    }
+
+    void __::wait_addr(const void* addr, xyu::uint32 val) noexcept { park_wait(addr, same_word, &val); }
+
+    bool __::wait_addr_to(const void* addr, xyu::uint32 val, xyu::size_t s, xyu::size_t ns) noexcept
+    { return park_wait_to(addr, same_word, &val, s, ns); }
+
+    void __::wake_addr(const void* addr, int) noexcept { park_wake(addr); }
+#endif
+}
+
+#endif
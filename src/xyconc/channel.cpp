@@ -0,0 +1,256 @@
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/channel.h"
+#include "../../link/log"
+
+namespace
+{
+    using xylu::xyconc::Channel_Base;
+    using xylu::xyconc::__::ChanParker;
+    using xylu::xyconc::__::ChanWaiter;
+
+    // 内部锁上锁失败后，挂起前的最大自旋次数 (临界区只有若干次指针操作与一次元素移动)
+    constexpr int K_spin_count = 100;
+    // 栈上可容纳的 select 分支数量 (更多时分配临时内存)
+    constexpr xyu::size_t K_select_inline = 8;
+
+    // 完成等待者 (需持有对应通道的锁，等待者已被认领)
+    void finish(ChanWaiter& w, bool ok) noexcept
+    {
+        ChanParker* pk = w.pk;
+        pk->fired = w.idx;
+        pk->ok = ok;
+        // 写入 2 后等待线程可能立即返回并释放停靠点，唤醒旧地址最多造成其他线程的虚假唤醒
+        pk->st.store(2, xyu::N_ATOMIC_RELEASE);
+        xylu::xyconc::__::wake_addr(&pk->st, 1);
+    }
+
+    // 挂起直到停靠点完成
+    void park(ChanParker& pk) noexcept
+    {
+        for (xyu::uint32 s = pk.st.load(xyu::N_ATOMIC_ACQUIRE); s != 2; s = pk.st.load(xyu::N_ATOMIC_ACQUIRE))
+            xylu::xyconc::__::wait_addr(&pk.st, s);
+    }
+
+    // select 的临时存储
+    struct SelectSlot
+    {
+        ChanWaiter w;           // 分支的等待者
+        Channel_Base* ch;       // 按地址排序并去重后的通道 (仅前 m 个有效)
+    };
+
+    // 每个线程的 select 起点 (轮换，避免总是优先完成靠前的分支)
+    thread_local xyu::size_t tl_select_start = 0;
+}
+
+namespace xylu::xyconc
+{
+    void Channel_Base::lock() const noexcept
+    {
+        // 无竞争
+        if (XY_LIKELY(lk.compare_exchange_strong(0, 1, xyu::N_ATOMIC_ACQUIRE))) return;
+        for (int i = 0; i < K_spin_count; ++i)
+        {
+            xyu::cpu_pause();
+            xyu::uint32 c = lk.load(xyu::N_ATOMIC_RELAXED);
+            if (c == 0 && lk.compare_exchange_strong(0, 1, xyu::N_ATOMIC_ACQUIRE)) return;
+            if (c == 2) break;
+        }
+        // 状态设置为 2，使解锁者知道需要唤醒
+        while (lk.exchange(2, xyu::N_ATOMIC_ACQUIRE) != 0) __::wait_addr(&lk, 2);
+    }
+
+    void Channel_Base::unlock() const noexcept
+    {
+        if (XY_UNLIKELY(lk.exchange(0, xyu::N_ATOMIC_RELEASE) == 2)) __::wake_addr(&lk, 1);
+    }
+
+    xyu::size_t Channel_Base::size() const noexcept
+    {
+        lock();
+        xyu::size_t n = cnt;
+        unlock();
+        return n;
+    }
+
+    bool Channel_Base::closed() const noexcept
+    {
+        lock();
+        bool c = cl;
+        unlock();
+        return c;
+    }
+
+    bool Channel_Base::close() noexcept
+    {
+        lock();
+        if (cl) { unlock(); return false; }
+        cl = true;
+        // 唤醒所有等待者 (接收者此时缓冲区必为空，均返回失败)
+        while (ChanWaiter* w = claim(false)) finish(*w, false);
+        while (ChanWaiter* w = claim(true)) finish(*w, false);
+        unlock();
+        return true;
+    }
+
+    Channel_Base::State Channel_Base::op(bool send, void* elem, bool block) noexcept
+    {
+        lock();
+        State r = attempt(send, elem);
+        if (r != WOULD_BLOCK || !block) { unlock(); return r; }
+        // 等待对端 (对端认领时将等待者移出队列)
+        ChanParker pk;
+        ChanWaiter w{&pk, elem, 0, nullptr, nullptr, false};
+        enqueue(w, send);
+        unlock();
+        park(pk);
+        return pk.ok ? OK : CLOSED;
+    }
+
+    Channel_Base::State Channel_Base::attempt(bool send, void* elem) noexcept
+    {
+        if (send)
+        {
+            if (cl) return CLOSED;
+            // 有接收者在等待时缓冲区必为空，直接交接
+            if (ChanWaiter* w = claim(false)) {
+                ops->give(w->elem, elem);
+                finish(*w, true);
+                return OK;
+            }
+            if (cnt < cap) {
+                xyu::size_t i = head + cnt;
+                ops->put(buf, i < cap ? i : i - cap, elem);
+                ++cnt;
+                return OK;
+            }
+            return WOULD_BLOCK;
+        }
+        else
+        {
+            if (cnt) {
+                ops->take(buf, head, elem);
+                if (++head == cap) head = 0;
+                --cnt;
+                // 有发送者在等待时缓冲区原本是满的，将其元素放入空出的位置 (保持先进先出)
+                if (ChanWaiter* w = claim(true)) {
+                    xyu::size_t i = head + cnt;
+                    ops->put(buf, i < cap ? i : i - cap, w->elem);
+                    ++cnt;
+                    finish(*w, true);
+                }
+                return OK;
+            }
+            // 无缓冲 (或缓冲区为空时的发送者)，直接交接
+            if (ChanWaiter* w = claim(true)) {
+                ops->give(elem, w->elem);
+                finish(*w, true);
+                return OK;
+            }
+            return cl ? CLOSED : WOULD_BLOCK;
+        }
+    }
+
+    void Channel_Base::enqueue(__::ChanWaiter& w, bool send) noexcept
+    {
+        __::ChanQueue& q = send ? sq : rq;
+        w.prev = q.tail;
+        w.next = nullptr;
+        if (q.tail) q.tail->next = &w;
+        else q.head = &w;
+        q.tail = &w;
+        w.linked = true;
+    }
+
+    void Channel_Base::unlink(__::ChanWaiter& w, bool send) noexcept
+    {
+        __::ChanQueue& q = send ? sq : rq;
+        if (w.prev) w.prev->next = w.next;
+        else q.head = w.next;
+        if (w.next) w.next->prev = w.prev;
+        else q.tail = w.prev;
+        w.linked = false;
+    }
+
+    __::ChanWaiter* Channel_Base::claim(bool send) noexcept
+    {
+        __::ChanQueue& q = send ? sq : rq;
+        while (ChanWaiter* w = q.head)
+        {
+            unlink(*w, send);
+            // 同一个 select 的其他分支已完成时认领失败，丢弃该等待者 (由其所属线程在返回前确认已移出)
+            if (w->pk->st.compare_exchange_strong(0, 1, xyu::N_ATOMIC_ACQUIRE)) return w;
+        }
+        return nullptr;
+    }
+}
+
+namespace xylu::xyconc::__
+{
+    Select_Result select_help(const Channel_Case* cases, xyu::size_t n, bool block)
+    {
+        if (XY_UNLIKELY(n == 0)) {
+            if (!block) return {Select_Result::K_none, false};
+            xyloge(0, "E_Logic_Invalid_Argument: select without any case would block forever");
+            throw xyu::E_Logic_Invalid_Argument{};
+        }
+        SelectSlot local[K_select_inline];
+        SelectSlot* ss = n <= K_select_inline ? local : xyu::alloc<SelectSlot>(xyu::native_v, n);
+
+        // 按地址顺序对所有通道上锁 (同一通道只锁一次)，避免多个 select 之间死锁
+        xyu::size_t m = 0;
+        for (xyu::size_t i = 0; i < n; ++i)
+        {
+            Channel_Base* c = cases[i].ch;
+            xyu::size_t j = m;
+            while (j > 0 && ss[j - 1].ch > c) --j;
+            if (j > 0 && ss[j - 1].ch == c) continue;
+            for (xyu::size_t k = m; k > j; --k) ss[k].ch = ss[k - 1].ch;
+            ss[j].ch = c;
+            ++m;
+        }
+        auto lock_all = [&] { for (xyu::size_t i = 0; i < m; ++i) ss[i].ch->lock(); };
+        auto unlock_all = [&] { for (xyu::size_t i = m; i-- > 0; ) ss[i].ch->unlock(); };
+        auto release = [&] { if (ss != local) xyu::dealloc<SelectSlot>(xyu::native_v, ss, n); };
+
+        // 持有所有锁时检查是否有就绪的分支 (其他线程不能同时认领本线程的等待者)
+        lock_all();
+        xyu::size_t start = tl_select_start++ % n;
+        for (xyu::size_t j = 0; j < n; ++j)
+        {
+            xyu::size_t i = start + j < n ? start + j : start + j - n;
+            const Channel_Case& c = cases[i];
+            Channel_Base::State r = c.ch->attempt(c.send, c.elem);
+            if (r != Channel_Base::WOULD_BLOCK) {
+                unlock_all();
+                release();
+                return {i, r == Channel_Base::OK};
+            }
+        }
+        if (!block) {
+            unlock_all();
+            release();
+            return {Select_Result::K_none, false};
+        }
+
+        // 在所有通道上登记后只挂起一次
+        ChanParker pk;
+        for (xyu::size_t i = 0; i < n; ++i) {
+            ss[i].w = ChanWaiter{&pk, cases[i].elem, i, nullptr, nullptr, false};
+            cases[i].ch->enqueue(ss[i].w, cases[i].send);
+        }
+        unlock_all();
+        park(pk);
+
+        // 移出其余分支的等待者
+        lock_all();
+        for (xyu::size_t i = 0; i < n; ++i)
+            if (ss[i].w.linked) cases[i].ch->unlink(ss[i].w, cases[i].send);
+        unlock_all();
+        release();
+        return {pk.fired, pk.ok};
+    }
+}
+
+#endif
@@ -7,6 +7,7 @@
 #else
 #include <pthread.h>
 #include <errno.h>
+#include <limits.h>
 #endif
 
 #include "../../link/config"
@@ -20,7 +21,7 @@ namespace
 #ifdef XY_WINDOWS
     CONDITION_VARIABLE* cv(void*& h) noexcept { return reinterpret_cast<CONDITION_VARIABLE*>(&h); }
     SRWLOCK* m(void* h) noexcept { return reinterpret_cast<SRWLOCK*>(h); }
-#else
+#elif !XY_MUTEX_FUTEX
     pthread_cond_t* cv(void* h) noexcept { return static_cast<pthread_cond_t*>(h); }
     pthread_mutex_t* m(void* h) noexcept { return static_cast<pthread_mutex_t*>(h); }
 #endif
@@ -49,7 +50,7 @@ namespace
                 unknown_error(line, func, err);
         }
     }
-#else
+#elif !XY_MUTEX_FUTEX
     [[noreturn]] void create_error(xyu::uint line, const char* func, int err)
     {
         switch (err) {
@@ -113,6 +114,45 @@ namespace
 
 namespace xylu::xyconc
 {
+#if XY_MUTEX_FUTEX
+    void CondVar::notify_one()
+    {
+        h.seq.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        if (h.wn.load(xyu::N_ATOMIC_SEQ_CST)) __::futex_wake(&h.seq, 1);
+    }
+
+    void CondVar::notify_all()
+    {
+        h.seq.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        if (h.wn.load(xyu::N_ATOMIC_SEQ_CST)) __::futex_wake(&h.seq, INT_MAX);
+    }
+
+    void __::wait_help(void* cvh, void* mh)
+    {
+        auto& c = *static_cast<__::CondVar_Futex*>(cvh);
+        auto& m = *static_cast<xyu::Atomic<xyu::uint32>*>(mh);
+        // 先登记等待并读取序号，再解锁 (与通知者的 序号递增 -> 读取等待数量 配对，不会丢失通知)
+        c.wn.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        xyu::uint32 seq = c.seq.load(xyu::N_ATOMIC_SEQ_CST);
+        __::futex_unlock(m);
+        __::futex_wait(&c.seq, seq);
+        c.wn.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+        __::futex_lock(m);
+    }
+
+    bool __::wait_timeout_help(void* cvh, void* mh, xyu::size_t s, xyu::size_t ns)
+    {
+        auto& c = *static_cast<__::CondVar_Futex*>(cvh);
+        auto& m = *static_cast<xyu::Atomic<xyu::uint32>*>(mh);
+        c.wn.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        xyu::uint32 seq = c.seq.load(xyu::N_ATOMIC_SEQ_CST);
+        __::futex_unlock(m);
+        bool ret = __::futex_wait_to(&c.seq, seq, s, ns);
+        c.wn.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+        __::futex_lock(m);
+        return ret;
+    }
+#else
     CondVar::CondVar()
     {
 #ifdef XY_WINDOWS
@@ -195,6 +235,7 @@ namespace xylu::xyconc
         wait_error(__LINE__, __func__, r);
     }
 #endif
+#endif // XY_MUTEX_FUTEX
 
 }
 
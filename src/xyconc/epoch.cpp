@@ -0,0 +1,179 @@
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/epoch.h"
+#include "../../link/thread"
+
+namespace
+{
+    // 每积累多少个退休节点尝试回收一次
+    constexpr xyu::size_t K_batch = 64;
+}
+
+namespace xylu::xyconc::__
+{
+    // 退休节点
+    struct Retired
+    {
+        void* p;                            // 节点
+        void (*del)(void*) noexcept;        // 释放函数
+        xyu::size_t e;                      // 退休时的全局纪元
+    };
+
+    // 线程纪元记录
+    struct alignas(xyu::K_CACHE_LINE_SIZE) EpochRecord : xyu::class_no_copy_move_t
+    {
+        xyu::Atomic<xyu::size_t> local{0};  // 局部纪元 << 1 | 是否在临界区内 (仅所有者写入)
+        xyu::Atomic<bool> used{true};       // 是否被线程占用
+        EpochRecord* next = nullptr;        // 全局链表中的下一个记录 (发布后不再修改)
+        /* 以下仅所有者访问 */
+        xyu::size_t nest = 0;               // 临界区嵌套层数
+        Retired* bag = nullptr;             // 退休节点数组
+        xyu::size_t n = 0;                  // 退休节点数量
+        xyu::size_t capa = 0;               // 退休节点数组容量
+        xyu::size_t trigger = K_batch;      // 下次尝试回收时的退休节点数量
+        bool collecting = false;            // 是否正在回收 (释放函数中再次退休时不递归回收)
+    };
+}
+
+namespace
+{
+    using xylu::xyconc::__::EpochRecord;
+    using xylu::xyconc::__::Retired;
+
+    alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::size_t> g_epoch{0};    // 全局纪元
+    alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<EpochRecord*> g_head{nullptr};  // 纪元记录链表
+
+    // 尝试推进全局纪元 (所有处于临界区的线程都已观察到当前纪元时)
+    void try_advance() noexcept
+    {
+        // 与进入临界区时的屏障配对：要么本线程看到其局部纪元，要么其读取到之后的共享数据
+        xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+        xyu::size_t e = g_epoch.load(xyu::N_ATOMIC_RELAXED);
+        for (EpochRecord* r = g_head.load(xyu::N_ATOMIC_ACQUIRE); r; r = r->next) {
+            // 获取语义：退出临界区前的读取先于之后的释放
+            xyu::size_t l = r->local.load(xyu::N_ATOMIC_ACQUIRE);
+            if ((l & 1) && (l >> 1) != e) return;
+        }
+        g_epoch.compare_exchange_strong(e, e + 1, xyu::N_ATOMIC_SEQ_CST);
+    }
+
+    // 释放记录中已安全的退休节点
+    void reclaim(EpochRecord& r) noexcept
+    {
+        if (r.collecting) return;
+        r.collecting = true;
+        try_advance();
+        xyu::size_t e = g_epoch.load(xyu::N_ATOMIC_ACQUIRE);
+        // 先从数组中移除再调用释放函数 (释放函数中可能再次退休节点)
+        Retired tmp[K_batch];
+        for (;;)
+        {
+            xyu::size_t k = 0, j = 0;
+            for (xyu::size_t i = 0; i < r.n; ++i) {
+                if (k < K_batch && r.bag[i].e + 2 <= e) tmp[k++] = r.bag[i];
+                else r.bag[j++] = r.bag[i];
+            }
+            r.n = j;
+            for (xyu::size_t i = 0; i < k; ++i) tmp[i].del(tmp[i].p);
+            if (k < K_batch) break;
+        }
+        r.trigger = r.n + K_batch;
+        r.collecting = false;
+    }
+
+    // 获取空闲记录 (复用已结束线程的记录，否则分配新的记录)
+    EpochRecord* acquire()
+    {
+        for (EpochRecord* r = g_head.load(xyu::N_ATOMIC_ACQUIRE); r; r = r->next)
+            if (!r->used.load(xyu::N_ATOMIC_RELAXED) && r->used.compare_exchange_strong(false, true, xyu::N_ATOMIC_ACQUIRE))
+                return r;
+        auto r = ::new (xyu::alloc<EpochRecord>(xyu::native_v, 1)) EpochRecord{};
+        for (;;) {
+            EpochRecord* h = g_head.load(xyu::N_ATOMIC_RELAXED);
+            r->next = h;
+            if (g_head.compare_exchange_weak(h, r, xyu::N_ATOMIC_RELEASE)) return r;
+        }
+    }
+
+    // 线程的纪元记录 (线程结束时释放给其他线程复用，记录本身不释放)
+    // 线程结束时先释放全部退休节点：释放函数可能归还到本线程的内存池，不能留给复用该记录的线程
+    struct LocalRecord
+    {
+        EpochRecord* r = nullptr;
+
+        ~LocalRecord() noexcept
+        {
+            if (!r) return;
+            r->nest = 0;
+            r->local.store(0, xyu::N_ATOMIC_RELEASE);
+            // 等待其他线程的临界区结束，直到全部退休节点释放 (释放函数中可能再次退休节点)
+            for (;;) {
+                reclaim(*r);
+                if (!r->n) break;
+                xyu::Thread_Native::yield();
+            }
+            r->used.store(false, xyu::N_ATOMIC_RELEASE);
+        }
+    };
+
+    thread_local EpochRecord* tl_record = nullptr;
+
+    // 获取本线程的纪元记录
+    EpochRecord& record()
+    {
+        if (XY_UNLIKELY(!tl_record))
+        {
+            // 先构造线程内存池，使其晚于 owner 析构 (线程局部对象按构造的逆序析构)
+            xyu::dealloc<xyu::uint8>(xyu::alloc<xyu::uint8>(1), 1);
+            thread_local LocalRecord owner;
+            owner.r = tl_record = acquire();
+        }
+        return *tl_record;
+    }
+}
+
+namespace xylu::xyconc
+{
+    Epoch::Guard::Guard() : r{&record()}
+    {
+        if (r->nest++ == 0) {
+            r->local.store(g_epoch.load(xyu::N_ATOMIC_SEQ_CST) << 1 | 1, xyu::N_ATOMIC_RELAXED);
+            // 保证局部纪元的发布先于之后对共享数据的读取
+            xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+        }
+    }
+
+    Epoch::Guard::~Guard() noexcept
+    {
+        if (--r->nest == 0) r->local.store(0, xyu::N_ATOMIC_RELEASE);
+    }
+
+    void Epoch::retire(void* p, void (*deleter)(void*) noexcept)
+    {
+        EpochRecord& r = record();
+        if (XY_UNLIKELY(r.n == r.capa)) {
+            xyu::size_t nc = r.capa ? r.capa * 2 : K_batch;
+            Retired* nb = xyu::alloc<Retired>(xyu::native_v, nc);
+            for (xyu::size_t i = 0; i < r.n; ++i) nb[i] = r.bag[i];
+            if (r.bag) xyu::dealloc<Retired>(xyu::native_v, r.bag);
+            r.bag = nb;
+            r.capa = nc;
+        }
+        // 节点已在此之前摘除，之后进入临界区的线程不会再获取到该节点
+        r.bag[r.n++] = {p, deleter, g_epoch.load(xyu::N_ATOMIC_SEQ_CST)};
+        if (r.n >= r.trigger) reclaim(r);
+    }
+
+    void Epoch::collect() noexcept
+    {
+        if (tl_record) reclaim(*tl_record);
+    }
+
+    xyu::size_t Epoch::epoch() noexcept
+    {
+        return g_epoch.load(xyu::N_ATOMIC_RELAXED);
+    }
+}
+
+#endif
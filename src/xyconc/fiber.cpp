@@ -0,0 +1,564 @@
+#if !defined(_WIN32) && !defined(__CYGWIN__)
+#include <sys/mman.h>
+#include <unistd.h>
+#if !(defined(__x86_64__) && defined(__ELF__))
+#include <ucontext.h>
+#endif
+#endif
+
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/fiber.h"
+#if XY_FIBER
+#include "../../link/thread"
+#include "../../link/log"
+
+// 是否使用手写汇编切换上下文
+#if defined(__x86_64__) && defined(__ELF__)
+#define XY_FIBER_ASM 1
+#else
+#define XY_FIBER_ASM 0
+#endif
+
+#if XY_FIBER_ASM
+// 切换上下文：保存被调用者保存的寄存器与浮点控制字到当前栈，*from 记录当前栈顶，再恢复 to 栈上的上下文
+extern "C" void xylu_fiber_switch(void** from, void* to) noexcept;
+// 新纤程的首次切换返回到此处，调用 r12 中的入口函数
+extern "C" void xylu_fiber_start() noexcept;
+
+asm(R"(
+    .text
+    .p2align 4
+    .globl  xylu_fiber_switch
+    .hidden xylu_fiber_switch
+    .type   xylu_fiber_switch, @function
+xylu_fiber_switch:
+    pushq   %rbp
+    pushq   %rbx
+    pushq   %r12
+    pushq   %r13
+    pushq   %r14
+    pushq   %r15
+    subq    $8, %rsp
+    stmxcsr (%rsp)
+    fnstcw  4(%rsp)
+    movq    %rsp, (%rdi)
+    movq    %rsi, %rsp
+    ldmxcsr (%rsp)
+    fldcw   4(%rsp)
+    addq    $8, %rsp
+    popq    %r15
+    popq    %r14
+    popq    %r13
+    popq    %r12
+    popq    %rbx
+    popq    %rbp
+    ret
+    .size   xylu_fiber_switch, .-xylu_fiber_switch
+
+    .p2align 4
+    .globl  xylu_fiber_start
+    .hidden xylu_fiber_start
+    .type   xylu_fiber_start, @function
+xylu_fiber_start:
+    callq   *%r12
+    ud2
+    .size   xylu_fiber_start, .-xylu_fiber_start
+)");
+#endif
+
+namespace
+{
+#if XY_FIBER_ASM
+    // 上下文 (保存的栈顶)
+    using Context = void*;
+    // 保存当前上下文到 from，切换到 to
+    void swap_ctx(Context& from, Context& to) noexcept { xylu_fiber_switch(&from, to); }
+#else
+    using Context = ucontext_t;
+    void swap_ctx(Context& from, Context& to) noexcept { swapcontext(&from, &to); }
+#endif
+
+    // 线程内缓存的栈数量上限
+    constexpr xyu::size_t K_stack_cache = 64;
+    // 等待队列自旋锁让步前的自旋次数
+    constexpr int K_spin_count = 64;
+}
+
+namespace xylu::xyconc::__
+{
+    struct FiberSched;
+
+    // 等待节点
+    struct FiberWaiter
+    {
+        FiberWaiter* next = nullptr;        // 队列中的下一个
+        FiberBlock* f = nullptr;            // 等待的纤程 (纤程外的线程等待时为 nullptr)
+        xyu::Atomic<xyu::uint32> ready{0};  // 是否已被唤醒
+    };
+
+    // 纤程控制块
+    struct FiberBlock
+    {
+        // 状态
+        enum State : xyu::uint8 { Ready, Running, Yielded, Suspended, Done };
+
+        Context ctx;                            // 上下文
+        FiberSched* sched;                      // 所属调度器
+        FiberBlock* next = nullptr;             // 就绪队列、远程队列或睡眠队列中的下一个
+        void* stack;                            // 栈 (含最低处的保护页)
+        xyu::size_t stack_size;                 // 栈总大小
+        void (*fun)(void*);                     // 入口
+        void* arg;                              // 入口参数
+        xyu::int64 wake = 0;                    // 睡眠到期时间 (单调时钟，纳秒)
+        State state = Ready;                    // 状态 (仅所属线程访问)
+        xyu::Atomic<xyu::uint32> refs{2};       // 引用计数 (句柄 + 调度器)
+        xyu::Atomic<xyu::uint32> done{0};       // 是否已结束
+        FiberQueue joiners;                     // 等待结束的 join 调用者
+        xyu::ErrorPtr ep;                       // 抛出的异常
+    };
+
+    // 线程的纤程调度器
+    struct FiberSched
+    {
+        Context ctx;                                // 调度循环的上下文
+        FiberBlock* cur = nullptr;                  // 正在执行的纤程
+        FiberBlock* head = nullptr;                 // 就绪队列首
+        FiberBlock* tail = nullptr;                 // 就绪队列尾
+        FiberBlock* sleep = nullptr;                // 睡眠队列 (按到期时间排序)
+        xyu::Atomic<FiberBlock*> remote{nullptr};   // 远程队列 (其他线程唤醒的纤程，后进先出)
+        xyu::Atomic<xyu::uint32> sig{0};            // 远程唤醒序号 (调度器空闲时等待于此)
+        xyu::size_t alive = 0;                      // 未结束的纤程数量
+        void* stacks[K_stack_cache];                // 缓存的默认大小的栈
+        xyu::size_t nstack = 0;                     // 缓存的栈数量
+
+        ~FiberSched() noexcept;
+    };
+}
+
+namespace
+{
+    using xylu::xyconc::__::FiberBlock;
+    using xylu::xyconc::__::FiberSched;
+    using xylu::xyconc::__::FiberWaiter;
+    using xylu::xyconc::__::FiberQueue;
+
+    thread_local FiberSched tl_sched;
+
+    /* 栈 */
+
+    // 页大小
+    xyu::size_t page_size() noexcept
+    {
+        static const xyu::size_t n = static_cast<xyu::size_t>(sysconf(_SC_PAGESIZE));
+        return n;
+    }
+
+    // 默认大小的栈总大小 (含保护页)
+    xyu::size_t default_stack_total() noexcept { return xyu::Fiber::K_stack_size + page_size(); }
+
+    // 分配栈 (最低处为保护页)
+    void* stack_alloc(FiberSched& s, xyu::size_t total)
+    {
+        if (total == default_stack_total() && s.nstack) return s.stacks[--s.nstack];
+        void* p = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+        if (XY_UNLIKELY(p == MAP_FAILED)) {
+            xyloge(0, "E_Memory_Alloc: cannot map fiber stack of {} bytes", total);
+            throw xyu::E_Memory_Alloc{};
+        }
+        if (XY_UNLIKELY(mprotect(p, page_size(), PROT_NONE))) {
+            munmap(p, total);
+            xyloge(0, "E_Memory_Alloc: cannot protect fiber stack guard page");
+            throw xyu::E_Memory_Alloc{};
+        }
+        return p;
+    }
+
+    // 释放栈 (默认大小的栈缓存在线程内)
+    void stack_free(FiberSched& s, void* p, xyu::size_t total) noexcept
+    {
+        if (total == default_stack_total() && s.nstack < K_stack_cache) s.stacks[s.nstack++] = p;
+        else munmap(p, total);
+    }
+
+    /* 等待队列 */
+
+    void qlock(FiberQueue& q) noexcept
+    {
+        while (q.lk.exchange(true, xyu::N_ATOMIC_ACQUIRE))
+            for (int i = 0; q.lk.load(xyu::N_ATOMIC_RELAXED); ++i)
+                if (i < K_spin_count) xyu::cpu_pause();
+                else xyu::Thread_Native::yield();
+    }
+
+    void qunlock(FiberQueue& q) noexcept { q.lk.store(false, xyu::N_ATOMIC_RELEASE); }
+
+    void qpush(FiberQueue& q, FiberWaiter* w) noexcept
+    {
+        w->next = nullptr;
+        if (q.tail) q.tail->next = w;
+        else q.head = w;
+        q.tail = w;
+    }
+
+    FiberWaiter* qpop(FiberQueue& q) noexcept
+    {
+        FiberWaiter* w = q.head;
+        if (w && !(q.head = w->next)) q.tail = nullptr;
+        return w;
+    }
+
+    // 取出队列中的所有等待者
+    FiberWaiter* qtake(FiberQueue& q) noexcept
+    {
+        FiberWaiter* w = q.head;
+        q.head = q.tail = nullptr;
+        return w;
+    }
+
+    /* 调度 */
+
+    void push_ready(FiberSched& s, FiberBlock* f) noexcept
+    {
+        f->state = FiberBlock::Ready;
+        f->next = nullptr;
+        if (s.tail) s.tail->next = f;
+        else s.head = f;
+        s.tail = f;
+    }
+
+    FiberBlock* pop_ready(FiberSched& s) noexcept
+    {
+        FiberBlock* f = s.head;
+        if (f && !(s.head = f->next)) s.tail = nullptr;
+        return f;
+    }
+
+    // 将挂起的纤程加入其调度器的就绪队列 (其他线程通过远程队列)
+    void schedule(FiberBlock* f) noexcept
+    {
+        FiberSched& o = *f->sched;
+        if (&o == &tl_sched) return push_ready(o, f);
+        for (;;) {
+            FiberBlock* h = o.remote.load(xyu::N_ATOMIC_RELAXED);
+            f->next = h;
+            if (o.remote.compare_exchange_weak(h, f, xyu::N_ATOMIC_RELEASE)) break;
+        }
+        o.sig.fetch_add(1, xyu::N_ATOMIC_RELEASE);
+        o.sig.notify_one();
+    }
+
+    // 将远程队列中的纤程移入就绪队列 (保持唤醒顺序)
+    void drain_remote(FiberSched& s) noexcept
+    {
+        if (!s.remote.load(xyu::N_ATOMIC_RELAXED)) return;
+        FiberBlock* r = s.remote.exchange(nullptr, xyu::N_ATOMIC_ACQUIRE);
+        FiberBlock* prev = nullptr;
+        while (r) { FiberBlock* n = r->next; r->next = prev; prev = r; r = n; }
+        while (prev) { FiberBlock* n = prev->next; push_ready(s, prev); prev = n; }
+    }
+
+    // 将到期的睡眠纤程移入就绪队列
+    void wake_sleepers(FiberSched& s, xyu::int64 now) noexcept
+    {
+        while (s.sleep && s.sleep->wake <= now) {
+            FiberBlock* f = s.sleep;
+            s.sleep = f->next;
+            push_ready(s, f);
+        }
+    }
+
+    // 释放控制块的引用
+    void unref(FiberBlock* f) noexcept
+    {
+        if (f->refs.fetch_sub(1, xyu::N_ATOMIC_ACQ_REL) == 1) {
+            f->~FiberBlock();
+            xyu::dealloc<FiberBlock>(xyu::native_v, f);
+        }
+    }
+
+    // 挂起当前纤程，切换到调度循环
+    void suspend(FiberSched& s, FiberBlock::State st) noexcept
+    {
+        FiberBlock* f = s.cur;
+        f->state = st;
+        swap_ctx(f->ctx, s.ctx);
+    }
+
+    // 等待节点被唤醒
+    void park(FiberWaiter& w) noexcept
+    {
+        if (w.f) do suspend(tl_sched, FiberBlock::Suspended); while (!w.ready.load(xyu::N_ATOMIC_ACQUIRE));
+        else while (!w.ready.load(xyu::N_ATOMIC_ACQUIRE)) w.ready.wait(0, xyu::N_ATOMIC_ACQUIRE);
+    }
+
+    // 唤醒等待节点 (之后不再访问节点，节点可能随等待者返回而失效)
+    void wake(FiberWaiter* w) noexcept
+    {
+        FiberBlock* f = w->f;
+        if (f) {
+            w->ready.store(1, xyu::N_ATOMIC_RELEASE);
+            schedule(f);
+        } else {
+            w->ready.store(1, xyu::N_ATOMIC_RELEASE);
+            w->ready.notify_one();
+        }
+    }
+
+    // 唤醒链表中的所有等待节点
+    void wake_all(FiberWaiter* w) noexcept
+    {
+        while (w) {
+            FiberWaiter* n = w->next;
+            wake(w);
+            w = n;
+        }
+    }
+
+    // 纤程入口 (从调度器获取当前纤程，结束后切换回调度循环，不再返回)
+    void fiber_main() noexcept
+    {
+        FiberSched& s = tl_sched;
+        FiberBlock* f = s.cur;
+        try { f->fun(f->arg); }
+        catch (...) { f->ep = xyu::ErrorPtr::current(); }
+        qlock(f->joiners);
+        f->done.store(1, xyu::N_ATOMIC_RELEASE);
+        FiberWaiter* w = qtake(f->joiners);
+        qunlock(f->joiners);
+        wake_all(w);
+        suspend(s, FiberBlock::Done);
+        __builtin_unreachable();
+    }
+
+    // 切换到纤程执行，返回后根据其状态处理
+    void resume(FiberSched& s, FiberBlock* f) noexcept
+    {
+        s.cur = f;
+        f->state = FiberBlock::Running;
+        swap_ctx(s.ctx, f->ctx);
+        s.cur = nullptr;
+        if (f->state == FiberBlock::Yielded) push_ready(s, f);
+        else if (f->state == FiberBlock::Done) {
+            stack_free(s, f->stack, f->stack_size);
+            --s.alive;
+            unref(f);
+        }
+    }
+
+    // 执行调度循环，直到所有纤程结束 (until 为空时) 或 until 结束
+    void run_loop(FiberSched& s, FiberBlock* until) noexcept
+    {
+        for (;;)
+        {
+            if (until ? until->done.load(xyu::N_ATOMIC_ACQUIRE) != 0 : s.alive == 0) return;
+            // 先读取唤醒序号再检查队列：之后的远程唤醒会修改序号，等待立即返回
+            xyu::uint32 sig = s.sig.load(xyu::N_ATOMIC_ACQUIRE);
+            drain_remote(s);
+            xyu::int64 now = 0;
+            if (s.sleep) wake_sleepers(s, now = xyu::Duration_any().count);
+            if (FiberBlock* f = pop_ready(s)) { resume(s, f); continue; }
+            // 空闲时挂起线程，直到远程唤醒或最近的睡眠到期
+            if (s.sleep) s.sig.wait_for(sig, xyu::Duration_ns{s.sleep->wake - now}, xyu::N_ATOMIC_ACQUIRE);
+            else s.sig.wait(sig, xyu::N_ATOMIC_ACQUIRE);
+        }
+    }
+
+    // 等待纤程结束
+    void wait_done(FiberBlock* b)
+    {
+        if (b->done.load(xyu::N_ATOMIC_ACQUIRE)) return;
+        FiberSched& s = tl_sched;
+        if (XY_UNLIKELY(s.cur == b)) {
+            xyloge(0, "E_Logic_Invalid_Argument: fiber cannot join itself");
+            throw xyu::make_error(xyu::E_Thread_Deadlock{}, xyu::E_Logic_Invalid_Argument{});
+        }
+        // 所属线程的纤程外：执行调度循环直到其结束
+        if (!s.cur && b->sched == &s) return run_loop(s, b);
+        FiberWaiter w;
+        w.f = s.cur;
+        qlock(b->joiners);
+        if (b->done.load(xyu::N_ATOMIC_RELAXED)) { qunlock(b->joiners); return; }
+        qpush(b->joiners, &w);
+        qunlock(b->joiners);
+        park(w);
+    }
+}
+
+namespace xylu::xyconc
+{
+    __::FiberSched::~FiberSched() noexcept
+    {
+        for (xyu::size_t i = 0; i < nstack; ++i) munmap(stacks[i], default_stack_total());
+    }
+
+    __::FiberBlock* __::fiber_spawn(void (*fun)(void*), void* arg, xyu::size_t stack_size)
+    {
+        FiberSched& s = tl_sched;
+        xyu::size_t page = page_size();
+        xyu::size_t total = (stack_size + page - 1) / page * page + page;
+        void* stk = stack_alloc(s, total);
+        FiberBlock* f;
+        try { f = ::new (xyu::alloc<FiberBlock>(xyu::native_v, 1)) FiberBlock{}; }
+        catch (...) { stack_free(s, stk, total); throw; }
+        f->sched = &s;
+        f->stack = stk;
+        f->stack_size = total;
+        f->fun = fun;
+        f->arg = arg;
+#if XY_FIBER_ASM
+        // 初始栈帧与 xylu_fiber_switch 保存的布局一致：
+        // [mxcsr, fpu 控制字] [r15] [r14] [r13] [r12 = 入口] [rbx] [rbp] [返回地址 = xylu_fiber_start]
+        // 返回后栈顶 16 字节对齐，call 入口时满足 ABI 要求
+        auto top = (reinterpret_cast<xyu::size_t>(stk) + total) & ~static_cast<xyu::size_t>(15);
+        auto sp = reinterpret_cast<void**>(top - 80);
+        auto csr = reinterpret_cast<xyu::uint32*>(sp);
+        csr[0] = 0x1F80;    // mxcsr 默认值
+        csr[1] = 0x037F;    // x87 控制字默认值
+        for (int i = 1; i < 7; ++i) sp[i] = nullptr;
+        sp[4] = reinterpret_cast<void*>(fiber_main);
+        sp[7] = reinterpret_cast<void*>(xylu_fiber_start);
+        f->ctx = sp;
+#else
+        getcontext(&f->ctx);
+        f->ctx.uc_stack.ss_sp = static_cast<char*>(stk) + page;
+        f->ctx.uc_stack.ss_size = total - page;
+        f->ctx.uc_link = nullptr;
+        makecontext(&f->ctx, fiber_main, 0);
+#endif
+        ++s.alive;
+        push_ready(s, f);
+        return f;
+    }
+
+    bool Fiber::done() const noexcept { return !b || b->done.load(xyu::N_ATOMIC_ACQUIRE); }
+
+    void Fiber::join()
+    {
+        if (XY_UNLIKELY(!b)) {
+            xyloge(0, "E_Thread_Invalid_State: fiber is not created");
+            throw xyu::E_Thread_Invalid_State{};
+        }
+        wait_done(b);
+        xyu::ErrorPtr ep = xyu::move(b->ep);
+        unref(b);
+        b = nullptr;
+        if (XY_UNLIKELY(ep)) ep.rethrow();
+    }
+
+    void Fiber::detach() noexcept
+    {
+        if (b) unref(b);
+        b = nullptr;
+    }
+
+    void Fiber::release() noexcept
+    {
+        if (!b) return;
+        // 纤程中析构自身的句柄时分离
+        if (tl_sched.cur != b) try { wait_done(b); } catch (...) {}
+        detach();
+    }
+
+    void Fiber::run()
+    {
+        FiberSched& s = tl_sched;
+        if (XY_UNLIKELY(s.cur)) {
+            xyloge(0, "E_Logic_Invalid_Argument: cannot run fiber scheduler inside a fiber");
+            throw xyu::make_error(xyu::E_Thread_Invalid_State{}, xyu::E_Logic_Invalid_Argument{});
+        }
+        run_loop(s, nullptr);
+    }
+
+    bool Fiber::in_fiber() noexcept { return tl_sched.cur != nullptr; }
+
+    void Fiber::yield() noexcept
+    {
+        FiberSched& s = tl_sched;
+        if (s.cur) suspend(s, FiberBlock::Yielded);
+        else Thread_Native::yield();
+    }
+
+    void Fiber::sleep_help(xyu::Duration_ns dt)
+    {
+        FiberSched& s = tl_sched;
+        if (!s.cur) return xyu::Clock::sleep(dt);
+        FiberBlock* f = s.cur;
+        f->wake = xyu::Duration_any().count + dt.count;
+        FiberBlock** p = &s.sleep;
+        while (*p && (*p)->wake <= f->wake) p = &(*p)->next;
+        f->next = *p;
+        *p = f;
+        suspend(s, FiberBlock::Suspended);
+    }
+
+    void FiberMutex::lock_help()
+    {
+        for (;;)
+        {
+            qlock(q);
+            xyu::uint32 c = s.load(xyu::N_ATOMIC_RELAXED);
+            if (c == 0) {
+                bool ok = s.compare_exchange_strong(0, 1, xyu::N_ATOMIC_ACQUIRE);
+                qunlock(q);
+                if (ok) return;
+                continue;
+            }
+            // 标记有等待者 (与持有者无等待者时的解锁竞争)
+            if (c == 1 && !s.compare_exchange_strong(1, 2, xyu::N_ATOMIC_RELAXED)) { qunlock(q); continue; }
+            FiberWaiter w;
+            w.f = tl_sched.cur;
+            qpush(q, &w);
+            qunlock(q);
+            // 被唤醒时锁已移交给本等待者
+            park(w);
+            return;
+        }
+    }
+
+    void FiberMutex::unlock_help() noexcept
+    {
+        qlock(q);
+        FiberWaiter* w = qpop(q);
+        if (!w) s.store(0, xyu::N_ATOMIC_RELEASE);
+        else s.store(q.head ? 2 : 1, xyu::N_ATOMIC_RELAXED);
+        qunlock(q);
+        if (w) wake(w);
+    }
+
+    void FiberCondVar::notify_one() noexcept
+    {
+        qlock(q);
+        FiberWaiter* w = qpop(q);
+        qunlock(q);
+        if (w) wake(w);
+    }
+
+    void FiberCondVar::notify_all() noexcept
+    {
+        qlock(q);
+        FiberWaiter* w = qtake(q);
+        qunlock(q);
+        wake_all(w);
+    }
+
+    void FiberCondVar::wait(FiberMutex::Guard& guard)
+    {
+        if (XY_UNLIKELY(!guard.is_locked())) {
+            xyloge(0, "E_Logic_Invalid_Argument: fiber condition variable waits with unlocked guard");
+            throw xyu::E_Logic_Invalid_Argument{};
+        }
+        FiberWaiter w;
+        w.f = tl_sched.cur;
+        qlock(q);
+        qpush(q, &w);
+        qunlock(q);
+        guard.unlock();
+        park(w);
+        guard.lock();
+    }
+}
+
+#endif
+#endif
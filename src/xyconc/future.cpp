@@ -0,0 +1,79 @@
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/future.h"
+#include "../../link/log"
+
+namespace
+{
+    using xylu::xyconc::__::FutureCont;
+
+    // 在工作线程中执行续体
+    void run_cont(void* arg) noexcept
+    {
+        auto k = static_cast<FutureCont*>(arg);
+        k->run(k);
+    }
+}
+
+namespace xylu::xyconc::__
+{
+    void FutureCore::complete() noexcept
+    {
+        // 续体与等待者只会有其一 (句柄只能被一个消费者使用)
+        xyu::uint32 old = st.exchange(Done, xyu::N_ATOMIC_ACQ_REL);
+        if (old == Attached) future_dispatch(cont);
+        // 生产者在返回后才释放引用，此时状态块仍然有效
+        else if (XY_UNLIKELY(old == Waited)) wake_addr(&st, K_wake_all);
+    }
+
+    void FutureCore::attach(FutureCont* k) noexcept
+    {
+        cont = k;
+        // 登记失败说明已完成，由登记者执行
+        if (!st.compare_exchange_strong(Pending, Attached, xyu::N_ATOMIC_ACQ_REL)) future_dispatch(k);
+    }
+
+    void FutureCore::wait() noexcept
+    {
+        // 设置为 Waited，使生产者知道需要唤醒
+        st.compare_exchange_strong(Pending, Waited, xyu::N_ATOMIC_ACQUIRE);
+        for (xyu::uint32 s = st.load(xyu::N_ATOMIC_ACQUIRE); s != Done; s = st.load(xyu::N_ATOMIC_ACQUIRE))
+            wait_addr(&st, s);
+    }
+
+    void future_dispatch(FutureCont* k) noexcept
+    {
+        if (k->ex) {
+            try { future_enqueue(*k->ex, k); return; }
+            catch (...) {}  // 提交失败时直接执行
+        }
+        k->run(k);
+    }
+
+    void future_enqueue(ThreadPool& pool, FutureCont* k)
+    {
+        pool.enqueue({run_cont, k});
+    }
+
+    void future_break(FutureCore* c) noexcept
+    {
+        try { throw xyu::E_Thread_Invalid_State{}; }
+        catch (...) { c->fail_current(); }
+        c->release();
+    }
+
+    void future_no_state()
+    {
+        xyloge(0, "E_Thread_Invalid_State: future has no shared state or its result is already set");
+        throw xyu::E_Thread_Invalid_State{};
+    }
+
+    void future_no_input()
+    {
+        xyloge(0, "E_Logic_Invalid_Argument: when_any without any input would never complete");
+        throw xyu::E_Logic_Invalid_Argument{};
+    }
+}
+
+#endif
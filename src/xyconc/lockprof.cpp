@@ -0,0 +1,266 @@
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/lockprof.h"
+#include "../../link/format"
+#include "../../link/log"
+
+namespace
+{
+    using xylu::xyconc::LockProfiler;
+
+    constexpr xyu::size_t K_capacity = LockProfiler::K_capacity;
+    constexpr xyu::size_t K_buckets = LockProfiler::K_buckets;
+    constexpr xyu::size_t K_sites = LockProfiler::K_sites;
+
+    static_assert(!(K_capacity & (K_capacity - 1)), "capacity must be power of 2");
+
+    // 一个锁的统计项 (含直方图与调用位置，占用多个缓存行；按缓存行对齐，不同锁的统计项不共享缓存行)
+    struct alignas(xyu::K_CACHE_LINE_SIZE) Entry
+    {
+        xyu::Atomic<xyu::size_t> key{0};            // 锁地址 (0 表示空闲)
+        xyu::Atomic<bool> rw{false};                // 是否为读写锁
+        xyu::Atomic<xyu::uint64> contended{0};      // 竞争上锁次数
+        xyu::Atomic<xyu::uint64> reads{0};          // 其中读锁的次数
+        xyu::Atomic<xyu::uint64> wait_sum{0};       // 等待时间总和
+        xyu::Atomic<xyu::uint64> wait_max{0};       // 最长等待时间
+        xyu::Atomic<xyu::uint64> hold_sum{0};       // 持有时间总和
+        xyu::Atomic<xyu::uint64> hold_max{0};       // 最长持有时间
+        xyu::Atomic<xyu::uint64> wait[K_buckets]{}; // 等待时间分布
+        xyu::Atomic<xyu::uint64> hold[K_buckets]{}; // 持有时间分布
+        xyu::Atomic<xyu::size_t> sites[K_sites]{};  // 调用位置 (0 表示空闲)
+        xyu::Atomic<xyu::uint64> counts[K_sites]{}; // 调用位置的竞争次数
+    };
+
+    // 统计表 (首次 enable 时分配，之后不释放，记录中的线程可以一直访问)
+    xyu::Atomic<Entry*> g_table{nullptr};
+    // 统计表已满而未记录的竞争次数
+    xyu::Atomic<xyu::uint64> g_dropped{0};
+
+    // 查找锁的统计项 (insert 为 true 时不存在则创建，表满时返回 nullptr)
+    Entry* find(const void* lock, bool insert) noexcept
+    {
+        Entry* t = g_table.load(xyu::N_ATOMIC_ACQUIRE);
+        if (XY_UNLIKELY(!t)) return nullptr;
+        auto k = reinterpret_cast<xyu::size_t>(lock);
+        // 斐波那契散列 (锁地址的低位通常相同)
+        xyu::size_t i = static_cast<xyu::size_t>((static_cast<xyu::uint64>(k) * 0x9E3779B97F4A7C15ull) >> 32) & (K_capacity - 1);
+        for (xyu::size_t n = 0; n < K_capacity; ++n, i = (i + 1) & (K_capacity - 1))
+        {
+            xyu::size_t c = t[i].key.load(xyu::N_ATOMIC_ACQUIRE);
+            if (c == k) return t + i;
+            if (c != 0) continue;
+            if (!insert) return nullptr;
+            if (t[i].key.compare_exchange_strong(0, k, xyu::N_ATOMIC_ACQ_REL)) return t + i;
+            // 其他线程抢先占用，可能是同一个锁
+            if (t[i].key.load(xyu::N_ATOMIC_ACQUIRE) == k) return t + i;
+        }
+        return nullptr;
+    }
+
+    // 时间所在的桶 (第 i 个桶为 [2^(i-1), 2^i) 纳秒)
+    xyu::size_t bucket(xyu::uint64 ns) noexcept
+    {
+        if (!ns) return 0;
+        xyu::size_t i = 64 - static_cast<xyu::size_t>(__builtin_clzll(ns));
+        return i < K_buckets ? i : K_buckets - 1;
+    }
+
+    // 更新最大值
+    void update_max(xyu::Atomic<xyu::uint64>& a, xyu::uint64 v) noexcept
+    {
+        xyu::uint64 c = a.load(xyu::N_ATOMIC_RELAXED);
+        while (v > c && !a.compare_exchange_weak(c, v, xyu::N_ATOMIC_RELAXED)) c = a.load(xyu::N_ATOMIC_RELAXED);
+    }
+
+    // 记录调用位置 (位置已满时不记录)
+    void add_site(Entry& e, xyu::size_t site) noexcept
+    {
+        for (xyu::size_t i = 0; i < K_sites; ++i)
+        {
+            xyu::size_t s = e.sites[i].load(xyu::N_ATOMIC_RELAXED);
+            if (s == 0) {
+                if (e.sites[i].compare_exchange_strong(0, site, xyu::N_ATOMIC_RELAXED)) s = site;
+                else s = e.sites[i].load(xyu::N_ATOMIC_RELAXED);
+            }
+            if (s == site) { e.counts[i].fetch_add(1, xyu::N_ATOMIC_RELAXED); return; }
+        }
+    }
+
+    // 读取统计项的快照
+    void snapshot(const Entry& e, LockProfiler::Stat& st) noexcept
+    {
+        st.lock = reinterpret_cast<const void*>(e.key.load(xyu::N_ATOMIC_RELAXED));
+        st.rw = e.rw.load(xyu::N_ATOMIC_RELAXED);
+        st.contended = e.contended.load(xyu::N_ATOMIC_RELAXED);
+        st.reads = e.reads.load(xyu::N_ATOMIC_RELAXED);
+        st.wait_sum = e.wait_sum.load(xyu::N_ATOMIC_RELAXED);
+        st.wait_max = e.wait_max.load(xyu::N_ATOMIC_RELAXED);
+        st.hold_sum = e.hold_sum.load(xyu::N_ATOMIC_RELAXED);
+        st.hold_max = e.hold_max.load(xyu::N_ATOMIC_RELAXED);
+        for (xyu::size_t i = 0; i < K_buckets; ++i) {
+            st.wait[i] = e.wait[i].load(xyu::N_ATOMIC_RELAXED);
+            st.hold[i] = e.hold[i].load(xyu::N_ATOMIC_RELAXED);
+        }
+        for (xyu::size_t i = 0; i < K_sites; ++i) {
+            xyu::size_t s = e.sites[i].load(xyu::N_ATOMIC_RELAXED);
+            st.sites[i] = reinterpret_cast<const void*>(s);
+            st.site_counts[i] = s ? e.counts[i].load(xyu::N_ATOMIC_RELAXED) : 0;
+        }
+        // 调用位置按竞争次数降序 (空位的次数为 0，排在最后)
+        for (xyu::size_t i = 1; i < K_sites; ++i)
+            for (xyu::size_t j = i; j > 0 && st.site_counts[j - 1] < st.site_counts[j]; --j) {
+                xyu::swap(st.sites[j - 1], st.sites[j]);
+                xyu::swap(st.site_counts[j - 1], st.site_counts[j]);
+            }
+    }
+
+    // 平均值
+    xyu::uint64 avg(xyu::uint64 sum, xyu::uint64 n) noexcept { return n ? sum / n : 0; }
+}
+
+namespace xylu::xyconc::__
+{
+    void lock_profile_wait(const void* lock, bool rw, bool read, xyu::int64 wait_ns, const void* site) noexcept
+    {
+        Entry* e = find(lock, true);
+        if (XY_UNLIKELY(!e)) { g_dropped.fetch_add(1, xyu::N_ATOMIC_RELAXED); return; }
+        if (rw && !e->rw.load(xyu::N_ATOMIC_RELAXED)) e->rw.store(true, xyu::N_ATOMIC_RELAXED);
+        e->contended.fetch_add(1, xyu::N_ATOMIC_RELAXED);
+        if (read) e->reads.fetch_add(1, xyu::N_ATOMIC_RELAXED);
+        xyu::uint64 w = wait_ns > 0 ? static_cast<xyu::uint64>(wait_ns) : 0;
+        e->wait_sum.fetch_add(w, xyu::N_ATOMIC_RELAXED);
+        update_max(e->wait_max, w);
+        e->wait[bucket(w)].fetch_add(1, xyu::N_ATOMIC_RELAXED);
+        add_site(*e, reinterpret_cast<xyu::size_t>(site));
+    }
+
+    void lock_profile_hold(const void* lock, xyu::int64 hold_ns) noexcept
+    {
+        Entry* e = find(lock, false);
+        if (XY_UNLIKELY(!e)) return;
+        xyu::uint64 h = hold_ns > 0 ? static_cast<xyu::uint64>(hold_ns) : 0;
+        e->hold_sum.fetch_add(h, xyu::N_ATOMIC_RELAXED);
+        update_max(e->hold_max, h);
+        e->hold[bucket(h)].fetch_add(1, xyu::N_ATOMIC_RELAXED);
+    }
+}
+
+namespace xylu::xyconc
+{
+    xyu::uint64 LockProfiler::Stat::quantile(const xyu::uint64 (&h)[K_buckets], double q) noexcept
+    {
+        xyu::uint64 total = 0;
+        for (auto c : h) total += c;
+        if (!total) return 0;
+        auto target = static_cast<xyu::uint64>(q * static_cast<double>(total));
+        if (target < 1) target = 1;
+        if (target > total) target = total;
+        xyu::uint64 cum = 0;
+        for (xyu::size_t i = 0; i < K_buckets; ++i)
+            if ((cum += h[i]) >= target) return xyu::uint64{1} << i;
+        return xyu::uint64{1} << (K_buckets - 1);
+    }
+
+    bool LockProfiler::enable()
+    {
+        if constexpr (!K_available) return false;
+        if (!g_table.load(xyu::N_ATOMIC_ACQUIRE))
+        {
+            Entry* t = xyu::alloc<Entry>(xyu::native_v, K_capacity, alignof(Entry));
+            for (xyu::size_t i = 0; i < K_capacity; ++i) ::new (t + i) Entry{};
+            // 多个线程同时开启时只保留一个统计表
+            if (!g_table.compare_exchange_strong(nullptr, t, xyu::N_ATOMIC_ACQ_REL))
+                xyu::dealloc<Entry>(xyu::native_v, t, K_capacity, alignof(Entry));
+        }
+        __::lock_profile_on.store(true, xyu::N_ATOMIC_RELEASE);
+        return true;
+    }
+
+    void LockProfiler::reset() noexcept
+    {
+        g_dropped.store(0, xyu::N_ATOMIC_RELAXED);
+        Entry* t = g_table.load(xyu::N_ATOMIC_ACQUIRE);
+        if (!t) return;
+        for (xyu::size_t i = 0; i < K_capacity; ++i)
+        {
+            Entry& e = t[i];
+            if (!e.key.load(xyu::N_ATOMIC_RELAXED)) continue;
+            e.contended.store(0, xyu::N_ATOMIC_RELAXED);
+            e.reads.store(0, xyu::N_ATOMIC_RELAXED);
+            e.wait_sum.store(0, xyu::N_ATOMIC_RELAXED);
+            e.wait_max.store(0, xyu::N_ATOMIC_RELAXED);
+            e.hold_sum.store(0, xyu::N_ATOMIC_RELAXED);
+            e.hold_max.store(0, xyu::N_ATOMIC_RELAXED);
+            for (auto& c : e.wait) c.store(0, xyu::N_ATOMIC_RELAXED);
+            for (auto& c : e.hold) c.store(0, xyu::N_ATOMIC_RELAXED);
+            for (auto& c : e.counts) c.store(0, xyu::N_ATOMIC_RELAXED);
+            for (auto& s : e.sites) s.store(0, xyu::N_ATOMIC_RELAXED);
+        }
+    }
+
+    xyu::uint64 LockProfiler::dropped() noexcept { return g_dropped.load(xyu::N_ATOMIC_RELAXED); }
+
+    xyu::size_t LockProfiler::top(Stat* out, xyu::size_t n) noexcept
+    {
+        Entry* t = g_table.load(xyu::N_ATOMIC_ACQUIRE);
+        if (!t || !n) return 0;
+        // 按等待时间总和选出前 n 个 (插入排序，n 通常很小)
+        Entry* best[K_capacity];
+        xyu::uint64 keys[K_capacity];
+        xyu::size_t cnt = 0;
+        if (n > K_capacity) n = K_capacity;
+        for (xyu::size_t i = 0; i < K_capacity; ++i)
+        {
+            Entry& e = t[i];
+            if (!e.key.load(xyu::N_ATOMIC_RELAXED) || !e.contended.load(xyu::N_ATOMIC_RELAXED)) continue;
+            xyu::uint64 w = e.wait_sum.load(xyu::N_ATOMIC_RELAXED);
+            if (cnt == n && keys[cnt - 1] >= w) continue;
+            xyu::size_t j = cnt < n ? cnt++ : cnt - 1;
+            for (; j > 0 && keys[j - 1] < w; --j) {
+                best[j] = best[j - 1];
+                keys[j] = keys[j - 1];
+            }
+            best[j] = &e;
+            keys[j] = w;
+        }
+        for (xyu::size_t i = 0; i < cnt; ++i) snapshot(*best[i], out[i]);
+        return cnt;
+    }
+
+    xyu::String LockProfiler::report(xyu::size_t n)
+    {
+        xyu::String s;
+        if constexpr (!K_available) {
+            s << "lock profiler is not compiled (XY_LOCK_PROFILE = 0)\n";
+            return s;
+        }
+        if (n > K_capacity) n = K_capacity;
+        Stat* st = n ? xyu::alloc<Stat>(xyu::native_v, n) : nullptr;
+        try {
+            xyu::size_t cnt = top(st, n);
+            xyfmtt(s, "lock contention: top {} locks by total wait (ns), {} dropped\n", cnt, dropped());
+            for (xyu::size_t i = 0; i < cnt; ++i)
+            {
+                const Stat& x = st[i];
+                xyfmtt(s, "#{} {} {}: contended {} (reads {})\n",
+                       i + 1, x.rw ? "Mutex_RW" : "Mutex", x.lock, x.contended, x.reads);
+                xyfmtt(s, "    wait: sum {} avg {} max {} p50 <{} p99 <{}\n",
+                       x.wait_sum, avg(x.wait_sum, x.contended), x.wait_max, Stat::quantile(x.wait, 0.5), Stat::quantile(x.wait, 0.99));
+                xyu::uint64 held = 0;
+                for (auto c : x.hold) held += c;
+                xyfmtt(s, "    hold: sum {} avg {} max {} p50 <{} p99 <{}\n",
+                       x.hold_sum, avg(x.hold_sum, held), x.hold_max, Stat::quantile(x.hold, 0.5), Stat::quantile(x.hold, 0.99));
+                for (xyu::size_t j = 0; j < K_sites && x.sites[j]; ++j)
+                    xyfmtt(s, "    site {}: {}\n", x.sites[j], x.site_counts[j]);
+            }
+        } catch (...) {
+            if (st) xyu::dealloc<Stat>(xyu::native_v, st, n);
+            throw;
+        }
+        if (st) xyu::dealloc<Stat>(xyu::native_v, st, n);
+        return s;
+    }
+}
+
+#endif
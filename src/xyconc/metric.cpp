@@ -0,0 +1,215 @@
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/metric.h"
+#include "../../link/thread"
+#include "../../link/log"
+
+namespace
+{
+    // 最大分片数量
+    constexpr xyu::size_t K_max_shards = 64;
+    // 缓存行中的计数数量
+    constexpr xyu::size_t K_line = xyu::K_CACHE_LINE_SIZE / sizeof(xyu::Atomic<xyu::uint64>);
+
+    // 下一个线程的分片下标
+    xyu::Atomic<xyu::size_t> g_next_shard{0};
+
+    // 分片数量 (不小于硬件线程数的 2 的幂，最多 K_max_shards)
+    xyu::size_t shards() noexcept
+    {
+        static const xyu::size_t n = [] {
+            xyu::size_t hw = xyu::Thread_Native::hardware_count(), k = 1;
+            while (k < hw && k < K_max_shards) k <<= 1;
+            return k;
+        }();
+        return n;
+    }
+
+    // 导出一个值的行的估计长度 (名称 + 后缀 + 数值)
+    constexpr xyu::size_t line_hint(xyu::size_t name) noexcept { return name + 48; }
+}
+
+namespace xylu::xyconc::__
+{
+    xyu::size_t metric_shard_assign() noexcept
+    {
+        xyu::size_t s = g_next_shard.fetch_add(1, xyu::N_ATOMIC_RELAXED) & (K_max_shards - 1);
+        tl_metric_shard = s;
+        return s;
+    }
+}
+
+namespace xylu::xyconc
+{
+    /* 计数器 */
+
+    Counter::Counter() : mask{shards() - 1}
+    {
+        c = xyu::alloc<__::MetricCell>(xyu::native_v, mask + 1);
+        for (xyu::size_t i = 0; i <= mask; ++i) ::new (c + i) __::MetricCell{};
+    }
+
+    Counter::~Counter() noexcept { xyu::dealloc<__::MetricCell>(xyu::native_v, c); }
+
+    xyu::uint64 Counter::value() const noexcept
+    {
+        xyu::uint64 sum = 0;
+        for (xyu::size_t i = 0; i <= mask; ++i) sum += c[i].v.load(xyu::N_ATOMIC_RELAXED);
+        return sum;
+    }
+
+    void Counter::reset() noexcept
+    {
+        for (xyu::size_t i = 0; i <= mask; ++i) c[i].v.store(0, xyu::N_ATOMIC_RELAXED);
+    }
+
+    /* 直方图 */
+
+    Histogram::Histogram(const xyu::int64* bounds, xyu::size_t count)
+        : bs{nullptr}, nb{count}, c{nullptr}, stride{(count + 2 + K_line - 1) / K_line * K_line}, mask{shards() - 1}
+    {
+        for (xyu::size_t i = 1; i < count; ++i)
+            if (XY_UNLIKELY(bounds[i - 1] >= bounds[i])) {
+                xyloge(0, "E_Logic_Invalid_Argument: histogram bounds are not strictly increasing at index {}", i);
+                throw xyu::E_Logic_Invalid_Argument{};
+            }
+        if (count) {
+            bs = xyu::alloc<xyu::int64>(xyu::native_v, count);
+            for (xyu::size_t i = 0; i < count; ++i) bs[i] = bounds[i];
+        }
+        // 每个分片独占若干完整的缓存行
+        try { c = xyu::alloc<xyu::Atomic<xyu::uint64>>(xyu::native_v, stride * (mask + 1), xyu::K_CACHE_LINE_SIZE); }
+        catch (...) { if (bs) xyu::dealloc<xyu::int64>(xyu::native_v, bs); throw; }
+        for (xyu::size_t i = 0; i < stride * (mask + 1); ++i) ::new (c + i) xyu::Atomic<xyu::uint64>{0};
+    }
+
+    Histogram::~Histogram() noexcept
+    {
+        xyu::dealloc<xyu::Atomic<xyu::uint64>>(xyu::native_v, c, stride * (mask + 1), xyu::K_CACHE_LINE_SIZE);
+        if (bs) xyu::dealloc<xyu::int64>(xyu::native_v, bs);
+    }
+
+    xyu::uint64 Histogram::bucket(xyu::size_t i) const noexcept
+    {
+        xyu::uint64 sum = 0;
+        for (xyu::size_t s = 0; s <= mask; ++s) sum += c[s * stride + i].load(xyu::N_ATOMIC_RELAXED);
+        return sum;
+    }
+
+    xyu::uint64 Histogram::count() const noexcept
+    {
+        xyu::uint64 sum = 0;
+        for (xyu::size_t s = 0; s <= mask; ++s)
+            for (xyu::size_t i = 0; i <= nb; ++i) sum += c[s * stride + i].load(xyu::N_ATOMIC_RELAXED);
+        return sum;
+    }
+
+    xyu::int64 Histogram::sum() const noexcept
+    {
+        // 按补码累加，负值同样正确
+        xyu::uint64 sum = 0;
+        for (xyu::size_t s = 0; s <= mask; ++s) sum += c[s * stride + nb + 1].load(xyu::N_ATOMIC_RELAXED);
+        return static_cast<xyu::int64>(sum);
+    }
+
+    void Histogram::reset() noexcept
+    {
+        for (xyu::size_t i = 0; i < stride * (mask + 1); ++i) c[i].store(0, xyu::N_ATOMIC_RELAXED);
+    }
+
+    /* 注册表 */
+
+    MetricRegistry::~MetricRegistry() noexcept
+    {
+        while (head) {
+            Entry* e = head;
+            head = e->next;
+            if (e->counter) { e->counter->~Counter(); xyu::dealloc<Counter>(xyu::native_v, e->counter); }
+            if (e->gauge) { e->gauge->~Gauge(); xyu::dealloc<Gauge>(xyu::native_v, e->gauge); }
+            if (e->histogram) { e->histogram->~Histogram(); xyu::dealloc<Histogram>(xyu::native_v, e->histogram); }
+            e->~Entry();
+            xyu::dealloc<Entry>(xyu::native_v, e);
+        }
+    }
+
+    MetricRegistry& MetricRegistry::global() noexcept
+    {
+        static MetricRegistry reg;
+        return reg;
+    }
+
+    Counter& MetricRegistry::counter(const xyu::StringView& name)
+    {
+        auto g = m.guard();
+        Entry* e = lookup(name);
+        if (!e) {
+            auto p = ::new (xyu::alloc<Counter>(xyu::native_v, 1)) Counter{};
+            try { e = &append(name, line_hint(name.size())); }
+            catch (...) { p->~Counter(); xyu::dealloc<Counter>(xyu::native_v, p); throw; }
+            e->counter = p;
+        }
+        else if (XY_UNLIKELY(!e->counter)) {
+            xyloge(0, "E_Logic_Invalid_Argument: metric '{}' is already registered with another kind", name);
+            throw xyu::E_Logic_Invalid_Argument{};
+        }
+        return *e->counter;
+    }
+
+    Gauge& MetricRegistry::gauge(const xyu::StringView& name)
+    {
+        auto g = m.guard();
+        Entry* e = lookup(name);
+        if (!e) {
+            auto p = ::new (xyu::alloc<Gauge>(xyu::native_v, 1)) Gauge{};
+            try { e = &append(name, line_hint(name.size())); }
+            catch (...) { p->~Gauge(); xyu::dealloc<Gauge>(xyu::native_v, p); throw; }
+            e->gauge = p;
+        }
+        else if (XY_UNLIKELY(!e->gauge)) {
+            xyloge(0, "E_Logic_Invalid_Argument: metric '{}' is already registered with another kind", name);
+            throw xyu::E_Logic_Invalid_Argument{};
+        }
+        return *e->gauge;
+    }
+
+    Histogram& MetricRegistry::histogram(const xyu::StringView& name, const xyu::int64* bounds, xyu::size_t count)
+    {
+        auto g = m.guard();
+        Entry* e = lookup(name);
+        if (!e) {
+            auto p = xyu::alloc<Histogram>(xyu::native_v, 1);
+            try { ::new (p) Histogram{bounds, count}; }
+            catch (...) { xyu::dealloc<Histogram>(xyu::native_v, p); throw; }
+            // 每个桶一行，另有 _sum 与 _count 两行
+            try { e = &append(name, line_hint(name.size() + 16) * (count + 3)); }
+            catch (...) { p->~Histogram(); xyu::dealloc<Histogram>(xyu::native_v, p); throw; }
+            e->histogram = p;
+        }
+        else if (XY_UNLIKELY(!e->histogram)) {
+            xyloge(0, "E_Logic_Invalid_Argument: metric '{}' is already registered with another kind", name);
+            throw xyu::E_Logic_Invalid_Argument{};
+        }
+        return *e->histogram;
+    }
+
+    MetricRegistry::Entry* MetricRegistry::lookup(const xyu::StringView& name) const noexcept
+    {
+        for (Entry* e = head; e; e = e->next)
+            if (e->name.equals(name)) return e;
+        return nullptr;
+    }
+
+    MetricRegistry::Entry& MetricRegistry::append(const xyu::StringView& name, xyu::size_t hint)
+    {
+        auto e = xyu::alloc<Entry>(xyu::native_v, 1);
+        try { ::new (e) Entry{name}; }
+        catch (...) { xyu::dealloc<Entry>(xyu::native_v, e); throw; }
+        *tail = e;
+        tail = &e->next;
+        est.fetch_add(hint, xyu::N_ATOMIC_RELAXED);
+        return *e;
+    }
+}
+
+#endif
@@ -6,13 +6,23 @@
 #include <windows.h>
 #else
 #include <pthread.h>
+#include <sched.h>
 #include <errno.h>
 #endif
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
+#endif
 
 #include "../../link/config"
 #if !XY_UNTHREAD
 
 #include "../../head/xyconc/mutex.h"
+#if XY_LOCK_PROFILE
+#include "../../head/xyconc/lockprof.h"
+#endif
 #include "../../link/log"
 
 namespace
@@ -114,6 +124,7 @@ namespace
         }
     }
 
+#if !XY_MUTEX_FUTEX
     [[noreturn]] void lock_error(xyu::uint line, const char* func, int err)
     {
         switch (err) {
@@ -134,6 +145,7 @@ namespace
                 unknown_error(line, func, err);
         }
     }
+#endif
 
     [[noreturn]] void unlock_error(xyu::uint line, const char* func, int err)
     {
@@ -188,8 +200,97 @@ namespace
 #endif
 }
 
+#if XY_LOCK_PROFILE
+namespace
+{
+    // 竞争上锁前调用，正在记录时返回开始等待的时间，否则返回 0
+    xyu::int64 profile_begin() noexcept
+    {
+        return xylu::xyconc::LockProfiler::enabled() ? xyu::Duration_any().count : 0;
+    }
+
+    // 竞争上锁后调用，记录等待时间，返回获得锁的时间 (未记录时返回 0)
+    xyu::int64 profile_end(const void* lock, bool rw, bool read, xyu::int64 t, const void* site) noexcept
+    {
+        if (!t) return 0;
+        xyu::int64 now = xyu::Duration_any().count;
+        xylu::xyconc::__::lock_profile_wait(lock, rw, read, now - t, site);
+        return now;
+    }
+
+    // 解锁前调用，记录竞争上锁后的持有时间
+    void profile_hold(const void* lock, xyu::int64& ht) noexcept
+    {
+        if (XY_LIKELY(!ht)) return;
+        xylu::xyconc::__::lock_profile_hold(lock, xyu::Duration_any().count - ht);
+        ht = 0;
+    }
+}
+#endif
+
+#if XY_MUTEX_FUTEX
+namespace
+{
+    // 上锁失败后，挂起前的最大自旋次数
+    constexpr int K_spin_count = 100;
+
+    static_assert(sizeof(xyu::Atomic<xyu::uint32>) == sizeof(xyu::uint32), "futex word must be 32 bits");
+}
+
+namespace xylu::xyconc
+{
+    void __::futex_wait(void* addr, xyu::uint32 val) noexcept
+    {
+        syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, nullptr, nullptr, 0);
+    }
+
+    bool __::futex_wait_to(void* addr, xyu::uint32 val, xyu::size_t s, xyu::size_t ns) noexcept
+    {
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(s);
+        ts.tv_nsec = static_cast<long>(ns);
+        // FUTEX_WAIT_BITSET 使用绝对超时时间，FUTEX_CLOCK_REALTIME 指定为系统时间
+        long r = syscall(SYS_futex, addr, FUTEX_WAIT_BITSET_PRIVATE | FUTEX_CLOCK_REALTIME, val, &ts, nullptr, FUTEX_BITSET_MATCH_ANY);
+        return !(r == -1 && errno == ETIMEDOUT);
+    }
+
+    void __::futex_wake(void* addr, int n) noexcept
+    {
+        syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0);
+    }
+
+    void __::futex_lock(xyu::Atomic<xyu::uint32>& h) noexcept
+    {
+        // 无竞争
+        if (XY_LIKELY(h.compare_exchange_strong(0, 1, xyu::N_ATOMIC_ACQUIRE))) return;
+        // 有限自旋 (临界区通常很短，避免进入内核)
+        for (int i = 0; i < K_spin_count; ++i)
+        {
+            xyu::cpu_pause();
+            xyu::uint32 c = h.load(xyu::N_ATOMIC_RELAXED);
+            if (c == 0 && h.compare_exchange_strong(0, 1, xyu::N_ATOMIC_ACQUIRE)) return;
+            // 已有等待线程，直接挂起
+            if (c == 2) break;
+        }
+        // 挂起 (状态设置为 2，使解锁者知道需要唤醒)
+        while (h.exchange(2, xyu::N_ATOMIC_ACQUIRE) != 0) futex_wait(&h, 2);
+    }
+
+    void __::futex_unlock(xyu::Atomic<xyu::uint32>& h) noexcept
+    {
+        if (XY_UNLIKELY(h.exchange(0, xyu::N_ATOMIC_RELEASE) == 2)) futex_wake(&h, 1);
+    }
+
+    bool __::futex_trylock(xyu::Atomic<xyu::uint32>& h) noexcept
+    {
+        return h.load(xyu::N_ATOMIC_RELAXED) == 0 && h.compare_exchange_strong(0, 1, xyu::N_ATOMIC_ACQUIRE);
+    }
+}
+#endif
+
 namespace xylu::xyconc
 {
+#if !XY_MUTEX_FUTEX
     Mutex::Mutex()
     {
 #ifdef XY_WINDOWS
@@ -214,15 +315,26 @@ namespace xylu::xyconc
         xylu::xymemory::__::under_dealloc(h);
 #endif
     }
+#endif
 
     void Mutex::Guard::lock()
     {
         if (XY_UNLIKELY(own)) return is_lock_error(__LINE__, __func__);
+#if XY_LOCK_PROFILE
+        // 无竞争时只尝试上锁一次，不读取开关
+        if (trylock()) return;
+        xyu::int64 t = profile_begin();
+#endif
 #ifdef XY_WINDOWS
         AcquireSRWLockExclusive(srw(m.h));
+#elif XY_MUTEX_FUTEX
+        __::futex_lock(m.h);
 #else
         if (int r = pthread_mutex_lock(mu(m.h)); XY_UNLIKELY(r))
             lock_error(__LINE__, __func__, r);
+#endif
+#if XY_LOCK_PROFILE
+        ht = profile_end(&m, false, false, t, __builtin_return_address(0));
 #endif
         own = true;
     }
@@ -232,6 +344,8 @@ namespace xylu::xyconc
         if (XY_UNLIKELY(own)) return is_lock_error(__LINE__, __func__), true;
 #ifdef XY_WINDOWS
         own = TryAcquireSRWLockExclusive(srw(m.h));
+#elif XY_MUTEX_FUTEX
+        own = __::futex_trylock(m.h);
 #else
         if (int r = pthread_mutex_trylock(mu(m.h))) {
             if (XY_LIKELY(r == EBUSY)) own = false;
@@ -245,8 +359,13 @@ namespace xylu::xyconc
     void Mutex::Guard::unlock()
     {
         if (XY_UNLIKELY(!own)) return is_unlock_error(__LINE__, __func__);
+#if XY_LOCK_PROFILE
+        profile_hold(&m, ht);
+#endif
 #ifdef XY_WINDOWS
         ReleaseSRWLockExclusive(srw(m.h));
+#elif XY_MUTEX_FUTEX
+        __::futex_unlock(m.h);
 #else
         if (int r = pthread_mutex_unlock(mu(m.h)); XY_UNLIKELY(r))
             unlock_error(__LINE__, __func__, r);
@@ -261,6 +380,8 @@ namespace xylu::xyconc
         {
 #ifdef XY_WINDOWS
         AcquireSRWLockExclusive(srw(m.h));
+#elif XY_MUTEX_FUTEX
+        __::futex_lock(m.h);
 #else
         if (int r = pthread_mutex_lock(mu(m.h)); XY_UNLIKELY(r))
             lock_error(__LINE__, __func__, r);
@@ -277,6 +398,8 @@ namespace xylu::xyconc
         {
 #ifdef XY_WINDOWS
             dp = TryAcquireSRWLockExclusive(srw(m.h));
+#elif XY_MUTEX_FUTEX
+            dp = __::futex_trylock(m.h);
 #else
             if (int r = pthread_mutex_trylock(mu(m.h))) {
                 if (XY_LIKELY(r == EBUSY)) dp = 0;
@@ -295,6 +418,8 @@ namespace xylu::xyconc
         {
 #ifdef XY_WINDOWS
             ReleaseSRWLockExclusive(srw(m.h));
+#elif XY_MUTEX_FUTEX
+            __::futex_unlock(m.h);
 #else
             if (int r = pthread_mutex_unlock(mu(m.h)); XY_UNLIKELY(r))
                 unlock_error(__LINE__, __func__, r);
@@ -309,6 +434,8 @@ namespace xylu::xyconc
                 xylogw2(xyu::N_LOG_WARN, "E_Mutex_Recursive_Unlock: unlocking a mutex with {} recursive locks", __LINE__, __func__, dp);
 #ifdef XY_WINDOWS
                 ReleaseSRWLockExclusive(srw(m.h));
+#elif XY_MUTEX_FUTEX
+                __::futex_unlock(m.h);
 #else
                 if (int r = pthread_mutex_unlock(mu(m.h)); XY_UNLIKELY(r))
                 unlock_error(__LINE__, __func__, r);
@@ -346,11 +473,18 @@ namespace xylu::xyconc
     void Mutex_RW::Guard_Read::lock()
     {
         if (XY_UNLIKELY(have)) return is_lock_error(__LINE__, __func__);
+#if XY_LOCK_PROFILE
+        if (trylock()) return;
+        xyu::int64 t = profile_begin();
+#endif
 #ifdef XY_WINDOWS
         AcquireSRWLockShared(srw(m.h));
 #else
         if (int r = pthread_rwlock_rdlock(mu(m.h)); XY_UNLIKELY(r))
             rlock_error(__LINE__, __func__, r);
+#endif
+#if XY_LOCK_PROFILE
+        ht = profile_end(&m, true, true, t, __builtin_return_address(0));
 #endif
         have = true;
     }
@@ -373,6 +507,9 @@ namespace xylu::xyconc
     void Mutex_RW::Guard_Read::unlock()
     {
         if (XY_UNLIKELY(!have)) return is_unlock_error(__LINE__, __func__);
+#if XY_LOCK_PROFILE
+        profile_hold(&m, ht);
+#endif
 #ifdef XY_WINDOWS
         ReleaseSRWLockShared(srw(m.h));
 #else
@@ -385,11 +522,18 @@ namespace xylu::xyconc
     void Mutex_RW::Guard_Write::lock()
     {
         if (XY_UNLIKELY(own)) return is_lock_error(__LINE__, __func__);
+#if XY_LOCK_PROFILE
+        if (trylock()) return;
+        xyu::int64 t = profile_begin();
+#endif
 #ifdef XY_WINDOWS
         AcquireSRWLockExclusive(srw(m.h));
 #else
         if (int r = pthread_rwlock_wrlock(mu(m.h)); XY_UNLIKELY(r))
             wlock_error(__LINE__, __func__, r);
+#endif
+#if XY_LOCK_PROFILE
+        ht = profile_end(&m, true, false, t, __builtin_return_address(0));
 #endif
         own = true;
     }
@@ -412,6 +556,9 @@ namespace xylu::xyconc
     void Mutex_RW::Guard_Write::unlock()
     {
         if (XY_UNLIKELY(!own)) return is_unlock_error(__LINE__, __func__);
+#if XY_LOCK_PROFILE
+        profile_hold(&m, ht);
+#endif
 #ifdef XY_WINDOWS
         ReleaseSRWLockExclusive(srw(m.h));
 #else
@@ -422,4 +569,109 @@ namespace xylu::xyconc
     }
 }
 
+namespace
+{
+    using xylu::xyconc::Mutex_RW_Biased;
+
+    // 写者等待读者退出时，让步前的自旋次数
+    constexpr int K_drain_spin = 128;
+
+    // 获取当前线程使用的读者槽位序号 (按线程创建顺序轮流分配)
+    xyu::size_t read_slot() noexcept
+    {
+        static xyu::Atomic<xyu::size_t> next{0};
+        thread_local xyu::size_t id = next.fetch_add(1, xyu::N_ATOMIC_RELAXED) % Mutex_RW_Biased::K_slot_count;
+        return id;
+    }
+
+    // 线程让步
+    void yield() noexcept
+    {
+#ifdef XY_WINDOWS
+        SwitchToThread();
+#else
+        sched_yield();
+#endif
+    }
+}
+
+namespace xylu::xyconc
+{
+    void Mutex_RW_Biased::Guard_Read::lock()
+    {
+        if (XY_UNLIKELY(sl)) return is_lock_error(__LINE__, __func__);
+        auto& n = m.rs[read_slot()].n;
+        // 快速路径: 只修改自身槽位 (与写者的 设置写标记 -> 扫描槽位 配对)
+        n.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        if (XY_UNLIKELY(m.wf.load(xyu::N_ATOMIC_SEQ_CST)))
+        {
+            // 写者活动中，撤回计数，通过写者锁等待写者结束
+            // (持有写者锁期间不会有写者，此时增加计数，之后的写者会等待本读者退出)
+            n.fetch_sub(1, xyu::N_ATOMIC_RELEASE);
+            auto g = m.wm.guard();
+            n.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        }
+        sl = &n;
+    }
+
+    bool Mutex_RW_Biased::Guard_Read::trylock()
+    {
+        if (XY_UNLIKELY(sl)) return is_lock_error(__LINE__, __func__), true;
+        auto& n = m.rs[read_slot()].n;
+        n.fetch_add(1, xyu::N_ATOMIC_SEQ_CST);
+        if (XY_UNLIKELY(m.wf.load(xyu::N_ATOMIC_SEQ_CST))) {
+            n.fetch_sub(1, xyu::N_ATOMIC_RELEASE);
+            return false;
+        }
+        sl = &n;
+        return true;
+    }
+
+    void Mutex_RW_Biased::Guard_Read::unlock()
+    {
+        if (XY_UNLIKELY(!sl)) return is_unlock_error(__LINE__, __func__);
+        sl->fetch_sub(1, xyu::N_ATOMIC_RELEASE);
+        sl = nullptr;
+    }
+
+    void Mutex_RW_Biased::Guard_Write::lock()
+    {
+        if (XY_UNLIKELY(g.is_locked())) return is_lock_error(__LINE__, __func__);
+        g.lock();
+        // 设置写标记，阻止新的读者进入
+        m.wf.store(1, xyu::N_ATOMIC_SEQ_CST);
+        // 保证写标记先于之后对槽位的读取 (与读者的 增加计数 -> 读取写标记 配对)
+        xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+        // 等待已有的读者退出
+        for (auto& s : m.rs)
+            for (int i = 0; s.n.load(xyu::N_ATOMIC_ACQUIRE) != 0; ++i) {
+                if (i < K_drain_spin) xyu::cpu_pause();
+                else yield();
+            }
+    }
+
+    bool Mutex_RW_Biased::Guard_Write::trylock()
+    {
+        if (XY_UNLIKELY(g.is_locked())) return is_lock_error(__LINE__, __func__), true;
+        if (!g.trylock()) return false;
+        m.wf.store(1, xyu::N_ATOMIC_SEQ_CST);
+        xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+        for (auto& s : m.rs)
+            if (s.n.load(xyu::N_ATOMIC_ACQUIRE) != 0) {
+                // 有读者，撤回写标记
+                m.wf.store(0, xyu::N_ATOMIC_RELEASE);
+                g.unlock();
+                return false;
+            }
+        return true;
+    }
+
+    void Mutex_RW_Biased::Guard_Write::unlock()
+    {
+        if (XY_UNLIKELY(!g.is_locked())) return is_unlock_error(__LINE__, __func__);
+        m.wf.store(0, xyu::N_ATOMIC_RELEASE);
+        g.unlock();
+    }
+}
+
 #endif // XY_UNTHREAD
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/parallel.h"
+
+namespace
+{
+    using xylu::xyconc::ThreadPool;
+    using xylu::xyconc::Parallel_Option;
+
+    // 每块覆盖的最少字节数 (连续访问足以摊销领取块与唤醒的开销，且不超过常见的 L2 容量)
+    constexpr xyu::size_t K_chunk_bytes = 16 * 1024;
+    // 每个参与线程平均分得的块数 (平衡各块执行时间的差异)
+    constexpr xyu::size_t K_chunks_per_worker = 4;
+
+    // 一次并行执行的共享状态 (调用线程与各辅助任务共同持有)
+    struct Job
+    {
+        xyu::Atomic<xyu::size_t> refs;          // 引用计数
+        xyu::Atomic<xyu::size_t> next{0};       // 下一个待领取的块
+        xyu::Atomic<xyu::uint32> done{0};       // 已完成 (或已跳过) 的块数
+        xyu::Atomic<bool> stop{false};          // 是否已有块失败
+        xyu::ErrorPtr ep;                       // 最先失败的块的异常
+        void (*body)(void*, xyu::size_t);       // 块的执行函数
+        void* ctx;                              // 执行参数 (位于调用线程的栈上，块全部完成后不再访问)
+        xyu::uint32 chunks;                     // 块数
+
+        Job(xyu::size_t refs, void (*body)(void*, xyu::size_t), void* ctx, xyu::uint32 chunks) noexcept
+            : refs{refs}, body{body}, ctx{ctx}, chunks{chunks} {}
+    };
+
+    void release(Job* j) noexcept
+    {
+        if (j->refs.fetch_sub(1, xyu::N_ATOMIC_ACQ_REL) == 1) {
+            j->~Job();
+            xyu::dealloc<Job>(xyu::native_v, j);
+        }
+    }
+
+    // 领取并执行块，直到没有剩余的块
+    void work(Job* j) noexcept
+    {
+        for (;;)
+        {
+            xyu::size_t c = j->next.fetch_add(1, xyu::N_ATOMIC_RELAXED);
+            if (c >= j->chunks) return;
+            if (!j->stop.load(xyu::N_ATOMIC_RELAXED)) {
+                try { j->body(j->ctx, c); }
+                catch (...) { if (!j->stop.exchange(true, xyu::N_ATOMIC_RELAXED)) j->ep = xyu::ErrorPtr::current(); }
+            }
+            // 完成最后一块的线程唤醒调用线程
+            if (j->done.fetch_add(1, xyu::N_ATOMIC_ACQ_REL) + 1 == j->chunks)
+                xylu::xyconc::__::wake_addr(&j->done, 1);
+        }
+    }
+
+    // 辅助任务 (开始较晚时块可能已被领取完，直接返回)
+    void helper(Job* j) noexcept
+    {
+        work(j);
+        release(j);
+    }
+
+    ThreadPool& pool_of(const Parallel_Option& op)
+    {
+        return op.pool ? *op.pool : xylu::xyconc::parallel_pool();
+    }
+
+    // 参与的线程数 (含调用线程)
+    xyu::size_t workers(const Parallel_Option& op)
+    {
+        if (op.threads == 1) return 1;
+        xyu::size_t w = pool_of(op).count() + 1;
+        return op.threads && op.threads < w ? op.threads : w;
+    }
+}
+
+namespace xylu::xyconc
+{
+    ThreadPool& parallel_pool()
+    {
+        static ThreadPool pool{ThreadPool::hardware_count() > 1 ? ThreadPool::hardware_count() - 1 : 1};
+        return pool;
+    }
+}
+
+namespace xylu::xyconc::__
+{
+    ParPlan par_plan(xyu::size_t n, xyu::size_t elem, const Parallel_Option& op)
+    {
+        if (n == 0) return {1, 0};
+        if (elem == 0) elem = 1;
+        xyu::size_t least = op.grain ? op.grain : (K_chunk_bytes + elem - 1) / elem;
+        // 数据量不足两块时不访问线程池
+        if (n < 2 * least) return {n, 1};
+        xyu::size_t w = workers(op);
+        if (w <= 1) return {n, 1};
+        xyu::size_t target = w * K_chunks_per_worker;
+        xyu::size_t chunk = (n + target - 1) / target;
+        if (chunk < least) chunk = least;
+        // 按缓存行取整，使块的边界 (对于连续存储) 尽量落在缓存行上
+        if (!op.grain) {
+            xyu::size_t line = elem < xyu::K_CACHE_LINE_SIZE ? xyu::K_CACHE_LINE_SIZE / elem : 1;
+            chunk = (chunk + line - 1) / line * line;
+        }
+        return {chunk, (n + chunk - 1) / chunk};
+    }
+
+    void par_run(xyu::size_t chunks, void (*body)(void*, xyu::size_t), void* ctx, const Parallel_Option& op)
+    {
+        if (chunks == 0) return;
+        xyu::size_t w = chunks > 1 ? workers(op) : 1;
+        if (w > chunks) w = chunks;
+        if (w <= 1) {
+            for (xyu::size_t c = 0; c < chunks; ++c) body(ctx, c);
+            return;
+        }
+
+        ThreadPool& pool = pool_of(op);
+        Job* j = ::new (xyu::alloc<Job>(xyu::native_v, 1)) Job{w, body, ctx, static_cast<xyu::uint32>(chunks)};
+        for (xyu::size_t k = 1; k < w; ++k)
+        {
+            try { pool.post(helper, j); }
+            catch (...) {
+                // 无法提交时由已提交的任务与调用线程完成
+                for (; k < w; ++k) release(j);
+                break;
+            }
+        }
+        work(j);
+
+        // 等待其他线程正在执行的块
+        for (xyu::uint32 d = j->done.load(xyu::N_ATOMIC_ACQUIRE); d != j->chunks; d = j->done.load(xyu::N_ATOMIC_ACQUIRE))
+            wait_addr(&j->done, d);
+        bool failed = j->stop.load(xyu::N_ATOMIC_RELAXED);
+        xyu::ErrorPtr e = xyu::move(j->ep);
+        release(j);
+        if (failed) e.rethrow();
+    }
+}
+
+#endif
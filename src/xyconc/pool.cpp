@@ -0,0 +1,311 @@
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/pool.h"
+#include "../../link/log"
+
+namespace
+{
+    // 工作线程查找任务失败后，挂起前的让步次数
+    constexpr int K_spin_count = 16;
+    // 从提交队列一次取出的最大任务数量
+    constexpr xyu::size_t K_inject_batch = 32;
+    // 双端队列的初始容量
+    constexpr xyu::diff_t K_ring_init = 256;
+}
+
+namespace xylu::xyconc::__
+{
+    // 双端队列的环形缓冲区
+    struct PoolRing
+    {
+        // 槽位 (窃取者可能读取到正在被覆盖的槽位，此时其 CAS 必然失败，因此使用原子变量避免数据竞争)
+        struct Slot
+        {
+            xyu::Atomic<void (*)(void*) noexcept> run;
+            xyu::Atomic<void*> arg;
+        };
+
+        xyu::diff_t mask;   // 容量 - 1
+        Slot* s;            // 槽位数组
+        PoolRing* prev;     // 扩容前的缓冲区 (窃取者可能仍在读取，延迟到队列析构时释放)
+
+        static PoolRing* make(xyu::diff_t capa, PoolRing* prev)
+        {
+            PoolRing* r = xyu::alloc<PoolRing>(xyu::native_v, 1);
+            try { r->s = xyu::alloc<Slot>(xyu::native_v, capa); }
+            catch (...) { xyu::dealloc<PoolRing>(xyu::native_v, r); throw; }
+            r->mask = capa - 1;
+            r->prev = prev;
+            return r;
+        }
+
+        void put(xyu::diff_t i, PoolTask t) noexcept
+        {
+            Slot& sl = s[i & mask];
+            sl.run.store(t.run, xyu::N_ATOMIC_RELAXED);
+            sl.arg.store(t.arg, xyu::N_ATOMIC_RELAXED);
+        }
+
+        PoolTask get(xyu::diff_t i) const noexcept
+        {
+            const Slot& sl = s[i & mask];
+            return { sl.run.load(xyu::N_ATOMIC_RELAXED), sl.arg.load(xyu::N_ATOMIC_RELAXED) };
+        }
+    };
+
+    /**
+     * Chase-Lev 工作窃取双端队列
+     * 所有者在底部 push/pop，窃取者在顶部 steal
+     */
+    struct PoolDeque : xyu::class_no_copy_move_t
+    {
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::diff_t> top{0};      // 顶部 (窃取者)
+        alignas(xyu::K_CACHE_LINE_SIZE) xyu::Atomic<xyu::diff_t> bottom{0};   // 底部 (所有者)
+        xyu::Atomic<PoolRing*> ring;                                                // 环形缓冲区
+
+        PoolDeque() : ring{PoolRing::make(K_ring_init, nullptr)} {}
+
+        ~PoolDeque() noexcept
+        {
+            for (PoolRing* r = ring.load(xyu::N_ATOMIC_RELAXED); r; ) {
+                PoolRing* p = r->prev;
+                xyu::dealloc<PoolRing::Slot>(xyu::native_v, r->s);
+                xyu::dealloc<PoolRing>(xyu::native_v, r);
+                r = p;
+            }
+        }
+
+        // 是否为空 (并发时仅为近似值)
+        bool empty() const noexcept
+        {
+            xyu::diff_t b = bottom.load(xyu::N_ATOMIC_ACQUIRE);
+            return b - top.load(xyu::N_ATOMIC_ACQUIRE) <= 0;
+        }
+
+        // 底部入队 (仅所有者)
+        void push(PoolTask t)
+        {
+            xyu::diff_t b = bottom.load(xyu::N_ATOMIC_RELAXED);
+            xyu::diff_t tp = top.load(xyu::N_ATOMIC_ACQUIRE);
+            PoolRing* r = ring.load(xyu::N_ATOMIC_RELAXED);
+            if (XY_UNLIKELY(b - tp > r->mask)) r = grow(r, tp, b, b - tp + 1);
+            r->put(b, t);
+            bottom.store(b + 1, xyu::N_ATOMIC_RELEASE);
+        }
+
+        // 预留可再入队 n 个任务的空间 (仅所有者，扩容失败时返回 false)
+        bool reserve(xyu::diff_t n) noexcept
+        {
+            xyu::diff_t b = bottom.load(xyu::N_ATOMIC_RELAXED);
+            xyu::diff_t tp = top.load(xyu::N_ATOMIC_ACQUIRE);
+            PoolRing* r = ring.load(xyu::N_ATOMIC_RELAXED);
+            if (XY_LIKELY(b - tp + n <= r->mask + 1)) return true;
+            try { grow(r, tp, b, b - tp + n); }
+            catch (...) { return false; }
+            return true;
+        }
+
+        // 在已预留的空间中底部入队 (仅所有者，窃取只会腾出空间，因此预留的空间一直有效)
+        void push_reserved(PoolTask t) noexcept
+        {
+            xyu::diff_t b = bottom.load(xyu::N_ATOMIC_RELAXED);
+            ring.load(xyu::N_ATOMIC_RELAXED)->put(b, t);
+            bottom.store(b + 1, xyu::N_ATOMIC_RELEASE);
+        }
+
+        // 扩容到至少可容纳 need 个任务，并复制 [tp, b) 中的任务 (仅所有者)
+        PoolRing* grow(PoolRing* r, xyu::diff_t tp, xyu::diff_t b, xyu::diff_t need)
+        {
+            xyu::diff_t capa = (r->mask + 1) * 2;
+            while (capa < need) capa *= 2;
+            PoolRing* nr = PoolRing::make(capa, r);
+            for (xyu::diff_t i = tp; i < b; ++i) nr->put(i, r->get(i));
+            ring.store(nr, xyu::N_ATOMIC_RELEASE);
+            return nr;
+        }
+
+        // 底部出队 (仅所有者)
+        bool pop(PoolTask& t) noexcept
+        {
+            xyu::diff_t b = bottom.load(xyu::N_ATOMIC_RELAXED) - 1;
+            PoolRing* r = ring.load(xyu::N_ATOMIC_RELAXED);
+            bottom.store(b, xyu::N_ATOMIC_RELAXED);
+            xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+            xyu::diff_t tp = top.load(xyu::N_ATOMIC_RELAXED);
+            if (tp > b) {
+                bottom.store(b + 1, xyu::N_ATOMIC_RELAXED);
+                return false;
+            }
+            t = r->get(b);
+            if (tp == b) {
+                // 最后一个元素，与窃取者竞争
+                bool ok = top.compare_exchange_strong(tp, tp + 1, xyu::N_ATOMIC_SEQ_CST);
+                bottom.store(b + 1, xyu::N_ATOMIC_RELAXED);
+                return ok;
+            }
+            return true;
+        }
+
+        // 顶部窃取 (任意线程)
+        bool steal(PoolTask& t) noexcept
+        {
+            xyu::diff_t tp = top.load(xyu::N_ATOMIC_ACQUIRE);
+            xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+            xyu::diff_t b = bottom.load(xyu::N_ATOMIC_ACQUIRE);
+            if (tp >= b) return false;
+            PoolRing* r = ring.load(xyu::N_ATOMIC_ACQUIRE);
+            t = r->get(tp);
+            return top.compare_exchange_strong(tp, tp + 1, xyu::N_ATOMIC_SEQ_CST);
+        }
+    };
+
+    // 工作线程
+    struct PoolWorker : xyu::class_no_copy_move_t
+    {
+        PoolDeque dq;               // 任务队列
+        ThreadPool* pool;           // 所属线程池
+        xyu::size_t id;             // 序号
+        xyu::uint64 seed;           // 随机数状态 (选择窃取目标)
+        xyu::Thread_Native th;      // 线程
+
+        PoolWorker(ThreadPool* pool, xyu::size_t id)
+            : pool{pool}, id{id}, seed{(id + 1) * 0x9E3779B97F4A7C15ull} {}
+
+        // 获取随机数 (xorshift64)
+        xyu::uint64 rand() noexcept
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            return seed;
+        }
+    };
+}
+
+namespace
+{
+    // 当前线程所属的工作线程 (非工作线程为 nullptr)
+    thread_local xylu::xyconc::__::PoolWorker* tl_worker = nullptr;
+}
+
+namespace xylu::xyconc
+{
+    ThreadPool::ThreadPool(xyu::size_t threads, xyu::size_t queue_capa)
+        : ws{nullptr}, wn{threads ? threads : hardware_count()}, inject{queue_capa}
+    {
+        ws = xyu::alloc<__::PoolWorker>(xyu::native_v, wn, xyu::max(alignof(__::PoolWorker), xyu::K_CACHE_LINE_SIZE));
+        // 构造工作线程
+        xyu::size_t i = 0;
+        try { for (; i < wn; ++i) ::new (ws + i) __::PoolWorker{this, i}; }
+        catch (...) {
+            while (i) ws[--i].~PoolWorker();
+            xyu::dealloc<__::PoolWorker>(xyu::native_v, ws);
+            throw;
+        }
+        // 启动工作线程 (所有工作线程构造完成后，才能相互窃取)
+        xyu::size_t k = 0;
+        try { for (; k < wn; ++k) ws[k].th.create(worker_main, ws + k); }
+        catch (...) {
+            shutdown();
+            throw;
+        }
+    }
+
+    ThreadPool::~ThreadPool() noexcept
+    {
+        shutdown();
+    }
+
+    void ThreadPool::shutdown() noexcept
+    {
+        stop.store(true, xyu::N_ATOMIC_RELEASE);
+        try {
+            auto g = m.guard();
+            cv.notify_all();
+        } catch (...) {}
+        // 先等待所有线程结束，再析构 (其他线程可能仍在窃取)
+        for (xyu::size_t i = 0; i < wn; ++i)
+            if (ws[i].th.status() == __::ThreadStatus::Running) try { ws[i].th.join(); } catch (...) {}
+        for (xyu::size_t i = 0; i < wn; ++i) ws[i].~PoolWorker();
+        xyu::dealloc<__::PoolWorker>(xyu::native_v, ws);
+    }
+
+    void ThreadPool::post_error() noexcept
+    {
+        try { xylogw(xyu::K_LOG_LEVEL, "ThreadPool: exception thrown by posted task is ignored"); } catch (...) {}
+    }
+
+    void ThreadPool::enqueue(__::PoolTask task)
+    {
+        if (__::PoolWorker* w = tl_worker; w && w->pool == this) w->dq.push(task);
+        else if (!inject.try_push(task)) inject.push(task);
+        // 与挂起前的屏障配对：要么工作线程看到新任务，要么本线程看到工作线程挂起
+        xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+        if (XY_UNLIKELY(sleepers.load(xyu::N_ATOMIC_RELAXED) != 0)) {
+            auto g = m.guard();
+            cv.notify_one();
+        }
+    }
+
+    bool ThreadPool::find(__::PoolWorker& w, __::PoolTask& task) noexcept
+    {
+        // 自身队列
+        if (w.dq.pop(task)) return true;
+        // 提交队列 (取出一个直接执行，再批量转移到自身队列供其他线程窃取)
+        if (inject.try_pop(task)) {
+            // 先预留空间，使转移过程不会抛出异常 (否则已取出的任务会被丢弃)；无法扩容时不转移
+            if (w.dq.reserve(K_inject_batch - 1))
+                inject.try_pop_n([&](__::PoolTask&& t) noexcept { w.dq.push_reserved(t); }, K_inject_batch - 1);
+            return true;
+        }
+        // 从随机位置开始窃取
+        if (wn > 1) {
+            xyu::size_t st = static_cast<xyu::size_t>(w.rand() % wn);
+            for (xyu::size_t i = 0; i < wn; ++i) {
+                xyu::size_t v = st + i < wn ? st + i : st + i - wn;
+                if (v != w.id && ws[v].dq.steal(task)) return true;
+            }
+        }
+        return false;
+    }
+
+    bool ThreadPool::has_task() const noexcept
+    {
+        if (!inject.empty()) return true;
+        for (xyu::size_t i = 0; i < wn; ++i) if (!ws[i].dq.empty()) return true;
+        return false;
+    }
+
+    void ThreadPool::worker_main(void* arg)
+    {
+        auto& w = *static_cast<__::PoolWorker*>(arg);
+        ThreadPool& p = *w.pool;
+        tl_worker = &w;
+        __::PoolTask task;
+        for (;;)
+        {
+            // 查找任务
+            bool got = p.find(w, task);
+            for (int i = 0; !got && i < K_spin_count; ++i) {
+                Thread_Native::yield();
+                got = p.find(w, task);
+            }
+            if (got) { task.run(task.arg); continue; }
+            // 结束
+            if (p.stop.load(xyu::N_ATOMIC_ACQUIRE)) {
+                if (!p.has_task()) break;
+                continue;
+            }
+            // 挂起
+            auto g = p.m.guard();
+            p.sleepers.fetch_add(1, xyu::N_ATOMIC_RELAXED);
+            xyu::atomic_fence(xyu::N_ATOMIC_SEQ_CST);
+            while (!p.has_task() && !p.stop.load(xyu::N_ATOMIC_ACQUIRE)) p.cv.wait(g);
+            p.sleepers.fetch_sub(1, xyu::N_ATOMIC_RELAXED);
+        }
+        tl_worker = nullptr;
+    }
+}
+
+#endif
@@ -0,0 +1,84 @@
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/sync.h"
+
+namespace
+{
+    // 挂起前的自旋次数
+    constexpr int K_spin_count = 64;
+
+    /**
+     * 等待 a 的值满足 ready (自旋后挂起)
+     * utc 为空时不超时，否则直到超时 (UTC 时间点)，返回值是否满足 ready
+     */
+    template <typename Ready>
+    bool wait_until(const xyu::Atomic<xyu::uint32>& a, Ready ready, const xyu::Duration_ns* utc) noexcept
+    {
+        for (int i = 0; ; ++i)
+        {
+            xyu::uint32 v = a.load(xyu::N_ATOMIC_ACQUIRE);
+            if (ready(v)) return true;
+            if (i < K_spin_count) { xyu::cpu_pause(); continue; }
+            if (!utc) xylu::xyconc::__::wait_addr(&a, v);
+            else if (utc->count <= 0 || !xylu::xyconc::__::wait_addr_to(&a, v,
+                        static_cast<xyu::size_t>(utc->count / 1000000000), static_cast<xyu::size_t>(utc->count % 1000000000)))
+                return ready(a.load(xyu::N_ATOMIC_ACQUIRE));
+        }
+    }
+}
+
+namespace xylu::xyconc
+{
+    /* Semaphore */
+
+    void Semaphore::acquire_help() noexcept
+    {
+        while (!try_acquire()) wait_until(c, [](xyu::uint32 v) { return v != 0; }, nullptr);
+    }
+
+    bool Semaphore::acquire_to_help(xyu::Duration_ns utc) noexcept
+    {
+        while (!try_acquire())
+            if (!wait_until(c, [](xyu::uint32 v) { return v != 0; }, &utc)) return false;
+        return true;
+    }
+
+    /* Latch */
+
+    void Latch::wait_help() const noexcept
+    {
+        wait_until(c, [](xyu::uint32 v) { return v == 0; }, nullptr);
+    }
+
+    bool Latch::wait_to_help(xyu::Duration_ns utc) const noexcept
+    {
+        return wait_until(c, [](xyu::uint32 v) { return v == 0; }, &utc);
+    }
+
+    /* Barrier */
+
+    void Barrier::wait_help(Token token) const noexcept
+    {
+        wait_until(w, [token](xyu::uint32 v) { return (v >> 16) != token; }, nullptr);
+    }
+
+    bool Barrier::wait_to_help(Token token, xyu::Duration_ns utc) const noexcept
+    {
+        return wait_until(w, [token](xyu::uint32 v) { return (v >> 16) != token; }, &utc);
+    }
+
+    /* Event */
+
+    void Event::wait_help() const noexcept
+    {
+        wait_until(s, [](xyu::uint32 v) { return v != 0; }, nullptr);
+    }
+
+    bool Event::wait_to_help(xyu::Duration_ns utc) const noexcept
+    {
+        return wait_until(s, [](xyu::uint32 v) { return v != 0; }, &utc);
+    }
+}
+
+#endif
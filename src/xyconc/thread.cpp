@@ -6,12 +6,14 @@
 #include <process.h>
 #else
 #include <pthread.h>
+#include <unistd.h>
 #endif
 
 #include "../../link/config"
 #if !XY_UNTHREAD
 
 #include "../../head/xyconc/thread.h"
+#include "../../link/condvar"
 #include "../../link/log"
 
 // CYGWIN 下不支持直接用 pthread_t 或 HANDLE，都会导致运行崩溃
@@ -27,23 +29,52 @@ namespace
     pthread_t th(void* handle) noexcept { return reinterpret_cast<pthread_t>(handle); }
 #endif
 
+#if !defined(__CYGWIN__)
+    // 线程启动参数
+    struct Start
+    {
+        void* fun;          // 线程函数
+        void* arg;          // 线程参数
+        char name[16];      // 线程名称 (空字符串为不设置)
+    };
+
+    // 分配线程启动参数
+    Start* make_start(void* fun, void* arg, const char* name)
+    {
+        auto st = static_cast<Start*>(xylu::xymemory::__::under_alloc(sizeof(Start)));
+        st->fun = fun;
+        st->arg = arg;
+        xyu::size_t i = 0;
+        if (name) for (; i < sizeof(st->name) - 1 && name[i]; ++i) st->name[i] = name[i];
+        st->name[i] = '\0';
+        return st;
+    }
+#endif
+
 #if defined(__CYGWIN__)
 #elif defined(_WIN32)
     xyu::uint __stdcall fp(void* tmp) noexcept
     {
-        void** p = reinterpret_cast<void**>(tmp);
-        try { reinterpret_cast<void*(*)(void*)>(p[0])(p[1]); }
-        catch (...) {}
+        auto st = static_cast<Start*>(tmp);
+        auto fun = reinterpret_cast<void*(*)(void*)>(st->fun);
+        void* arg = st->arg;
         xylu::xymemory::__::under_dealloc(tmp);
+        try { fun(arg); }
+        catch (...) {}
         return 0;
     }
 #else
     void* fp(void* tmp) noexcept
     {
-        void** p = reinterpret_cast<void**>(tmp);
-        try { reinterpret_cast<void*(*)(void*)>(p[0])(p[1]); }
-        catch (...) {}
+        auto st = static_cast<Start*>(tmp);
+#if defined(__linux__)
+        if (st->name[0]) pthread_setname_np(pthread_self(), st->name);
+#endif
+        auto fun = reinterpret_cast<void*(*)(void*)>(st->fun);
+        void* arg = st->arg;
         xylu::xymemory::__::under_dealloc(tmp);
+        try { fun(arg); }
+        catch (...) {}
         return nullptr;
     }
 #endif
@@ -52,10 +83,12 @@ namespace
 namespace
 {
     using xylu::xyconc::__::ThreadStatus;
+    using xylu::xyconc::__::ThreadStatus_Base;
     constexpr auto sstatus = [](ThreadStatus::Status s) noexcept -> xyu::StringView {
         switch (s) {
             case ThreadStatus::Uninit: return "uninit";
-            case ThreadStatus::Running: return "running";
+            case ThreadStatus::Running:
+            case ThreadStatus_Base::Waited: return "running";
             case ThreadStatus::Joined: return "joined";
             case ThreadStatus::Detached: return "detached";
             case ThreadStatus::Finished: return "finished";
@@ -88,6 +121,98 @@ namespace
         }
     }
 
+    [[noreturn]] void cpu_error(xyu::uint line, const char* func, xyu::size_t cpu)
+    {
+        xyloge2(0, "E_Logic_Out_Of_Range: cpu {} out of range [0, {})", line, func, cpu, xyu::CpuSet::K_max_count);
+        throw xyu::E_Logic_Out_Of_Range{};
+    }
+
+#if defined(__linux__) && !defined(__CYGWIN__)
+    // 转换为系统 CPU 集合
+    void to_cpuset(const xyu::CpuSet& cpus, cpu_set_t& set) noexcept
+    {
+        CPU_ZERO(&set);
+        for (xyu::size_t i = 0; i < xyu::CpuSet::K_max_count && i < CPU_SETSIZE; ++i)
+            if (cpus.test(i)) CPU_SET(i, &set);
+    }
+#endif
+
+#if defined(__CYGWIN__)
+#elif defined(_WIN32)
+    // 创建线程 (应用线程属性)，返回线程句柄
+    HANDLE spawn(xyu::uint __stdcall (*fun)(void*), void* arg, const xyu::Thread_Native::Option& op,
+                 xyu::uint line, const char* func)
+    {
+        using Option = xyu::Thread_Native::Option;
+        unsigned stack = op.stack_size == Option::K_default ? 0 : static_cast<unsigned>(op.stack_size);
+        bool pin = !op.affinity.empty();
+        auto handle = _beginthreadex(nullptr, stack, fun, arg, pin ? CREATE_SUSPENDED : 0, nullptr);
+        if (XY_UNLIKELY(!handle)) create_error(line, func, errno);
+        HANDLE h = reinterpret_cast<HANDLE>(handle);
+        if (pin) {
+            // 线程已创建，亲和性设置失败时仅记录警告
+            if (XY_UNLIKELY(!SetThreadAffinityMask(h, static_cast<DWORD_PTR>(op.affinity.data()[0]))))
+                xylogw2(xyu::K_LOG_LEVEL, "cannot set thread affinity with code {}", line, func, GetLastError());
+            ResumeThread(h);
+        }
+        return h;
+    }
+#else
+    // 线程创建属性
+    class Attr : xyu::class_no_copy_move_t
+    {
+    private:
+        pthread_attr_t a;   // pthread 属性
+        bool used = false;  // 是否使用了非默认属性
+
+    public:
+        Attr(const xyu::Thread_Native::Option& op, xyu::uint line, const char* func)
+        {
+            using Option = xyu::Thread_Native::Option;
+            bool stack = op.stack_size != Option::K_default, guard = op.guard_size != Option::K_default;
+#if defined(__linux__)
+            bool pin = !op.affinity.empty();
+#else
+            bool pin = false;
+#endif
+            if (!stack && !guard && !pin) return;
+            if (int r = pthread_attr_init(&a); XY_UNLIKELY(r)) create_error(line, func, r);
+            used = true;
+            int r = 0;
+            if (stack) r = pthread_attr_setstacksize(&a, op.stack_size);
+            if (!r && guard) r = pthread_attr_setguardsize(&a, op.guard_size);
+#if defined(__linux__)
+            if (!r && pin) {
+                cpu_set_t set;
+                to_cpuset(op.affinity, set);
+                r = pthread_attr_setaffinity_np(&a, sizeof(set), &set);
+            }
+#endif
+            if (XY_UNLIKELY(r)) {
+                pthread_attr_destroy(&a);
+                create_error(line, func, r);
+            }
+        }
+
+        ~Attr() noexcept { if (used) pthread_attr_destroy(&a); }
+
+        const pthread_attr_t* get() const noexcept { return used ? &a : nullptr; }
+    };
+
+    // 创建线程 (应用线程属性)，返回线程句柄
+    pthread_t spawn(void* fun, void* arg, const xyu::Thread_Native::Option& op, xyu::uint line, const char* func)
+    {
+        Attr at{op, line, func};
+        Start* st = make_start(fun, arg, op.name);
+        pthread_t handle;
+        if (int r = pthread_create(&handle, at.get(), fp, st); XY_UNLIKELY(r)) {
+            xylu::xymemory::__::under_dealloc(st);
+            create_error(line, func, r);
+        }
+        return handle;
+    }
+#endif
+
 #if defined(_WIN32)
     [[noreturn]] void join_error(xyu::uint line, const char* func, DWORD err)
     {
@@ -157,12 +282,26 @@ namespace
 
 namespace xylu::xyconc
 {
+    CpuSet& CpuSet::set(xyu::size_t cpu)
+    {
+        if (XY_UNLIKELY(cpu >= K_max_count)) cpu_error(__LINE__, __func__, cpu);
+        bits[cpu / 64] |= xyu::uint64{1} << (cpu % 64);
+        return *this;
+    }
+
+    CpuSet& CpuSet::reset(xyu::size_t cpu)
+    {
+        if (XY_UNLIKELY(cpu >= K_max_count)) cpu_error(__LINE__, __func__, cpu);
+        bits[cpu / 64] &= ~(xyu::uint64{1} << (cpu % 64));
+        return *this;
+    }
+
     Thread_Native::~Thread_Native() noexcept
     {
         if (s == Running) try { join(); s = Uninit; } catch (...) {}
     }
 
-    void Thread_Native::create(Fun_t fun, void* arg)
+    void Thread_Native::create(const Option& op, Fun_t fun, void* arg)
     {
         if (XY_UNLIKELY(s == Running || s == Joined)) {
             xyloge(0, "E_Thread_Invalid_State: thread is {}, cannot create new thread", sstatus(s));
@@ -184,18 +323,13 @@ namespace xylu::xyconc
             create_error(__LINE__, __func__, e.code().value());
         }
         h = *reinterpret_cast<void**>(buf);
+        (void)op;
+#elif defined(_WIN32)
+        Start* st = make_start(reinterpret_cast<void*>(fun), arg, nullptr);
+        try { h = spawn(fp, st, op, __LINE__, __func__); }
+        catch (...) { xylu::xymemory::__::under_dealloc(st); throw; }
 #else
-        void** data = (void**)xylu::xymemory::__::under_alloc(2 * sizeof(void*));
-        data[0] = reinterpret_cast<void*>(fun);
-        data[1] = arg;
-#if defined(_WIN32)
-        auto handle = _beginthreadex(nullptr, 0, fp, data, 0, nullptr);
-        if (XY_UNLIKELY(!handle)) create_error(__LINE__, __func__, errno);
-        h = reinterpret_cast<void*>(handle);
-#else
-        if (int r = pthread_create(reinterpret_cast<pthread_t*>(&h), nullptr, fp, data); XY_UNLIKELY(r))
-            create_error(__LINE__, __func__, r);
-#endif
+        h = reinterpret_cast<void*>(spawn(reinterpret_cast<void*>(fun), arg, op, __LINE__, __func__));
 #endif
         s = Running;
     }
@@ -266,10 +400,128 @@ namespace xylu::xyconc
         sched_yield();
 #endif
     }
+
+    void Thread_Native::set_affinity(const CpuSet& cpus)
+    {
+#if defined(__linux__) && !defined(__CYGWIN__)
+        cpu_set_t set;
+        to_cpuset(cpus, set);
+        if (int r = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); XY_UNLIKELY(r)) {
+            if (r == EINVAL) {
+                xyloge(0, "E_Logic_Invalid_Argument: no available cpu in affinity set");
+                throw xyu::make_error(xyu::E_Thread{}, xyu::E_Logic_Invalid_Argument{});
+            }
+            unknown_error(__LINE__, __func__, r);
+        }
+#elif defined(_WIN32) && !defined(__CYGWIN__)
+        if (XY_UNLIKELY(!SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(cpus.data()[0])))) {
+            DWORD err = GetLastError();
+            if (err == ERROR_INVALID_PARAMETER) {
+                xyloge(0, "E_Logic_Invalid_Argument: no available cpu in affinity set");
+                throw xyu::make_error(xyu::E_Thread{}, xyu::E_Logic_Invalid_Argument{});
+            }
+            unknown_error(__LINE__, __func__, err);
+        }
+#else
+        (void)cpus;
+        xyloge(0, "E_Thread: thread affinity is not supported on this platform");
+        throw xyu::E_Thread{};
+#endif
+    }
+
+    int Thread_Native::current_cpu() noexcept
+    {
+#if defined(__linux__) && !defined(__CYGWIN__)
+        return sched_getcpu();
+#elif defined(_WIN32) && !defined(__CYGWIN__)
+        return static_cast<int>(GetCurrentProcessorNumber());
+#else
+        return -1;
+#endif
+    }
+
+    xyu::size_t Thread_Native::hardware_count() noexcept
+    {
+#if defined(_WIN32) && !defined(__CYGWIN__)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        long n = static_cast<long>(info.dwNumberOfProcessors);
+#else
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        return n > 0 ? static_cast<xyu::size_t>(n) : 1;
+    }
+}
+
+namespace
+{
+    // 等待任务结束的挂起位置 (按状态块地址散列，状态块中无需存储锁)
+    struct alignas(xyu::K_CACHE_LINE_SIZE) ThreadPark
+    {
+        xyu::Mutex m;       // 锁
+        xyu::CondVar cv;    // 任务结束通知
+    };
+
+    // 挂起位置数量
+    constexpr xyu::size_t K_park_count = 64;
+
+    // 获取状态块对应的挂起位置
+    ThreadPark& park(void* status)
+    {
+        static ThreadPark parks[K_park_count];
+        return parks[(reinterpret_cast<xyu::size_t>(status) >> 4) % K_park_count];
+    }
+
+    // 等待条件: 任务已结束；未结束时标记有等待者 (需持有挂起位置的锁)
+    bool wait_done(ThreadStatus_Base& st) noexcept
+    {
+        if (st.s.load(xyu::N_ATOMIC_ACQUIRE) == ThreadStatus::Running &&
+            st.s.compare_exchange_strong(ThreadStatus::Running, ThreadStatus_Base::Waited, xyu::N_ATOMIC_ACQ_REL))
+            return false;
+        return st.s.load(xyu::N_ATOMIC_ACQUIRE) <= ThreadStatus::Finished;
+    }
 }
 
 namespace xylu::xyconc
 {
+    void Thread::wait_help() noexcept
+    {
+        auto& st = *reinterpret_cast<__::ThreadStatus_Base*>(sp);
+        try {
+            auto& p = park(sp);
+            auto g = p.m.guard();
+            p.cv.wait(g, [&st]{ return wait_done(st); });
+        } catch (...) {
+            // 无法挂起时退化为让步轮询
+            while (!done()) Thread_Native::yield();
+        }
+    }
+
+    bool Thread::wait_for_help(xyu::Duration_ns timeout)
+    {
+        auto& st = *reinterpret_cast<__::ThreadStatus_Base*>(sp);
+        auto& p = park(sp);
+        auto g = p.m.guard();
+        return p.cv.wait_for(g, [&st]{ return wait_done(st); }, timeout);
+    }
+
+    bool Thread::wait_to_help(const xyu::Calendar& timepoint)
+    {
+        auto& st = *reinterpret_cast<__::ThreadStatus_Base*>(sp);
+        auto& p = park(sp);
+        auto g = p.m.guard();
+        return p.cv.wait_to(g, [&st]{ return wait_done(st); }, timepoint);
+    }
+
+    void Thread::notify_help(void* status) noexcept
+    {
+        try {
+            auto& p = park(status);
+            auto g = p.m.guard();
+            p.cv.notify_all();
+        } catch (...) {}
+    }
+
     void Thread::check_status()
     {
         if (sp)
@@ -287,9 +539,10 @@ namespace xylu::xyconc
     }
 
 #if (defined(__CYGWIN__) || defined(_WIN32))
-    void Thread::create_help(xyu::uint __stdcall (*fun)(void*), void* arg)
+    void Thread::create_help(const Option& op, xyu::uint __stdcall (*fun)(void*), void* arg)
     {
 #if defined(__CYGWIN__)
+        (void)op;
         try {
             std::thread th(fun, arg);
             th.detach();
@@ -300,24 +553,28 @@ namespace xylu::xyconc
             create_error(__LINE__, __func__, e.code().value());
         }
 #else
-        auto handle = _beginthreadex(nullptr, 0, fun, arg, 0, nullptr);
-        if (XY_UNLIKELY(!handle)) create_error(__LINE__, __func__, errno);
-        if (XY_UNLIKELY(!CloseHandle(reinterpret_cast<HANDLE>(handle))))
+        HANDLE handle = spawn(fun, arg, op, __LINE__, __func__);
+        if (XY_UNLIKELY(!CloseHandle(handle)))
             detach_error(__LINE__, __func__, GetLastError());
 #endif
     }
 #else
-    void Thread::create_help(void* (*fun)(void*), void* arg)
+    void Thread::create_help(const Option& op, void* (*fun)(void*), void* arg)
     {
         pthread_t handle;
-        if (int r = pthread_create(&handle, nullptr, fun, arg); XY_UNLIKELY(r))
-            create_error(__LINE__, __func__, r);
+        // 需要设置名称时经由启动函数转发，否则直接执行
+        if (op.name) handle = spawn(reinterpret_cast<void*>(fun), arg, op, __LINE__, __func__);
+        else {
+            Attr at{op, __LINE__, __func__};
+            if (int r = pthread_create(&handle, at.get(), fun, arg); XY_UNLIKELY(r))
+                create_error(__LINE__, __func__, r);
+        }
         if (int r = pthread_detach(handle); XY_UNLIKELY(r))
             detach_error(__LINE__, __func__, r);
     }
 #endif
 
-    void Thread::get_help(xyu::Duration_ms du)
+    void Thread::get_help()
     {
         // 线程未创建
         if (XY_UNLIKELY(!sp)) {
@@ -325,7 +582,7 @@ namespace xylu::xyconc
             throw xyu::E_Thread_Invalid_State{};
         }
         // 等待线程结束
-        wait(du);
+        wait();
         auto& status = *reinterpret_cast<__::ThreadStatus_Total<void>*>(sp);
         Status s = status.s.load(xyu::N_ATOMIC_ACQUIRE);
         // 异常抛出
@@ -0,0 +1,320 @@
+#include "../../link/config"
+#if !XY_UNTHREAD
+
+#include "../../head/xyconc/timer.h"
+#include "../../link/log"
+
+namespace
+{
+    using xylu::xyconc::TimerWheel;
+
+    // 每次分配的节点数量
+    constexpr xyu::size_t K_chunk = 256;
+    // 槽位下标掩码
+    constexpr xyu::uint64 K_mask = TimerWheel::K_slots - 1;
+    // 时间轮覆盖的刻度范围
+    constexpr xyu::uint64 K_range = xyu::uint64{1} << (TimerWheel::K_bits * TimerWheel::K_levels);
+    // 无效刻度
+    constexpr xyu::uint64 K_never = ~xyu::uint64{0};
+
+    static_assert(TimerWheel::K_slots == 64, "slot bitmap is a single uint64");
+    static_assert(TimerWheel::K_bits * TimerWheel::K_levels < 64);
+}
+
+namespace xylu::xyconc::__
+{
+    // 定时器节点 (在时间轮中时位于槽位链表；到期后 next 用于到期链表，空闲时用于空闲链表)
+    struct WheelNode : WheelLink
+    {
+        xyu::uint64 expire = 0;     // 到期刻度
+        xyu::uint64 gen = 0;        // 代数 (到期或取消时递增，使旧句柄失效)
+        xyu::uint pos = 0;          // 所在槽位 (层 * K_slots + 槽位)
+        TimerWheel::Callback cb;    // 回调
+    };
+
+    // 节点块 (析构时间轮时统一释放)
+    struct WheelChunk
+    {
+        WheelChunk* next;           // 下一个节点块
+        WheelNode nodes[K_chunk];   // 节点
+    };
+}
+
+namespace
+{
+    using xylu::xyconc::__::WheelLink;
+    using xylu::xyconc::__::WheelNode;
+    using xylu::xyconc::__::WheelChunk;
+
+    WheelNode* node(WheelLink* p) noexcept { return static_cast<WheelNode*>(p); }
+
+    // 从槽位链表中移除
+    void unlink(WheelLink* p) noexcept
+    {
+        p->prev->next = p->next;
+        p->next->prev = p->prev;
+    }
+
+    // 循环右移
+    xyu::uint64 rotr(xyu::uint64 v, xyu::uint s) noexcept
+    { return s ? (v >> s | v << (64 - s)) : v; }
+}
+
+namespace xylu::xyconc
+{
+    void TimerWheel::init(xyu::int64 tick_ns)
+    {
+        if (XY_UNLIKELY(tick_ns < 1000)) {
+            xyloge(0, "E_Logic_Invalid_Argument: tick {}ns of timer wheel is less than 1us", tick_ns);
+            throw xyu::E_Logic_Invalid_Argument{};
+        }
+        tick = tick_ns;
+        base = xyu::Duration_any().count;
+        for (auto& s : slots) s.prev = s.next = &s;
+    }
+
+    TimerWheel::~TimerWheel() noexcept
+    {
+        stop();
+        while (chunks) {
+            WheelChunk* c = chunks;
+            chunks = c->next;
+            c->~WheelChunk();
+            xyu::dealloc<WheelChunk>(xyu::native_v, c);
+        }
+    }
+
+    TimerWheel::Handle TimerWheel::schedule_help(xyu::int64 delay_ns, Callback& cb)
+    {
+        // 向上取整到刻度 (不提前执行)
+        xyu::int64 now = xyu::Duration_any().count - base;
+        xyu::uint64 e = 0;
+        if (delay_ns > 0) {
+            if (XY_UNLIKELY(delay_ns > (0x7FFFFFFFFFFFFFFF - now) - tick)) e = K_never >> 1;
+            else e = static_cast<xyu::uint64>((now + delay_ns + tick - 1) / tick);
+        }
+        auto g = m.guard();
+        if (e <= cur) e = cur + 1;
+        if (XY_UNLIKELY(!frees))
+        {
+            auto c = ::new (xyu::alloc<WheelChunk>(xyu::native_v, 1)) WheelChunk{};
+            c->next = chunks;
+            chunks = c;
+            for (xyu::size_t i = K_chunk; i-- > 0; ) {
+                c->nodes[i].next = frees;
+                frees = c->nodes + i;
+            }
+        }
+        WheelNode* p = frees;
+        frees = node(p->next);
+        p->expire = e;
+        p->cb.swap(cb);
+        insert(p);
+        ++n;
+        // 后台线程睡眠到更晚的刻度时唤醒
+        if (running && e < wait_tick) cv.notify_one();
+        return {p, p->gen};
+    }
+
+    bool TimerWheel::cancel(const Handle& h)
+    {
+        // 回调在解锁后析构
+        Callback cb;
+        auto g = m.guard();
+        WheelNode* p = h.n;
+        if (!p || p->gen != h.gen) return false;
+        unlink(p);
+        WheelLink& s = slots[p->pos];
+        if (s.next == &s) bits[p->pos / K_slots] &= ~(xyu::uint64{1} << (p->pos & K_mask));
+        ++p->gen;
+        --n;
+        cb.swap(p->cb);
+        p->next = frees;
+        frees = p;
+        return true;
+    }
+
+    xyu::size_t TimerWheel::count()
+    {
+        auto g = m.guard();
+        return n;
+    }
+
+    xyu::size_t TimerWheel::advance()
+    {
+        WheelNode* list;
+        {
+            auto g = m.guard();
+            list = expire(now_tick());
+        }
+        return run(list);
+    }
+
+    xyu::Duration_ns TimerWheel::next_timeout()
+    {
+        auto g = m.guard();
+        xyu::uint64 t = next_tick();
+        if (t == K_never) return -1;
+        xyu::int64 now = xyu::Duration_any().count - base;
+        if (XY_UNLIKELY(t >= static_cast<xyu::uint64>(0x7FFFFFFFFFFFFFFF / tick))) return 0x7FFFFFFFFFFFFFFF - now;
+        xyu::int64 dt = static_cast<xyu::int64>(t) * tick - now;
+        return dt > 0 ? dt : 0;
+    }
+
+    void TimerWheel::start()
+    {
+        auto g = m.guard();
+        if (running) return;
+        Thread_Native::Option op;
+        op.name = "xyu-timer";
+        quit = false;
+        th = Thread_Native{op, driver_main, this};
+        running = true;
+    }
+
+    void TimerWheel::stop() noexcept
+    {
+        try {
+            {
+                auto g = m.guard();
+                if (!running) return;
+                quit = true;
+                cv.notify_one();
+            }
+            th.join();
+            auto g = m.guard();
+            running = false;
+        } catch (...) {}
+    }
+
+    void TimerWheel::insert(WheelNode* p) noexcept
+    {
+        // 超出范围时放在最高层的最远处，到达时重新放入
+        xyu::uint64 d = p->expire - cur;
+        if (XY_UNLIKELY(d >= K_range)) d = K_range - 1;
+        xyu::uint64 e = cur + d;
+        xyu::uint l = 0;
+        while (l + 1 < K_levels && d >> (K_bits * (l + 1))) ++l;
+        xyu::uint s = static_cast<xyu::uint>((e >> (K_bits * l)) & K_mask);
+        p->pos = l * K_slots + s;
+        WheelLink& h = slots[p->pos];
+        p->prev = h.prev;
+        p->next = &h;
+        h.prev->next = p;
+        h.prev = p;
+        bits[l] |= xyu::uint64{1} << s;
+    }
+
+    xyu::uint64 TimerWheel::next_tick() const noexcept
+    {
+        // 第 l 层的槽位 j 在刻度的第 l 位数字为 j 且低位全为 0 时处理
+        xyu::uint64 best = K_never;
+        for (xyu::uint l = 0; l < K_levels; ++l)
+        {
+            if (!bits[l]) continue;
+            xyu::uint shift = K_bits * l;
+            xyu::uint64 hi = cur >> shift;
+            xyu::uint k = __builtin_ctzll(rotr(bits[l], static_cast<xyu::uint>((hi + 1) & K_mask))) + 1;
+            xyu::uint64 t = (hi + k) << shift;
+            if (t < best) best = t;
+        }
+        return best;
+    }
+
+    WheelNode* TimerWheel::expire(xyu::uint64 target) noexcept
+    {
+        WheelLink* head = nullptr;
+        WheelLink** tail = &head;
+        while (cur < target)
+        {
+            xyu::uint64 t = next_tick();
+            if (t > target) { cur = target; break; }
+            cur = t;
+            // 从高层到低层下放 (下放的节点只会进入更低的层)
+            for (xyu::uint l = K_levels - 1; l > 0; --l)
+            {
+                xyu::uint shift = K_bits * l;
+                if (t & ((xyu::uint64{1} << shift) - 1)) continue;
+                xyu::uint s = static_cast<xyu::uint>((t >> shift) & K_mask);
+                if (!(bits[l] >> s & 1)) continue;
+                WheelLink& h = slots[l * K_slots + s];
+                WheelLink* q = h.next;
+                h.prev->next = nullptr;
+                h.prev = h.next = &h;
+                bits[l] &= ~(xyu::uint64{1} << s);
+                while (q) {
+                    WheelLink* nx = q->next;
+                    insert(node(q));
+                    q = nx;
+                }
+            }
+            // 第 0 层的槽位中均为在刻度 t 到期的节点
+            xyu::uint s = static_cast<xyu::uint>(t & K_mask);
+            if (!(bits[0] >> s & 1)) continue;
+            WheelLink& h = slots[s];
+            for (WheelLink* q = h.next; q != &h; q = q->next) {
+                ++node(q)->gen;
+                --n;
+            }
+            *tail = h.next;
+            tail = &h.prev->next;
+            h.prev = h.next = &h;
+            bits[0] &= ~(xyu::uint64{1} << s);
+        }
+        *tail = nullptr;
+        return node(head);
+    }
+
+    xyu::size_t TimerWheel::run(WheelNode* list)
+    {
+        if (!list) return 0;
+        xyu::size_t cnt = 0;
+        WheelNode* last = list;
+        for (WheelNode* p = list; p; p = node(p->next))
+        {
+            try { p->cb(); }
+            catch (...) {
+                try { xylogw(xyu::K_LOG_LEVEL, "TimerWheel: exception thrown by timer callback is ignored"); } catch (...) {}
+            }
+            p->cb = nullptr;
+            last = p;
+            ++cnt;
+        }
+        auto g = m.guard();
+        last->next = frees;
+        frees = list;
+        return cnt;
+    }
+
+    xyu::uint64 TimerWheel::now_tick() const noexcept
+    {
+        xyu::int64 now = xyu::Duration_any().count - base;
+        return now > 0 ? static_cast<xyu::uint64>(now / tick) : 0;
+    }
+
+    void TimerWheel::driver_main(void* arg)
+    {
+        auto& w = *static_cast<TimerWheel*>(arg);
+        auto g = w.m.guard();
+        while (!w.quit)
+        {
+            xyu::uint64 t = w.next_tick();
+            xyu::uint64 now = w.now_tick();
+            if (t > now)
+            {
+                // 睡眠到下次需要处理的刻度 (调度更早的定时器或结束时被唤醒)
+                w.wait_tick = t;
+                if (t == K_never || t >= static_cast<xyu::uint64>(0x7FFFFFFFFFFFFFFF / w.tick)) w.cv.wait(g);
+                else w.cv.wait_for(g, xyu::Duration_ns{static_cast<xyu::int64>(t) * w.tick - (xyu::Duration_any().count - w.base)});
+                w.wait_tick = K_never;
+                continue;
+            }
+            WheelNode* list = w.expire(now);
+            g.unlock();
+            w.run(list);
+            g.lock();
+        }
+    }
+}
+
+#endif
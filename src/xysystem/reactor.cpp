@@ -0,0 +1,249 @@
+#if defined(__linux__) && !defined(__CYGWIN__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+#include "../../head/xysystem/reactor.h"
+#if XY_REACTOR
+#include "../../link/log"
+
+namespace xylu::xysystem::__
+{
+    // 文件描述符的事件处理器
+    struct ReactorHandler
+    {
+        int fd;                             // 文件描述符 (移除后为 -1)
+        bool timer;                         // 是否为 Reactor 持有的定时器
+        Reactor::Callback cb;               // 回调
+        ReactorHandler* next = nullptr;     // 待释放链表中的下一个
+    };
+}
+
+namespace
+{
+    using xylu::xysystem::Reactor;
+    using xylu::xysystem::__::ReactorHandler;
+
+    [[noreturn]] void sys_error(xyu::uint line, const char* func, int err, const char* what)
+    {
+        switch (err) {
+            case EMFILE:
+            case ENFILE:
+            case ENOSPC:
+                xyloge2(0, "E_Reactor_Limit: too many file descriptors or watches while {}", line, func, what);
+                throw xyu::E_Reactor_Limit{};
+            case ENOMEM:
+                xyloge2(1, "E_Reactor_No_Memory: no memory while {}", line, func, what);
+                throw xyu::E_Reactor_No_Memory{};
+            case EBADF:
+            case EPERM:
+                xyloge2(0, "E_Reactor_Invalid_State: file descriptor is invalid or not pollable while {}", line, func, what);
+                throw xyu::make_error(xyu::E_Reactor_Invalid_State{}, xyu::E_Logic_Invalid_Argument{});
+            default:
+                xyloge2(0, "E_Reactor: unknown error with code {} while {}", line, func, err, what);
+                throw xyu::E_Reactor{};
+        }
+    }
+
+    // 转换为 epoll 事件 (边沿触发)
+    xyu::uint32 to_epoll(xyu::uint32 events) noexcept
+    {
+        xyu::uint32 e = EPOLLET;
+        if (events & Reactor::READ) e |= EPOLLIN | EPOLLRDHUP;
+        if (events & Reactor::WRITE) e |= EPOLLOUT;
+        return e;
+    }
+
+    // 转换为 Reactor 事件
+    xyu::uint32 from_epoll(xyu::uint32 e) noexcept
+    {
+        xyu::uint32 events = 0;
+        if (e & EPOLLIN) events |= Reactor::READ;
+        if (e & EPOLLOUT) events |= Reactor::WRITE;
+        if (e & EPOLLERR) events |= Reactor::ERROR;
+        if (e & (EPOLLHUP | EPOLLRDHUP)) events |= Reactor::HANGUP;
+        return events;
+    }
+
+    // 释放处理器
+    void destroy(ReactorHandler* h) noexcept
+    {
+        h->~ReactorHandler();
+        xyu::dealloc<ReactorHandler>(xyu::native_v, h);
+    }
+
+    // 转换为 timespec
+    timespec to_timespec(xyu::int64 ns) noexcept
+    { return {static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000)}; }
+}
+
+namespace xylu::xysystem
+{
+    Reactor::Reactor()
+    {
+        ep = epoll_create1(EPOLL_CLOEXEC);
+        if (XY_UNLIKELY(ep < 0)) sys_error(__LINE__, __func__, errno, "creating epoll");
+        wfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (XY_UNLIKELY(wfd < 0)) {
+            int err = errno;
+            close(ep);
+            sys_error(__LINE__, __func__, err, "creating eventfd");
+        }
+        // 唤醒事件的 data.ptr 为 nullptr
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLET;
+        ev.data.ptr = nullptr;
+        if (XY_UNLIKELY(epoll_ctl(ep, EPOLL_CTL_ADD, wfd, &ev))) {
+            int err = errno;
+            close(wfd);
+            close(ep);
+            sys_error(__LINE__, __func__, err, "registering eventfd");
+        }
+    }
+
+    Reactor::~Reactor() noexcept
+    {
+        reap();
+        for (xyu::size_t i = 0; i < hs.count(); ++i)
+            if (ReactorHandler* h = hs.get(i)) {
+                if (h->timer) close(h->fd);
+                destroy(h);
+            }
+        if (wfd >= 0) close(wfd);
+        if (ep >= 0) close(ep);
+    }
+
+    void Reactor::add(int fd, xyu::uint32 events, Callback cb) { add_help(fd, events, xyu::move(cb), false); }
+
+    void Reactor::add_help(int fd, xyu::uint32 events, Callback cb, bool timer)
+    {
+        if (XY_UNLIKELY(fd < 0 || contains(fd))) {
+            xyloge(0, "E_Logic_Invalid_Argument: file descriptor {} is invalid or already registered", fd);
+            throw xyu::E_Logic_Invalid_Argument{};
+        }
+        if (static_cast<xyu::size_t>(fd) >= hs.count()) hs.resize(static_cast<xyu::size_t>(fd) + 1, nullptr);
+        auto h = ::new (xyu::alloc<ReactorHandler>(xyu::native_v, 1)) ReactorHandler{fd, timer, xyu::move(cb)};
+        epoll_event ev{};
+        ev.events = to_epoll(events);
+        ev.data.ptr = h;
+        if (XY_UNLIKELY(epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev))) {
+            int err = errno;
+            destroy(h);
+            sys_error(__LINE__, __func__, err, "registering file descriptor");
+        }
+        hs.get(fd) = h;
+    }
+
+    void Reactor::modify(int fd, xyu::uint32 events)
+    {
+        if (XY_UNLIKELY(!contains(fd))) {
+            xyloge(0, "E_Logic_Invalid_Argument: file descriptor {} is not registered", fd);
+            throw xyu::E_Logic_Invalid_Argument{};
+        }
+        epoll_event ev{};
+        ev.events = to_epoll(events);
+        ev.data.ptr = hs.get(fd);
+        if (XY_UNLIKELY(epoll_ctl(ep, EPOLL_CTL_MOD, fd, &ev)))
+            sys_error(__LINE__, __func__, errno, "modifying file descriptor");
+    }
+
+    void Reactor::remove(int fd) noexcept
+    {
+        if (!contains(fd)) return;
+        ReactorHandler* h = hs.get(fd);
+        hs.get(fd) = nullptr;
+        // 已关闭的文件描述符已自动从 epoll 中移除，忽略错误
+        epoll_ctl(ep, EPOLL_CTL_DEL, fd, nullptr);
+        if (h->timer) close(fd);
+        h->fd = -1;
+        // 分发期间本批次中可能还有该处理器的事件，延迟释放
+        if (dispatching) { h->next = dead; dead = h; }
+        else destroy(h);
+    }
+
+    bool Reactor::contains(int fd) const noexcept
+    { return fd >= 0 && static_cast<xyu::size_t>(fd) < hs.count() && hs.get(fd) != nullptr; }
+
+    int Reactor::add_timer_help(xyu::int64 first_ns, xyu::int64 interval_ns, Callback cb)
+    {
+        int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (XY_UNLIKELY(fd < 0)) sys_error(__LINE__, __func__, errno, "creating timerfd");
+        // 首次到期时间为 0 会关闭定时器，因此至少为 1 纳秒
+        itimerspec its{};
+        its.it_value = to_timespec(first_ns > 0 ? first_ns : 1);
+        its.it_interval = to_timespec(interval_ns > 0 ? interval_ns : 0);
+        if (XY_UNLIKELY(timerfd_settime(fd, 0, &its, nullptr))) {
+            int err = errno;
+            close(fd);
+            sys_error(__LINE__, __func__, err, "setting timerfd");
+        }
+        try { add_help(fd, READ, xyu::move(cb), true); }
+        catch (...) { close(fd); throw; }
+        return fd;
+    }
+
+    xyu::size_t Reactor::poll_help(int timeout_ms)
+    {
+        epoll_event evs[K_batch];
+        int n = epoll_wait(ep, evs, static_cast<int>(K_batch), timeout_ms);
+        if (XY_UNLIKELY(n < 0)) {
+            if (errno == EINTR) return 0;
+            sys_error(__LINE__, __func__, errno, "waiting for events");
+        }
+        dispatching = true;
+        // 回调抛出异常时仍处理本批次剩余的事件 (边沿触发下丢弃的事件不会再次通知)，之后抛出第一个异常
+        xyu::ErrorPtr err;
+        for (int i = 0; i < n; ++i)
+        {
+            auto h = static_cast<ReactorHandler*>(evs[i].data.ptr);
+            xyu::uint64 cnt;
+            // 唤醒事件：清空计数
+            if (!h) {
+                while (read(wfd, &cnt, sizeof(cnt)) > 0);
+                continue;
+            }
+            // 已在本批次中移除
+            if (h->fd < 0) continue;
+            // 定时器：读取到期次数 (边沿触发下不读取也会再次通知，读取以重置可读状态)
+            if (h->timer) while (read(h->fd, &cnt, sizeof(cnt)) > 0);
+            try { h->cb(h->fd, from_epoll(evs[i].events)); }
+            catch (...) { if (!err) err = xyu::ErrorPtr::current(); }
+        }
+        dispatching = false;
+        reap();
+        if (XY_UNLIKELY(err)) err.rethrow();
+        return static_cast<xyu::size_t>(n);
+    }
+
+    void Reactor::run()
+    {
+        while (!stopped.load(xyu::N_ATOMIC_ACQUIRE)) poll_help(-1);
+        stopped.store(false, xyu::N_ATOMIC_RELAXED);
+    }
+
+    void Reactor::stop() noexcept
+    {
+        stopped.store(true, xyu::N_ATOMIC_RELEASE);
+        wakeup();
+    }
+
+    void Reactor::wakeup() noexcept
+    {
+        // 计数溢出时 (EAGAIN) 仍处于可读状态，忽略错误
+        xyu::uint64 one = 1;
+        [[maybe_unused]] auto r = write(wfd, &one, sizeof(one));
+    }
+
+    void Reactor::reap() noexcept
+    {
+        while (dead) {
+            ReactorHandler* h = dead;
+            dead = h->next;
+            destroy(h);
+        }
+    }
+}
+
+#endif